@@ -0,0 +1,590 @@
+#include "bench/registry.hpp"
+#include "bench/trace.hpp"
+#include "lib/pairing_heap.hpp"
+#include "lib/fibonacci_heap.hpp"
+#include "lib/brodal_queue.hpp"
+#include "lib/rank_pairing_heap.hpp"
+#include "lib/d_ary_heap.hpp"
+#include "lib/hollow_heap.hpp"
+#include "lib/strict_fibonacci_heap.hpp"
+#include "lib/sequence_heap.hpp"
+#include "lib/simple_map.hpp"
+#include "compare/boost_heap.hpp"
+#include "compare/plain_heap.hpp"
+#include "utils/stopwatch.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <optional>
+#include <memory>
+#include <cstdlib>
+
+namespace
+{
+    using namespace mix::bench;
+
+    /**
+        Command line options of the benchmark.
+     */
+    struct bench_options
+    {
+        std::vector<std::string> queues      {};
+        std::vector<std::string> workloads   {};
+        std::vector<std::size_t> sizes       {1'000'000};
+        unsigned long            seed        {78945651};
+        std::size_t              repetitions {5};
+        std::size_t              warmup      {1};
+        std::string              format      {"csv"};
+        std::string              mode        {"time"};
+        std::string              traceFile   {};
+        bool                     list        {false};
+    };
+
+    auto make_registry () -> registry
+    {
+        using namespace mix::ds;
+        auto r = registry();
+        r.add_queue<pairing_heap, merge_modes::two_pass>   ("pairing_heap");
+        r.add_queue<pairing_heap, merge_modes::fifo_queue> ("pairing_heap_fifo");
+        r.add_queue<fibonacci_heap>                        ("fibonacci_heap");
+        r.add_queue<brodal_queue>                          ("brodal_queue");
+        r.add_queue<boost_pairing_heap>                    ("boost_pairing_heap");
+        r.add_queue<boost_fibonacci_heap>                  ("boost_fibonacci_heap");
+        r.add_queue<boost_d_ary_heap>                      ("boost_d_ary_heap");
+        r.add_queue<rank_pairing_heap, rank_rules::type_1> ("rank_pairing_heap");
+        r.add_queue<rank_pairing_heap, rank_rules::type_2> ("rank_pairing_heap_2");
+        r.add_queue<d_ary_heap, heap_arity<4>>             ("d_ary_heap_4");
+        r.add_queue<d_ary_heap, heap_arity<8>>             ("d_ary_heap_8");
+        r.add_queue<hollow_heap>                           ("hollow_heap");
+        r.add_queue<strict_fibonacci_heap>                 ("strict_fibonacci_heap");
+
+        r.add_plain_queue<sequence_heap>                   ("sequence_heap");
+        r.add_plain_queue<std_priority_queue>              ("std_priority_queue");
+
+        r.add_queue_memory<pairing_heap, merge_modes::two_pass>   ("pairing_heap");
+        r.add_queue_memory<pairing_heap, merge_modes::fifo_queue> ("pairing_heap_fifo");
+        r.add_queue_memory<fibonacci_heap>                        ("fibonacci_heap");
+        r.add_queue_memory<brodal_queue>                          ("brodal_queue");
+        r.add_map_memory<simple_map>                              ("simple_map", 100'000);
+        return r;
+    }
+
+    auto split (std::string const& s) -> std::vector<std::string>
+    {
+        auto parts  = std::vector<std::string>();
+        auto stream = std::istringstream(s);
+        auto part   = std::string();
+        while (std::getline(stream, part, ','))
+        {
+            if (!part.empty())
+            {
+                parts.emplace_back(part);
+            }
+        }
+        return parts;
+    }
+
+    auto print_usage (std::ostream& ost) -> void
+    {
+        ost << "Usage: bench [options]"                                              << '\n'
+            << "  --queue q1,q2,...     queues to run, all by default"             << '\n'
+            << "  --workload w1,w2,...  workloads to run, all by default"          << '\n'
+            << "  --n n1,n2,...         numbers of elements, 1000000 by default"   << '\n'
+            << "  --seed s              seed of the random input"                  << '\n'
+            << "  --reps r              measured repetitions, 5 by default"        << '\n'
+            << "  --warmup w            unmeasured repetitions, 1 by default"      << '\n'
+            << "  --format csv|json     output format, csv by default"             << '\n'
+            << "  --mode time|latency|memory"                                       << '\n'
+            << "                        time of whole repetitions, percentiles of" << '\n'
+            << "                        latency of single operations or bytes per" << '\n'
+            << "                        element and allocations per operation"    << '\n'
+            << "  --trace file          trace replayed by the trace workload"      << '\n'
+            << "  --list                prints queues and their workloads"         << '\n';
+    }
+
+    auto parse_options (int const argc, char** const argv) -> bench_options
+    {
+        auto options = bench_options();
+        for (auto i = 1; i < argc; ++i)
+        {
+            auto const arg = std::string_view(argv[i]);
+            if ("--list" == arg)
+            {
+                options.list = true;
+                continue;
+            }
+
+            if ("--help" == arg)
+            {
+                print_usage(std::cout);
+                std::exit(EXIT_SUCCESS);
+            }
+
+            if (i + 1 == argc)
+            {
+                throw std::invalid_argument("Missing value of " + std::string(arg));
+            }
+
+            auto const value = std::string(argv[++i]);
+            if      ("--queue"    == arg) options.queues      = split(value);
+            else if ("--workload" == arg) options.workloads   = split(value);
+            else if ("--seed"     == arg) options.seed        = std::stoul(value);
+            else if ("--reps"     == arg) options.repetitions = std::stoul(value);
+            else if ("--warmup"   == arg) options.warmup      = std::stoul(value);
+            else if ("--format"   == arg) options.format      = value;
+            else if ("--mode"     == arg) options.mode        = value;
+            else if ("--trace"    == arg) options.traceFile   = value;
+            else if ("--n"        == arg)
+            {
+                options.sizes.clear();
+                for (auto const& n : split(value))
+                {
+                    options.sizes.emplace_back(std::stoul(n));
+                }
+            }
+            else
+            {
+                throw std::invalid_argument("Unknown option " + std::string(arg));
+            }
+        }
+
+        if ("csv" != options.format && "json" != options.format)
+        {
+            throw std::invalid_argument("Unknown format " + options.format);
+        }
+
+        if ("time" != options.mode && "latency" != options.mode && "memory" != options.mode)
+        {
+            throw std::invalid_argument("Unknown mode " + options.mode);
+        }
+
+        for (auto const n : options.sizes)
+        {
+            if (0 == n)
+            {
+                throw std::invalid_argument("Number of elements must be positive.");
+            }
+        }
+
+        return options;
+    }
+
+    /**
+        Wall time, hardware counters and checksum of one repetition.
+     */
+    struct repetition_result
+    {
+        double                  ms;
+        mix::utils::perf_sample counters;
+        checksum_t              checksum;
+    };
+
+    auto run_repetitions
+        ( bench_run const& run
+        , mix::utils::perf_counters& counters
+        , std::size_t const warmup
+        , std::size_t const repetitions )
+    {
+        using clock_t = std::chrono::steady_clock;
+        using ms_t    = std::chrono::duration<double, std::milli>;
+
+        for (auto i = 0ul; i < warmup; ++i)
+        {
+            run();
+        }
+
+        auto results = std::vector<repetition_result>();
+        for (auto i = 0ul; i < repetitions; ++i)
+        {
+            auto result = repetition_result {};
+            {
+                auto const scope = mix::utils::scoped_perf_counters(counters, result.counters);
+                auto const start = clock_t::now();
+                result.checksum  = run();
+                result.ms        = ms_t(clock_t::now() - start).count();
+            }
+            results.emplace_back(result);
+        }
+        return results;
+    }
+
+    /**
+        One output line as a list of named values.
+        Empty value means that it is not available.
+     */
+    struct field
+    {
+        std::string name;
+        std::string value;
+        bool        isText;
+    };
+
+    using record_t = std::vector<field>;
+
+    template<class Number>
+    auto number_field (std::string name, Number const value) -> field
+    {
+        auto ost = std::ostringstream();
+        ost << std::fixed << std::setprecision(3) << value;
+        return field {std::move(name), ost.str(), false};
+    }
+
+    auto text_field (std::string name, std::string value) -> field
+    {
+        return field {std::move(name), std::move(value), true};
+    }
+
+    template<class Number>
+    auto optional_field (std::string name, std::optional<Number> const value) -> field
+    {
+        return value ? number_field(std::move(name), *value) : field {std::move(name), "", false};
+    }
+
+    /**
+        Prints records as CSV with a header or as a JSON array of objects.
+     */
+    class record_printer
+    {
+    public:
+        record_printer (std::ostream& ost, bool const isJson) :
+            ost_     (ost),
+            isJson_  (isJson),
+            isFirst_ (true)
+        {
+        }
+
+        auto finish () -> void
+        {
+            if (isJson_)
+            {
+                ost_ << (isFirst_ ? "[" : "") << '\n' << ']' << '\n';
+            }
+        }
+
+        auto print (record_t const& record) -> void
+        {
+            if (isJson_)
+            {
+                this->print_json(record);
+            }
+            else
+            {
+                this->print_csv(record);
+            }
+            isFirst_ = false;
+        }
+
+    private:
+        auto print_csv (record_t const& record) -> void
+        {
+            if (isFirst_)
+            {
+                for (auto i = 0ul; i < record.size(); ++i)
+                {
+                    ost_ << (i ? "," : "") << record[i].name;
+                }
+                ost_ << '\n';
+            }
+
+            for (auto i = 0ul; i < record.size(); ++i)
+            {
+                ost_ << (i ? "," : "") << record[i].value;
+            }
+            ost_ << std::endl;
+        }
+
+        auto print_json (record_t const& record) -> void
+        {
+            ost_ << (isFirst_ ? "[\n  {" : ",\n  {");
+            for (auto i = 0ul; i < record.size(); ++i)
+            {
+                auto const quote = record[i].isText ? "\"" : "";
+                auto const null  = !record[i].isText && record[i].value.empty();
+                ost_ << (i ? ", " : "") << '"' << record[i].name << "\": "
+                     << quote << (null ? "null" : record[i].value) << quote;
+            }
+            ost_ << '}' << std::flush;
+        }
+
+    private:
+        std::ostream& ost_;
+        bool          isJson_;
+        bool          isFirst_;
+    };
+
+    auto run_time_mode
+        ( record_printer& printer
+        , mix::utils::perf_counters& counters
+        , workload_entry const& entry
+        , record_t const& header
+        , bench_params const& params
+        , bench_options const& options ) -> void
+    {
+        using namespace mix::utils;
+
+        auto const run     = entry.run(params);
+        auto const results = run_repetitions(run, counters, options.warmup, options.repetitions);
+
+        for (auto i = 0ul; i < results.size(); ++i)
+        {
+            auto record = header;
+            record.emplace_back(number_field("repetition", i));
+            record.emplace_back(number_field("ms", results[i].ms));
+            for (auto event = 0ul; event < PerfEventCount; ++event)
+            {
+                auto const name = perf_event_name(static_cast<perf_event>(event));
+                record.emplace_back(optional_field(name, results[i].counters[event]));
+            }
+            record.emplace_back(number_field("checksum", results[i].checksum));
+            printer.print(record);
+        }
+    }
+
+    auto run_latency_mode
+        ( record_printer& printer
+        , workload_entry const& entry
+        , record_t const& header
+        , bench_params const& params
+        , bench_options const& options ) -> void
+    {
+        using mix::utils::cycle_timer;
+
+        auto histograms = op_histograms();
+        auto const run  = entry.latency(params, histograms);
+
+        for (auto i = 0ul; i < options.warmup; ++i)
+        {
+            run();
+        }
+
+        // Measured repetitions are accumulated into the same histograms.
+        histograms.reset();
+        for (auto i = 0ul; i < options.repetitions; ++i)
+        {
+            run();
+        }
+
+        for (auto op = 0ul; op < op_histograms::OpCount; ++op)
+        {
+            auto const& h = histograms[static_cast<op_kind>(op)];
+            if (0 == h.count())
+            {
+                continue;
+            }
+
+            auto const ns = [](auto const ticks)
+            {
+                return cycle_timer::to_ns(ticks);
+            };
+
+            auto record = header;
+            record.emplace_back(text_field("op", op_name(static_cast<op_kind>(op))));
+            record.emplace_back(number_field("count", h.count()));
+            record.emplace_back(number_field("mean_ns", h.mean() / cycle_timer::ticks_per_ns()));
+            record.emplace_back(number_field("p50_ns", ns(h.percentile(50.0))));
+            record.emplace_back(number_field("p99_ns", ns(h.percentile(99.0))));
+            record.emplace_back(number_field("p999_ns", ns(h.percentile(99.9))));
+            record.emplace_back(number_field("max_ns", ns(h.max())));
+            printer.print(record);
+        }
+    }
+
+    auto run_memory_mode
+        ( record_printer& printer
+        , memory_entry const& entry
+        , record_t const& header
+        , bench_params const& params ) -> void
+    {
+        auto const report = entry.measure(params);
+        auto const n      = static_cast<double>(params.n);
+
+        auto const per_delete = [n](auto const count)
+        {
+            return count ? std::optional<double>(static_cast<double>(*count) / n) : std::nullopt;
+        };
+
+        auto const bytesPerElement = static_cast<double>(report.liveBytes) / n;
+        auto record = header;
+        record.emplace_back(number_field("element_bytes", report.elementBytes));
+        record.emplace_back(number_field("bytes_per_element", bytesPerElement));
+        record.emplace_back(number_field("overhead_per_element", bytesPerElement - static_cast<double>(report.elementBytes)));
+        record.emplace_back(number_field("peak_bytes_per_element", static_cast<double>(report.peakBytes) / n));
+        record.emplace_back(number_field("allocs_per_insert", static_cast<double>(report.insertAllocations) / n));
+        record.emplace_back(optional_field("allocs_per_delete", per_delete(report.deleteAllocations)));
+        record.emplace_back(optional_field("deallocs_per_delete", per_delete(report.deleteDeallocations)));
+        printer.print(record);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    auto const queues = make_registry();
+    auto options      = bench_options();
+
+    try
+    {
+        options = parse_options(argc, argv);
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        print_usage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    if (options.list)
+    {
+        for (auto const& queue : queues.queue_names())
+        {
+            std::cout << queue << ':';
+            for (auto const& workload : queues.workloads_of(queue))
+            {
+                std::cout << ' ' << workload;
+            }
+            std::cout << '\n';
+        }
+
+        std::cout << "memory:";
+        for (auto const& name : queues.memory_names())
+        {
+            std::cout << ' ' << name;
+        }
+        std::cout << '\n';
+        return EXIT_SUCCESS;
+    }
+
+    if ("memory" == options.mode)
+    {
+        auto const names = options.queues.empty() ? queues.memory_names() : options.queues;
+        for (auto const& name : names)
+        {
+            if (!queues.find_memory(name))
+            {
+                std::cerr << "Memory of " << name << " can not be measured." << '\n';
+                return EXIT_FAILURE;
+            }
+        }
+
+        auto printer = record_printer(std::cout, "json" == options.format);
+        for (auto const& name : names)
+        {
+            auto const& entry = *queues.find_memory(name);
+            for (auto const n : options.sizes)
+            {
+                if (n > entry.maxN)
+                {
+                    std::cerr << "Skipping " << name << " with " << n << " elements, at most " << entry.maxN << '\n';
+                    continue;
+                }
+
+                auto const header = record_t { text_field("queue", name)
+                                             , number_field("n", n)
+                                             , number_field("seed", options.seed) };
+                run_memory_mode(printer, entry, header, bench_params {n, options.seed, nullptr});
+            }
+        }
+        printer.finish();
+        return EXIT_SUCCESS;
+    }
+
+    if (options.queues.empty())
+    {
+        options.queues = queues.queue_names();
+    }
+
+    auto const isLatency = "latency" == options.mode;
+    auto replayTrace     = std::shared_ptr<trace const>();
+
+    if (!options.traceFile.empty())
+    {
+        try
+        {
+            replayTrace = std::make_shared<trace const>(trace::load(options.traceFile));
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << e.what() << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Check the selection first so that a typo does not waste a long run.
+    for (auto const& queue : options.queues)
+    {
+        if (queues.workloads_of(queue).empty())
+        {
+            std::cerr << "Unknown queue " << queue << '\n';
+            return EXIT_FAILURE;
+        }
+
+        for (auto const& workload : options.workloads)
+        {
+            if ("trace" == workload && !replayTrace)
+            {
+                std::cerr << "Workload trace needs --trace file." << '\n';
+                return EXIT_FAILURE;
+            }
+
+            auto const entry = queues.find(queue, workload);
+            if (!entry || (isLatency && !entry->latency))
+            {
+                std::cerr << "Workload " << workload << " is not available for " << queue << '\n';
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    auto counters = mix::utils::perf_counters();
+    if (!isLatency)
+    {
+        using namespace mix::utils;
+        for (auto event = 0ul; event < PerfEventCount; ++event)
+        {
+            if (!counters.counts(static_cast<perf_event>(event)))
+            {
+                std::cerr << "Counter " << perf_event_name(static_cast<perf_event>(event)) << " is not available." << '\n';
+            }
+        }
+    }
+
+    auto printer = record_printer(std::cout, "json" == options.format);
+    for (auto const& queue : options.queues)
+    {
+        auto const workloads = options.workloads.empty() ? queues.workloads_of(queue) : options.workloads;
+        for (auto const& workload : workloads)
+        {
+            auto const& entry = *queues.find(queue, workload);
+            if ((isLatency && !entry.latency) || ("trace" == workload && !replayTrace))
+            {
+                continue;
+            }
+
+            // Trace is replayed once, its n is the number of operations.
+            auto const isTrace = "trace" == workload;
+            auto const sizes   = isTrace ? std::vector<std::size_t> {replayTrace->size()} : options.sizes;
+            for (auto const n : sizes)
+            {
+                auto const params = bench_params {n, options.seed, isTrace ? replayTrace : nullptr};
+                auto const header = record_t { text_field("queue", queue)
+                                             , text_field("workload", workload)
+                                             , number_field("n", n)
+                                             , number_field("seed", options.seed) };
+                if (isLatency)
+                {
+                    run_latency_mode(printer, entry, header, params, options);
+                }
+                else
+                {
+                    run_time_mode(printer, counters, entry, header, params, options);
+                }
+            }
+        }
+    }
+
+    printer.finish();
+}
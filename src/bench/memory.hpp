@@ -0,0 +1,94 @@
+#ifndef MIX_DS_BENCH_MEMORY_HPP
+#define MIX_DS_BENCH_MEMORY_HPP
+
+#include "workloads.hpp"
+#include "../utils/counting_allocator.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace mix::bench
+{
+    /**
+        Memory used by a structure with n elements counted
+        by counting_allocator. Delete counts are empty for
+        structures that are not emptied by the measurement.
+     */
+    struct memory_report
+    {
+        std::size_t                elementBytes;
+        std::size_t                liveBytes;
+        std::size_t                peakBytes;
+        std::size_t                insertAllocations;
+        std::optional<std::size_t> deleteAllocations;
+        std::optional<std::size_t> deleteDeallocations;
+    };
+
+    /**
+        Measures memory of a structure for given parameters.
+     */
+    using memory_factory = std::function<memory_report(bench_params const&)>;
+
+    /**
+        Inserts n elements into a queue that uses counting_allocator
+        and then deletes all of them using delete_min.
+        Live bytes are taken when all n elements are in the queue.
+
+        @tparam Queue   Queue of bench_data with counting_allocator<bench_data>.
+     */
+    template<class Queue>
+    auto measure_queue_memory (bench_params const& params) -> memory_report
+    {
+        auto stats  = utils::allocation_stats();
+        auto keys   = bench_impl::random_keys(params.n, 0, params.n, params.seed);
+        auto report = memory_report {sizeof(bench_data), 0, 0, 0, {}, {}};
+
+        {
+            auto queue = Queue(utils::counting_allocator<bench_data>(stats));
+            for (auto i = 0ul; i < keys.size(); ++i)
+            {
+                queue.insert(bench_impl::make_data(keys[i], i));
+            }
+
+            report.liveBytes         = stats.live_bytes();
+            report.insertAllocations = stats.allocations();
+            stats.reset();
+
+            bench_impl::drain(queue, no_probe());
+            report.deleteAllocations   = stats.allocations();
+            report.deleteDeallocations = stats.deallocations();
+        }
+
+        report.peakBytes = stats.peak_bytes();
+        return report;
+    }
+
+    /**
+        Inserts n distinct keys into a map that uses counting_allocator.
+
+        @tparam Map Map from key_t to key_t with counting_allocator of its value_type.
+     */
+    template<class Map>
+    auto measure_map_memory (bench_params const& params) -> memory_report
+    {
+        using value_t = typename Map::value_type;
+
+        auto stats  = utils::allocation_stats();
+        auto report = memory_report {sizeof(value_t), 0, 0, 0, {}, {}};
+        auto map    = Map(utils::counting_allocator<value_t>(stats));
+
+        for (auto i = 0ul; i < params.n; ++i)
+        {
+            map.emplace(static_cast<key_t>(i), static_cast<key_t>(params.seed + i));
+        }
+
+        report.liveBytes         = stats.live_bytes();
+        report.peakBytes         = stats.peak_bytes();
+        report.insertAllocations = stats.allocations();
+        return report;
+    }
+}
+
+#endif
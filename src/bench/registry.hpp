@@ -0,0 +1,244 @@
+#ifndef MIX_DS_BENCH_REGISTRY_HPP
+#define MIX_DS_BENCH_REGISTRY_HPP
+
+#include "workloads.hpp"
+#include "trace.hpp"
+#include "memory.hpp"
+#include "../utils/counting_allocator.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <limits>
+#include <functional>
+
+namespace mix::bench
+{
+    /**
+        Prepares a workload for given parameters.
+     */
+    using workload_factory = std::function<bench_run(bench_params const&)>;
+
+    /**
+        Prepares a workload that records latency of each operation into histograms.
+     */
+    using latency_factory = std::function<bench_run(bench_params const&, op_histograms&)>;
+
+    /**
+        Workload of one queue. Latency is empty if operations of the workload
+        can not be measured separately e.g. Dijkstra runs inside of a library call.
+     */
+    struct workload_entry
+    {
+        workload_factory run;
+        latency_factory  latency;
+    };
+
+    /**
+        Memory measurement of one structure. Sizes above maxN are skipped
+        e.g. because inserting into a linear map is quadratic.
+     */
+    struct memory_entry
+    {
+        memory_factory measure;
+        std::size_t    maxN;
+    };
+
+    /**
+        Named queues and workloads that can be run on them.
+        Not every workload is registered for every queue
+        e.g. meld is skipped for queues that can not meld.
+     */
+    class registry
+    {
+    public:
+        template<template<class, class, class...> class Queue, class... Options>
+        auto add_queue (std::string const& name) -> void;
+
+        template<template<class, class, class...> class Queue, class... Options>
+        auto add_plain_queue (std::string const& name) -> void;
+
+        template<template<class, class, class...> class Queue, class... Options>
+        auto add_queue_memory (std::string const& name) -> void;
+
+        template<template<class, class, class...> class Map>
+        auto add_map_memory (std::string const& name, std::size_t const maxN) -> void;
+
+        auto find         (std::string const& queue, std::string const& workload) const -> workload_entry const*;
+        auto find_memory  (std::string const& name) const -> memory_entry const*;
+        auto queue_names  () const -> std::vector<std::string>;
+        auto memory_names () const -> std::vector<std::string>;
+        auto workloads_of (std::string const& queue) const -> std::vector<std::string>;
+
+    private:
+        template<class Prepare>
+        static auto make_entry (Prepare prepare) -> workload_entry;
+
+    private:
+        std::map<std::string, std::map<std::string, workload_entry>> queues_;
+        std::map<std::string, memory_entry>                          memory_;
+    };
+
+    template<template<class, class, class...> class Queue, class... Options>
+    auto registry::add_queue
+        (std::string const& name) -> void
+    {
+        using queue_t       = Queue<bench_data, std::less<bench_data>, Options...>;
+        using trace_queue_t = Queue<trace_data, std::less<trace_data>, Options...>;
+        auto& workloads     = queues_[name];
+
+        workloads["delete"]     = make_entry([](auto const& params, auto const probe)
+        {
+            return prepare_delete<queue_t>(params, probe);
+        });
+        workloads["decrease"]   = make_entry([](auto const& params, auto const probe)
+        {
+            return prepare_decrease<queue_t>(params, probe);
+        });
+        workloads["random_all"] = make_entry([](auto const& params, auto const probe)
+        {
+            return prepare_random_all<queue_t>(params, probe);
+        });
+        workloads["throughput"] = make_entry([](auto const& params, auto const probe)
+        {
+            return prepare_throughput<queue_t>(params, probe);
+        });
+        workloads["trace"]      = make_entry([](auto const& params, auto const probe)
+        {
+            return prepare_replay<trace_queue_t>(params, probe);
+        });
+        workloads["dijkstra"]   = workload_entry {&prepare_dijkstra<Queue, Options...>, {}};
+
+        if constexpr (has_meld_v<queue_t>)
+        {
+            workloads["meld"] = make_entry([](auto const& params, auto const probe)
+            {
+                return prepare_meld<queue_t>(params, probe);
+            });
+        }
+    }
+
+    /**
+        Registers a queue without handles. Only workloads that use
+        insert, find_min, delete_min and empty are run on it.
+     */
+    template<template<class, class, class...> class Queue, class... Options>
+    auto registry::add_plain_queue
+        (std::string const& name) -> void
+    {
+        using queue_t   = Queue<bench_data, std::less<bench_data>, Options...>;
+        auto& workloads = queues_[name];
+
+        workloads["delete"]     = make_entry([](auto const& params, auto const probe)
+        {
+            return prepare_delete<queue_t>(params, probe);
+        });
+        workloads["throughput"] = make_entry([](auto const& params, auto const probe)
+        {
+            return prepare_throughput<queue_t>(params, probe);
+        });
+    }
+
+    /**
+        Registers memory measurement of a queue that takes the allocator
+        as its last template parameter after given options.
+     */
+    template<template<class, class, class...> class Queue, class... Options>
+    auto registry::add_queue_memory
+        (std::string const& name) -> void
+    {
+        using alloc_t = utils::counting_allocator<bench_data>;
+        using queue_t = Queue<bench_data, std::less<bench_data>, Options..., alloc_t>;
+        memory_[name] = memory_entry {&measure_queue_memory<queue_t>, std::numeric_limits<std::size_t>::max()};
+    }
+
+    /**
+        Registers memory measurement of a map that takes its container
+        as the last template parameter.
+     */
+    template<template<class, class, class...> class Map>
+    auto registry::add_map_memory
+        (std::string const& name, std::size_t const maxN) -> void
+    {
+        using value_t     = std::pair<key_t const, key_t>;
+        using container_t = std::vector<value_t, utils::counting_allocator<value_t>>;
+        using map_t       = Map<key_t, key_t, std::equal_to<key_t>, container_t>;
+        memory_[name]     = memory_entry {&measure_map_memory<map_t>, maxN};
+    }
+
+    template<class Prepare>
+    auto registry::make_entry
+        (Prepare prepare) -> workload_entry
+    {
+        auto const run = [prepare](bench_params const& params)
+        {
+            return prepare(params, no_probe());
+        };
+
+        auto const latency = [prepare](bench_params const& params, op_histograms& histograms)
+        {
+            return prepare(params, latency_probe(histograms));
+        };
+
+        return workload_entry {run, latency};
+    }
+
+    inline auto registry::find
+        (std::string const& queue, std::string const& workload) const -> workload_entry const*
+    {
+        auto const queueIt = queues_.find(queue);
+        if (queueIt == std::end(queues_))
+        {
+            return nullptr;
+        }
+
+        auto const workloadIt = queueIt->second.find(workload);
+        return workloadIt == std::end(queueIt->second) ? nullptr : &workloadIt->second;
+    }
+
+    inline auto registry::find_memory
+        (std::string const& name) const -> memory_entry const*
+    {
+        auto const it = memory_.find(name);
+        return it == std::end(memory_) ? nullptr : &it->second;
+    }
+
+    inline auto registry::queue_names
+        () const -> std::vector<std::string>
+    {
+        auto names = std::vector<std::string>();
+        for (auto const& [name, workloads] : queues_)
+        {
+            names.emplace_back(name);
+        }
+        return names;
+    }
+
+    inline auto registry::memory_names
+        () const -> std::vector<std::string>
+    {
+        auto names = std::vector<std::string>();
+        for (auto const& [name, entry] : memory_)
+        {
+            names.emplace_back(name);
+        }
+        return names;
+    }
+
+    inline auto registry::workloads_of
+        (std::string const& queue) const -> std::vector<std::string>
+    {
+        auto names = std::vector<std::string>();
+        auto const it = queues_.find(queue);
+        if (it != std::end(queues_))
+        {
+            for (auto const& [name, factory] : it->second)
+            {
+                names.emplace_back(name);
+            }
+        }
+        return names;
+    }
+}
+
+#endif
@@ -0,0 +1,600 @@
+#ifndef MIX_DS_BENCH_TRACE_HPP
+#define MIX_DS_BENCH_TRACE_HPP
+
+#include "workloads.hpp"
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <istream>
+#include <ostream>
+#include <fstream>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace mix::bench
+{
+    using trace_key_t = std::uint64_t;
+    using trace_id_t  = std::uint32_t;
+
+    /**
+        Operation of a priority queue recorded in a trace.
+     */
+    enum class trace_op : std::uint8_t
+    {
+        insert, delete_min, decrease_key, erase
+    };
+
+    /**
+        One recorded operation. Id identifies the inserted element, ids are
+        assigned to inserts in order starting at 0 so they are not stored
+        for inserts. Delete_min has the id of the deleted element, decrease_key
+        the id and the new key of the element and erase only its id.
+     */
+    struct trace_record
+    {
+        trace_op    op;
+        trace_id_t  id;
+        trace_key_t key;
+    };
+
+    inline auto operator== (trace_record const& lhs, trace_record const& rhs)
+    {
+        return lhs.op  == rhs.op
+            && lhs.id  == rhs.id
+            && lhs.key == rhs.key;
+    }
+
+    inline auto operator!= (trace_record const& lhs, trace_record const& rhs)
+    {
+        return ! (lhs == rhs);
+    }
+
+    /**
+        Sequence of operations of a priority queue.
+        Binary format (all integers are LEB128 varints):
+        magic "MIXTRACE", version, record count, then for each record
+        an op code byte followed by the key of an insert, the id of
+        a delete_min or an erase or the id and the key of a decrease_key.
+        A typical operation takes only a few bytes.
+        Operations on elements that are not in the queue are rejected.
+     */
+    class trace
+    {
+    public:
+        /**
+            Position of the record that removes an element
+            or NotRemoved if the element stays in the queue.
+         */
+        static constexpr auto NotRemoved = std::numeric_limits<std::uint64_t>::max();
+
+    public:
+        auto insert       (trace_key_t const key)                      -> trace_id_t;
+        auto delete_min   (trace_id_t const id)                        -> void;
+        auto decrease_key (trace_id_t const id, trace_key_t const key) -> void;
+        auto erase        (trace_id_t const id)                        -> void;
+
+        auto records      () const -> std::vector<trace_record> const&;
+        auto size         () const -> std::size_t;
+        auto insert_count () const -> std::size_t;
+        auto removed_at   (trace_id_t const id) const -> std::uint64_t;
+
+        auto write (std::ostream& ost) const -> void;
+        auto save  (std::string const& filePath) const -> void;
+
+        static auto read (std::istream& ist) -> trace;
+        static auto load (std::string const& filePath) -> trace;
+
+    private:
+        auto check_id (trace_id_t const id) const              -> void;
+        auto remove   (trace_op const op, trace_id_t const id) -> void;
+
+    private:
+        std::vector<trace_record>  records_;
+        std::vector<std::uint64_t> removedAt_;
+    };
+
+    /**
+        Element of a replayed queue. Equal keys are ordered by the position
+        of the record that removes the element so every queue deletes
+        exactly the element that the recorded queue deleted.
+     */
+    struct trace_data
+    {
+        trace_key_t   key;
+        std::uint64_t removedAt;
+    };
+
+    inline auto operator< (trace_data const& lhs, trace_data const& rhs)
+    {
+        return lhs.key < rhs.key
+            || (lhs.key == rhs.key && lhs.removedAt < rhs.removedAt);
+    }
+
+    /**
+        Extracts the key that is recorded from an element.
+        Default one converts the element itself.
+     */
+    struct trace_key_of
+    {
+        template<class T>
+        auto operator() (T const& value) const -> trace_key_t
+        {
+            return static_cast<trace_key_t>(value);
+        }
+    };
+
+    /**
+        Handle of trace_recorder. Wraps handle of the recorded queue
+        together with the id of the element in the trace.
+     */
+    template<class Handle>
+    class trace_handle
+    {
+    public:
+        trace_handle (Handle const handle, trace_id_t const id) :
+            handle_ (handle),
+            id_     (id)
+        {
+        }
+
+        auto operator* () -> decltype(*std::declval<Handle&>())
+        {
+            return *handle_;
+        }
+
+        auto operator-> () -> decltype(&*std::declval<Handle&>())
+        {
+            return &*handle_;
+        }
+
+        auto handle () const -> Handle
+        {
+            return handle_;
+        }
+
+        auto id () const -> trace_id_t
+        {
+            return id_;
+        }
+
+    private:
+        Handle     handle_;
+        trace_id_t id_;
+    };
+
+    /**
+        Wrapper with the interface of a queue that forwards all operations
+        to the wrapped queue and records them into a trace.
+        Recorded keys are taken from elements by KeyOf, the key of
+        decrease_key is read after the caller changed the element.
+        Deleted minimum is identified by its address so the queue must
+        not move its elements e.g. node based pairing_heap, fibonacci_heap
+        or brodal_queue but not d_ary_heap. Any queue can replay the trace.
+
+        @tparam Queue   Recorded queue.
+        @tparam KeyOf   Function object that returns trace_key_t of an element.
+     */
+    template<class Queue, class KeyOf = trace_key_of>
+    class trace_recorder
+    {
+    public:
+        using queue_t    = Queue;
+        using handle_t   = trace_handle<typename Queue::handle_t>;
+        using value_type = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<Queue&>().find_min())>>;
+
+    public:
+        trace_recorder (Queue queue = Queue(), KeyOf keyOf = KeyOf()) :
+            queue_ (std::move(queue)),
+            keyOf_ (std::move(keyOf))
+        {
+        }
+
+        auto insert (value_type const& value) -> handle_t
+        {
+            auto handle   = queue_.insert(value);
+            auto const id = trace_.insert(keyOf_(value));
+            ids_.emplace(&*handle, id);
+            return handle_t(handle, id);
+        }
+
+        auto find_min () -> decltype(auto)
+        {
+            return queue_.find_min();
+        }
+
+        auto delete_min () -> void
+        {
+            auto const it = ids_.find(&queue_.find_min());
+            if (it == std::end(ids_))
+            {
+                throw std::logic_error("Recorded queue moved its minimum.");
+            }
+
+            auto const id = it->second;
+            ids_.erase(it);
+            queue_.delete_min();
+            trace_.delete_min(id);
+        }
+
+        auto decrease_key (handle_t handle) -> void
+        {
+            queue_.decrease_key(handle.handle());
+            trace_.decrease_key(handle.id(), keyOf_(*handle));
+        }
+
+        auto erase (handle_t handle) -> void
+        {
+            ids_.erase(&*handle);
+            queue_.erase(handle.handle());
+            trace_.erase(handle.id());
+        }
+
+        auto size () const -> std::size_t
+        {
+            return queue_.size();
+        }
+
+        auto empty () const -> bool
+        {
+            return queue_.empty();
+        }
+
+        auto queue () -> Queue&
+        {
+            return queue_;
+        }
+
+        auto recorded () const -> trace const&
+        {
+            return trace_;
+        }
+
+    private:
+        Queue                                             queue_;
+        KeyOf                                             keyOf_;
+        trace                                             trace_;
+        std::unordered_map<value_type const*, trace_id_t> ids_;
+    };
+
+    /**
+        Runs operations of a trace on an empty queue of trace_data.
+        Handles are kept in a vector indexed by the id of the element
+        so no lookup is needed during the replay.
+        Throws std::logic_error if the queue deletes a different element
+        than the recorded one, which means that the queue is broken.
+        @return sum of keys of deleted minimums.
+     */
+    template<class Queue, class Probe = no_probe>
+    auto replay_trace (trace const& t, Probe const& probe = Probe()) -> checksum_t
+    {
+        using handle_t = typename Queue::handle_t;
+        auto queue     = Queue();
+        auto handles   = std::vector<handle_t>();
+        auto sum       = checksum_t {0};
+        handles.reserve(t.insert_count());
+
+        auto const& records = t.records();
+        for (auto i = 0ul; i < records.size(); ++i)
+        {
+            auto const& record = records[i];
+
+            // Trace rejects such records, this only guards against dead handles.
+            if (trace_op::insert != record.op && t.removed_at(record.id) < i)
+            {
+                throw std::logic_error("Trace uses an element that was removed.");
+            }
+
+            switch (record.op)
+            {
+                case trace_op::insert:
+                {
+                    auto const data = trace_data {record.key, t.removed_at(record.id)};
+                    probe(op_kind::insert, [&](){ handles.emplace_back(queue.insert(data)); });
+                    break;
+                }
+                case trace_op::delete_min:
+                {
+                    if (queue.find_min().removedAt != i)
+                    {
+                        throw std::logic_error("Replayed queue deleted a different element than the recorded one.");
+                    }
+                    sum += queue.find_min().key;
+                    probe(op_kind::delete_min, [&](){ queue.delete_min(); });
+                    break;
+                }
+                case trace_op::decrease_key:
+                {
+                    auto handle   = handles[record.id];
+                    (*handle).key = record.key;
+                    probe(op_kind::decrease_key, [&](){ queue.decrease_key(handle); });
+                    break;
+                }
+                case trace_op::erase:
+                {
+                    auto const handle = handles[record.id];
+                    probe(op_kind::erase, [&](){ queue.erase(handle); });
+                    break;
+                }
+            }
+        }
+
+        return sum;
+    }
+
+    /**
+        Replays the trace given in bench_params.
+     */
+    template<class Queue, class Probe = no_probe>
+    auto prepare_replay (bench_params const& params, Probe const probe = Probe()) -> bench_run
+    {
+        if (!params.replayTrace)
+        {
+            throw std::invalid_argument("Workload trace needs a trace file.");
+        }
+
+        return [t = params.replayTrace, probe]()
+        {
+            return replay_trace<Queue>(*t, probe);
+        };
+    }
+
+    namespace trace_impl
+    {
+        inline constexpr char Magic[]  = "MIXTRACE";
+        inline constexpr auto MagicLen = sizeof(Magic) - 1;
+        inline constexpr auto Version  = std::uint64_t {2};
+
+        inline auto write_varint
+            (std::ostream& ost, std::uint64_t value) -> void
+        {
+            while (value >= 0x80)
+            {
+                ost.put(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            ost.put(static_cast<char>(value));
+        }
+
+        inline auto read_varint
+            (std::istream& ist) -> std::uint64_t
+        {
+            auto value = std::uint64_t {0};
+            for (auto shift = 0u; shift < 64; shift += 7)
+            {
+                auto const byte = ist.get();
+                if (std::istream::traits_type::eof() == byte)
+                {
+                    throw std::runtime_error("Trace is truncated.");
+                }
+
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                {
+                    return value;
+                }
+            }
+            throw std::runtime_error("Trace contains invalid number.");
+        }
+
+        inline auto read_id
+            (std::istream& ist) -> trace_id_t
+        {
+            auto const id = read_varint(ist);
+            if (id > std::numeric_limits<trace_id_t>::max())
+            {
+                throw std::runtime_error("Trace contains invalid id.");
+            }
+            return static_cast<trace_id_t>(id);
+        }
+    }
+
+// trace definition:
+
+    inline auto trace::insert
+        (trace_key_t const key) -> trace_id_t
+    {
+        if (removedAt_.size() > std::numeric_limits<trace_id_t>::max())
+        {
+            throw std::overflow_error("Too many inserts for trace_id_t.");
+        }
+
+        auto const id = static_cast<trace_id_t>(removedAt_.size());
+        records_.emplace_back(trace_record {trace_op::insert, id, key});
+        removedAt_.emplace_back(NotRemoved);
+        return id;
+    }
+
+    inline auto trace::delete_min
+        (trace_id_t const id) -> void
+    {
+        this->remove(trace_op::delete_min, id);
+    }
+
+    inline auto trace::decrease_key
+        (trace_id_t const id, trace_key_t const key) -> void
+    {
+        this->check_id(id);
+        records_.emplace_back(trace_record {trace_op::decrease_key, id, key});
+    }
+
+    inline auto trace::erase
+        (trace_id_t const id) -> void
+    {
+        this->remove(trace_op::erase, id);
+    }
+
+    inline auto trace::records
+        () const -> std::vector<trace_record> const&
+    {
+        return records_;
+    }
+
+    inline auto trace::size
+        () const -> std::size_t
+    {
+        return records_.size();
+    }
+
+    inline auto trace::insert_count
+        () const -> std::size_t
+    {
+        return removedAt_.size();
+    }
+
+    inline auto trace::removed_at
+        (trace_id_t const id) const -> std::uint64_t
+    {
+        return removedAt_[id];
+    }
+
+    inline auto trace::write
+        (std::ostream& ost) const -> void
+    {
+        using namespace trace_impl;
+
+        ost.write(Magic, MagicLen);
+        write_varint(ost, Version);
+        write_varint(ost, records_.size());
+
+        for (auto const& record : records_)
+        {
+            ost.put(static_cast<char>(record.op));
+            switch (record.op)
+            {
+                case trace_op::insert:
+                    write_varint(ost, record.key);
+                    break;
+
+                case trace_op::delete_min:
+                case trace_op::erase:
+                    write_varint(ost, record.id);
+                    break;
+
+                case trace_op::decrease_key:
+                    write_varint(ost, record.id);
+                    write_varint(ost, record.key);
+                    break;
+            }
+        }
+    }
+
+    inline auto trace::save
+        (std::string const& filePath) const -> void
+    {
+        auto ofst = std::ofstream(filePath, std::ios::binary);
+        if (!ofst.is_open())
+        {
+            throw std::runtime_error("Failed to open " + filePath);
+        }
+
+        this->write(ofst);
+        if (!ofst)
+        {
+            throw std::runtime_error("Failed to write " + filePath);
+        }
+    }
+
+    inline auto trace::read
+        (std::istream& ist) -> trace
+    {
+        using namespace trace_impl;
+
+        char magic[MagicLen];
+        if (!ist.read(magic, MagicLen) || !std::equal(magic, magic + MagicLen, Magic))
+        {
+            throw std::runtime_error("Not a trace.");
+        }
+
+        if (Version != read_varint(ist))
+        {
+            throw std::runtime_error("Unsupported version of trace.");
+        }
+
+        auto const count = read_varint(ist);
+        auto t           = trace();
+        t.records_.reserve(std::min<std::uint64_t>(count, 1 << 20));
+
+        for (auto i = 0ul; i < count; ++i)
+        {
+            auto const op = ist.get();
+            switch (op)
+            {
+                case static_cast<int>(trace_op::insert):
+                    t.insert(read_varint(ist));
+                    break;
+
+                case static_cast<int>(trace_op::delete_min):
+                    t.delete_min(read_id(ist));
+                    break;
+
+                case static_cast<int>(trace_op::decrease_key):
+                {
+                    auto const id = read_id(ist);
+                    t.decrease_key(id, read_varint(ist));
+                    break;
+                }
+
+                case static_cast<int>(trace_op::erase):
+                    t.erase(read_id(ist));
+                    break;
+
+                default:
+                    throw std::runtime_error(std::istream::traits_type::eof() == op
+                        ? "Trace is truncated."
+                        : "Trace contains unknown operation.");
+            }
+        }
+
+        return t;
+    }
+
+    inline auto trace::load
+        (std::string const& filePath) -> trace
+    {
+        auto ifst = std::ifstream(filePath, std::ios::binary);
+        if (!ifst.is_open())
+        {
+            throw std::runtime_error("Failed to open " + filePath);
+        }
+
+        try
+        {
+            return read(ifst);
+        }
+        catch (std::runtime_error const& e)
+        {
+            throw std::runtime_error(filePath + ": " + e.what());
+        }
+    }
+
+    inline auto trace::check_id
+        (trace_id_t const id) const -> void
+    {
+        if (id >= removedAt_.size())
+        {
+            throw std::runtime_error("Trace refers to an element that was not inserted.");
+        }
+
+        if (NotRemoved != removedAt_[id])
+        {
+            throw std::runtime_error("Trace refers to an element that was already removed.");
+        }
+    }
+
+    inline auto trace::remove
+        (trace_op const op, trace_id_t const id) -> void
+    {
+        this->check_id(id);
+        removedAt_[id] = records_.size();
+        records_.emplace_back(trace_record {op, id, 0});
+    }
+}
+
+#endif
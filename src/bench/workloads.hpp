@@ -0,0 +1,436 @@
+#ifndef MIX_DS_BENCH_WORKLOADS_HPP
+#define MIX_DS_BENCH_WORKLOADS_HPP
+
+#include "../compare/dijkstra.hpp"
+#include "../compare/graph_generator.hpp"
+#include "../utils/random_wrap.hpp"
+#include "../utils/histogram.hpp"
+#include "../utils/stopwatch.hpp"
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace mix::bench
+{
+    using key_t      = unsigned int;
+    using checksum_t = std::uint64_t;
+
+    class trace;
+
+    /**
+        Size and seed of one benchmark run and
+        a trace for workloads that replay one.
+     */
+    struct bench_params
+    {
+        std::size_t                  n;
+        unsigned long                seed;
+        std::shared_ptr<trace const> replayTrace {};
+    };
+
+    /**
+        Workload with all random input already generated.
+        Each call runs it once from scratch and returns a checksum
+        that keeps the compiler from optimizing the work away.
+     */
+    using bench_run = std::function<checksum_t()>;
+
+    /**
+        Element of the queue workloads. Id is unique and never changes,
+        it breaks ties of keys so that every queue deletes the same elements
+        and does the same work. Index is the position of its handle
+        in the handle vector so that it can be erased in O(1).
+     */
+    struct bench_data
+    {
+        key_t       key;
+        key_t       id;
+        std::size_t index;
+    };
+
+    inline auto operator< (bench_data const& lhs, bench_data const& rhs)
+    {
+        return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.id < rhs.id);
+    }
+
+    /**
+        Operations whose latency can be recorded.
+     */
+    enum class op_kind : std::size_t
+    {
+        insert, delete_min, decrease_key, erase, meld, Count
+    };
+
+    inline auto op_name (op_kind const op) -> char const*
+    {
+        switch (op)
+        {
+            case op_kind::insert:       return "insert";
+            case op_kind::delete_min:   return "delete_min";
+            case op_kind::decrease_key: return "decrease_key";
+            case op_kind::erase:        return "erase";
+            case op_kind::meld:         return "meld";
+            default:                    return "unknown";
+        }
+    }
+
+    /**
+        One latency histogram (in cycle_timer ticks) for each operation.
+     */
+    class op_histograms
+    {
+    public:
+        static constexpr auto OpCount = static_cast<std::size_t>(op_kind::Count);
+
+        auto operator[] (op_kind const op) -> utils::histogram&
+        {
+            return histograms_[static_cast<std::size_t>(op)];
+        }
+
+        auto reset () -> void
+        {
+            for (auto& h : histograms_)
+            {
+                h.reset();
+            }
+        }
+
+    private:
+        std::array<utils::histogram, OpCount> histograms_;
+    };
+
+    /**
+        Probes are called around every queue operation of a workload.
+        This one only runs the operation so it costs nothing.
+     */
+    struct no_probe
+    {
+        template<class Operation>
+        auto operator() (op_kind, Operation&& operation) const -> void
+        {
+            operation();
+        }
+    };
+
+    /**
+        Records latency of each operation into histograms.
+     */
+    class latency_probe
+    {
+    public:
+        explicit latency_probe (op_histograms& histograms) :
+            histograms_ (&histograms)
+        {
+        }
+
+        template<class Operation>
+        auto operator() (op_kind const op, Operation&& operation) const -> void
+        {
+            auto const start = utils::cycle_timer::now();
+            operation();
+            auto const end   = utils::cycle_timer::now();
+            (*histograms_)[op].record(end - start);
+        }
+
+    private:
+        op_histograms* histograms_;
+    };
+
+    namespace bench_impl
+    {
+        template<class Queue, class = void>
+        struct has_meld : std::false_type
+        {
+        };
+
+        template<class Queue>
+        struct has_meld< Queue
+                       , std::void_t<decltype(std::declval<Queue&>().meld(std::declval<Queue>()))> >
+            : std::true_type
+        {
+        };
+
+        inline auto random_keys
+            (std::size_t const n, key_t const min, key_t const max, unsigned long const seed)
+        {
+            auto rng  = utils::random_uniform_int<key_t>(min, max, seed);
+            auto keys = std::vector<key_t>(n);
+            for (auto& key : keys)
+            {
+                key = rng.next_int();
+            }
+            return keys;
+        }
+
+        /**
+            Element with given key whose id and index are both @p i.
+         */
+        inline auto make_data
+            (key_t const key, std::size_t const i) -> bench_data
+        {
+            return bench_data {key, static_cast<key_t>(i), i};
+        }
+
+        template<class Handles>
+        auto erase_handle (Handles& handles, std::size_t const index)
+        {
+            std::swap(handles[index], handles.back());
+            handles.pop_back();
+
+            if (index < handles.size())
+            {
+                (*handles[index]).index = index;
+            }
+        }
+
+        template<class Queue, class Probe>
+        auto drain (Queue& queue, Probe const& probe) -> checksum_t
+        {
+            auto sum = checksum_t {0};
+            while (!queue.empty())
+            {
+                sum += queue.find_min().key;
+                probe(op_kind::delete_min, [&](){ queue.delete_min(); });
+            }
+            return sum;
+        }
+    }
+
+    /**
+        Queue supports meld so the meld workload can be run on it.
+     */
+    template<class Queue>
+    inline constexpr auto has_meld_v = bench_impl::has_meld<Queue>::value;
+
+    /**
+        n inserts followed by n delete_mins.
+     */
+    template<class Queue, class Probe = no_probe>
+    auto prepare_delete (bench_params const& params, Probe const probe = Probe()) -> bench_run
+    {
+        auto keys = bench_impl::random_keys(params.n, 0, params.n, params.seed);
+        return [keys = std::move(keys), probe]()
+        {
+            auto queue = Queue();
+            for (auto i = 0ul; i < keys.size(); ++i)
+            {
+                probe(op_kind::insert, [&](){ queue.insert(bench_impl::make_data(keys[i], i)); });
+            }
+            return bench_impl::drain(queue, probe);
+        };
+    }
+
+    /**
+        Hold model: n inserts, n steps that delete the minimum and insert
+        an element with a larger key, then n delete_mins. Uses no handles
+        so it also runs on queues that do not have them e.g. sequence_heap.
+     */
+    template<class Queue, class Probe = no_probe>
+    auto prepare_throughput (bench_params const& params, Probe const probe = Probe()) -> bench_run
+    {
+        auto const n   = params.n;
+        auto keys      = bench_impl::random_keys(n, 0, n, params.seed);
+        auto increases = bench_impl::random_keys(n, 1, n, params.seed + 1);
+
+        return [=]()
+        {
+            auto queue = Queue();
+            auto sum   = checksum_t {0};
+
+            for (auto i = 0ul; i < n; ++i)
+            {
+                probe(op_kind::insert, [&](){ queue.insert(bench_impl::make_data(keys[i], i)); });
+            }
+
+            for (auto i = 0ul; i < n; ++i)
+            {
+                auto const min = queue.find_min().key;
+                sum += min;
+                probe(op_kind::delete_min, [&](){ queue.delete_min(); });
+                probe(op_kind::insert, [&](){ queue.insert(bench_impl::make_data(min + increases[i], n + i)); });
+            }
+
+            return sum + bench_impl::drain(queue, probe);
+        };
+    }
+
+    /**
+        n inserts, n decrease_keys of random elements and n delete_mins.
+     */
+    template<class Queue, class Probe = no_probe>
+    auto prepare_decrease (bench_params const& params, Probe const probe = Probe()) -> bench_run
+    {
+        auto const n  = params.n;
+        auto keys     = bench_impl::random_keys(n, n, 2 * n, params.seed);
+        auto targets  = bench_impl::random_keys(n, 0, n - 1, params.seed + 1);
+        auto decrease = bench_impl::random_keys(n, 1, n, params.seed + 2);
+
+        return [=]()
+        {
+            using handle_t = typename Queue::handle_t;
+            auto queue     = Queue();
+            auto handles   = std::vector<handle_t>();
+            handles.reserve(n);
+
+            for (auto i = 0ul; i < n; ++i)
+            {
+                probe(op_kind::insert, [&](){ handles.emplace_back(queue.insert(bench_impl::make_data(keys[i], i))); });
+            }
+
+            for (auto i = 0ul; i < n; ++i)
+            {
+                auto handle = handles[targets[i]];
+                auto& key   = (*handle).key;
+                key         = key > decrease[i] ? key - decrease[i] : 0;
+                probe(op_kind::decrease_key, [&](){ queue.decrease_key(handle); });
+            }
+
+            return bench_impl::drain(queue, probe);
+        };
+    }
+
+    /**
+        Same operation mix as queue_test_random_all: n inserts followed
+        by n operations chosen uniformly from insert, delete_min,
+        decrease_key and erase. Operations are generated in advance.
+     */
+    template<class Queue, class Probe = no_probe>
+    auto prepare_random_all (bench_params const& params, Probe const probe = Probe()) -> bench_run
+    {
+        auto const n = params.n;
+        auto keys    = bench_impl::random_keys(n, 1, n, params.seed);
+        auto ops     = bench_impl::random_keys(n, 0, 3, params.seed + 1);
+        auto values  = bench_impl::random_keys(n, 1, n, params.seed + 2);
+        auto indices = bench_impl::random_keys(n, 0, std::numeric_limits<key_t>::max(), params.seed + 3);
+
+        return [=]()
+        {
+            using handle_t = typename Queue::handle_t;
+            auto queue     = Queue();
+            auto handles   = std::vector<handle_t>();
+            auto sum       = checksum_t {0};
+            handles.reserve(2 * n);
+
+            for (auto i = 0ul; i < n; ++i)
+            {
+                probe(op_kind::insert, [&](){ handles.emplace_back(queue.insert(bench_impl::make_data(keys[i], i))); });
+            }
+
+            for (auto i = 0ul; i < n; ++i)
+            {
+                switch (ops[i])
+                {
+                    case 0:
+                    {
+                        auto const data = bench_data {values[i], static_cast<key_t>(n + i), handles.size()};
+                        probe(op_kind::insert, [&](){ handles.emplace_back(queue.insert(data)); });
+                        break;
+                    }
+                    case 1:
+                    {
+                        if (queue.empty())
+                        {
+                            break;
+                        }
+                        sum += queue.find_min().key;
+                        bench_impl::erase_handle(handles, queue.find_min().index);
+                        probe(op_kind::delete_min, [&](){ queue.delete_min(); });
+                        break;
+                    }
+                    case 2:
+                    {
+                        if (handles.empty())
+                        {
+                            break;
+                        }
+                        auto handle = handles[indices[i] % handles.size()];
+                        auto& key   = (*handle).key;
+                        key         = key > values[i] ? key - values[i] : 0;
+                        probe(op_kind::decrease_key, [&](){ queue.decrease_key(handle); });
+                        break;
+                    }
+                    default:
+                    {
+                        if (handles.empty())
+                        {
+                            break;
+                        }
+                        auto const index  = indices[i] % handles.size();
+                        auto const handle = handles[index];
+                        bench_impl::erase_handle(handles, index);
+                        probe(op_kind::erase, [&](){ queue.erase(handle); });
+                        break;
+                    }
+                }
+            }
+
+            return sum + bench_impl::drain(queue, probe);
+        };
+    }
+
+    /**
+        n elements are inserted into 64 queues that are then melded
+        pairwise until one remains, which is emptied by delete_mins.
+     */
+    template<class Queue, class Probe = no_probe>
+    auto prepare_meld (bench_params const& params, Probe const probe = Probe()) -> bench_run
+    {
+        auto keys = bench_impl::random_keys(params.n, 0, params.n, params.seed);
+        return [keys = std::move(keys), probe]()
+        {
+            auto constexpr QueueCount = 64ul;
+            auto queues = std::vector<Queue>(QueueCount);
+            for (auto i = 0ul; i < keys.size(); ++i)
+            {
+                probe(op_kind::insert, [&](){ queues[i % QueueCount].insert(bench_impl::make_data(keys[i], i)); });
+            }
+
+            for (auto step = 1ul; step < QueueCount; step *= 2)
+            {
+                for (auto i = 0ul; i + step < QueueCount; i += 2 * step)
+                {
+                    probe(op_kind::meld, [&](){ queues[i].meld(std::move(queues[i + step])); });
+                }
+            }
+
+            return bench_impl::drain(queues.front(), probe);
+        };
+    }
+
+    /**
+        Point to point Dijkstra queries on a grid graph with roughly
+        n vertices. The graph is built in advance.
+     */
+    template<template<class, class, class...> class Queue, class... Options>
+    auto prepare_dijkstra (bench_params const& params) -> bench_run
+    {
+        auto constexpr QueryCount = 20ul;
+        auto constexpr MaxCost    = 1'000;
+
+        auto const side = std::max(2ul, static_cast<std::size_t>(std::sqrt(params.n)));
+        auto graph      = std::make_shared<ds::graph_t>(ds::make_grid_graph(side, side, MaxCost, params.seed));
+        auto sources    = bench_impl::random_keys(QueryCount, 0, side * side - 1, params.seed + 1);
+        auto targets    = bench_impl::random_keys(QueryCount, 0, side * side - 1, params.seed + 2);
+
+        return [=]()
+        {
+            auto sum = checksum_t {0};
+            for (auto i = 0ul; i < QueryCount; ++i)
+            {
+                auto const path = ds::find_point_to_point<Queue, Options...>(*graph, sources[i], targets[i]);
+                sum += static_cast<checksum_t>(path.cost);
+            }
+            return sum;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,308 @@
+#ifndef MIX_DS_ALT_HPP
+#define MIX_DS_ALT_HPP
+
+#include "dijkstra.hpp"
+#include "../utils/random_wrap.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <any>
+
+namespace mix::ds
+{
+    using landmark_dist_t = std::uint32_t;
+
+    /**
+        Precomputed distances between landmarks and all vertices of a graph.
+        For each vertex the table holds pairs (from, to) for every landmark
+        where from = d(landmark, vertex) and to = d(vertex, landmark).
+        Rows are stored vertex-major so that the potential of a single vertex
+        is computed from one contiguous block of memory.
+     */
+    struct landmark_tables
+    {
+        std::size_t                  vertexCount;
+        std::vector<id_t>            landmarks;
+        std::vector<landmark_dist_t> dists;
+    };
+
+    inline auto constexpr landmark_unreachable
+        () -> landmark_dist_t
+    {
+        return std::numeric_limits<landmark_dist_t>::max();
+    }
+
+    namespace alt_impl
+    {
+        inline auto constexpr FileMagic = std::uint64_t {0x5441'4c53'4458'494d}; // "MIXDSLAT"
+
+        inline auto to_landmark_dist
+            (dist_t const d) -> landmark_dist_t
+        {
+            if (dijkstra_max_dist() == d)
+            {
+                return landmark_unreachable();
+            }
+
+            if (d >= static_cast<dist_t>(landmark_unreachable()))
+            {
+                throw std::overflow_error("Landmark distance does not fit into landmark_dist_t.");
+            }
+
+            return static_cast<landmark_dist_t>(d);
+        }
+
+        inline auto row
+            (landmark_tables const& lt, id_t const v) -> landmark_dist_t const*
+        {
+            return lt.dists.data() + 2 * v * lt.landmarks.size();
+        }
+
+        /**
+            Lower bound of d(v, t) given the table rows of v and t.
+            Uses triangle inequality in both directions for each landmark.
+         */
+        inline auto potential
+            (landmark_dist_t const* vRow, landmark_dist_t const* tRow, std::size_t const k) -> dist_t
+        {
+            auto constexpr Inf = landmark_unreachable();
+            auto pot = dist_t {0};
+
+            for (auto l = 0ul; l < k; ++l)
+            {
+                auto const fromV = vRow[2 * l];
+                auto const toV   = vRow[2 * l + 1];
+                auto const fromT = tRow[2 * l];
+                auto const toT   = tRow[2 * l + 1];
+
+                if (Inf != fromV && Inf != fromT)
+                {
+                    pot = std::max(pot, static_cast<dist_t>(fromT) - static_cast<dist_t>(fromV));
+                }
+
+                if (Inf != toV && Inf != toT)
+                {
+                    pot = std::max(pot, static_cast<dist_t>(toV) - static_cast<dist_t>(toT));
+                }
+            }
+
+            return pot;
+        }
+    }
+
+    /**
+        Picks @p k landmarks using the farthest-first heuristic and computes
+        distances from and to each of them using find_point_to_all.
+        First landmark is the vertex farthest from a random vertex, every next
+        landmark is the vertex whose distance to the closest already selected
+        landmark is the largest.
+        Distance fields of vertices in @p g are overwritten.
+     */
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto make_landmark_tables
+        (graph_t& g, std::size_t const k, unsigned long const seed) -> landmark_tables
+    {
+        auto const n     = g.vertices.size();
+        auto reversed    = reverse_graph(g);
+        auto rngStart    = utils::random_uniform_int<id_t>(0, n - 1, seed);
+        auto closestDist = std::vector<dist_t>(n, dijkstra_max_dist());
+        auto tables      = landmark_tables {n, {}, std::vector<landmark_dist_t>(2 * n * k)};
+
+        auto const farthest = [n](auto const& dists)
+        {
+            auto maxDist = dist_t {-1};
+            auto maxId   = id_t {0};
+            for (auto v = 0ul; v < n; ++v)
+            {
+                if (dijkstra_max_dist() != dists(v) && dists(v) > maxDist)
+                {
+                    maxDist = dists(v);
+                    maxId   = v;
+                }
+            }
+            return maxId;
+        };
+
+        find_point_to_all<PrioQueue, Options...>(g, rngStart.next_int());
+        auto landmark = farthest([&g](auto const v) { return g.vertices[v].distAprox; });
+
+        for (auto l = 0ul; l < k; ++l)
+        {
+            tables.landmarks.emplace_back(landmark);
+            find_point_to_all<PrioQueue, Options...>(g, landmark);
+            find_point_to_all<PrioQueue, Options...>(reversed, landmark);
+
+            for (auto v = 0ul; v < n; ++v)
+            {
+                auto const from = g.vertices[v].distAprox;
+                auto const to   = reversed.vertices[v].distAprox;
+                tables.dists[2 * (v * k + l)]     = alt_impl::to_landmark_dist(from);
+                tables.dists[2 * (v * k + l) + 1] = alt_impl::to_landmark_dist(to);
+                closestDist[v] = std::min(closestDist[v], from);
+            }
+
+            landmark = farthest([&closestDist](auto const v) { return closestDist[v]; });
+        }
+
+        return tables;
+    }
+
+    /**
+        Saves landmark tables into a binary file.
+     */
+    inline auto save_landmark_tables
+        (landmark_tables const& lt, std::string const& filePath) -> void
+    {
+        auto ofst = std::ofstream(filePath, std::ios::binary);
+
+        if (!ofst.is_open())
+        {
+            throw std::runtime_error("Failed to open " + filePath);
+        }
+
+        auto const magic = alt_impl::FileMagic;
+        auto const n     = static_cast<std::uint64_t>(lt.vertexCount);
+        auto const k     = static_cast<std::uint64_t>(lt.landmarks.size());
+
+        ofst.write(reinterpret_cast<char const*>(&magic), sizeof(magic));
+        ofst.write(reinterpret_cast<char const*>(&n), sizeof(n));
+        ofst.write(reinterpret_cast<char const*>(&k), sizeof(k));
+        ofst.write( reinterpret_cast<char const*>(lt.landmarks.data())
+                  , static_cast<std::streamsize>(k * sizeof(id_t)) );
+        ofst.write( reinterpret_cast<char const*>(lt.dists.data())
+                  , static_cast<std::streamsize>(lt.dists.size() * sizeof(landmark_dist_t)) );
+
+        if (!ofst)
+        {
+            throw std::runtime_error("Failed to write " + filePath);
+        }
+    }
+
+    /**
+        Loads landmark tables previously saved by save_landmark_tables.
+     */
+    inline auto load_landmark_tables
+        (std::string const& filePath) -> landmark_tables
+    {
+        auto ifst = std::ifstream(filePath, std::ios::binary);
+
+        if (!ifst.is_open())
+        {
+            throw std::runtime_error("Failed to open " + filePath);
+        }
+
+        auto magic = std::uint64_t {0};
+        auto n     = std::uint64_t {0};
+        auto k     = std::uint64_t {0};
+        ifst.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        ifst.read(reinterpret_cast<char*>(&n), sizeof(n));
+        ifst.read(reinterpret_cast<char*>(&k), sizeof(k));
+
+        if (!ifst || alt_impl::FileMagic != magic)
+        {
+            throw std::runtime_error(filePath + " is not a landmark table file.");
+        }
+
+        auto lt = landmark_tables { n
+                                  , std::vector<id_t>(k)
+                                  , std::vector<landmark_dist_t>(2 * n * k) };
+        ifst.read( reinterpret_cast<char*>(lt.landmarks.data())
+                 , static_cast<std::streamsize>(k * sizeof(id_t)) );
+        ifst.read( reinterpret_cast<char*>(lt.dists.data())
+                 , static_cast<std::streamsize>(lt.dists.size() * sizeof(landmark_dist_t)) );
+
+        if (!ifst)
+        {
+            throw std::runtime_error(filePath + " is truncated.");
+        }
+
+        return lt;
+    }
+
+    /**
+        A* search that uses landmark distances as potentials (ALT).
+        distAprox of a vertex holds its tentative distance plus its potential
+        so that the queue orders vertices by the A* key while still
+        using vertex_ptr_compare.
+        Terms of landmarks that a vertex cannot reach are dropped, so on directed
+        graphs the potential is a lower bound but it need not be consistent.
+        A vertex that is improved after it was popped is therefore inserted again.
+     */
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto find_point_to_point_alt
+        (graph_t& vs, landmark_tables const& lt, id_t const from, id_t const to)
+    {
+        using queue_t  = PrioQueue<vertex*, vertex_ptr_compare, Options...>;
+        using handle_t = typename queue_t::handle_t;
+
+        auto constexpr Unknown = dist_t {-1};
+
+        auto queue      = queue_t();
+        auto potentials = std::vector<dist_t>(vs.vertices.size(), Unknown);
+        auto const k    = lt.landmarks.size();
+        auto const tRow = alt_impl::row(lt, to);
+
+        auto const potential = [&](id_t const v)
+        {
+            if (Unknown == potentials[v])
+            {
+                potentials[v] = alt_impl::potential(alt_impl::row(lt, v), tRow, k);
+            }
+            return potentials[v];
+        };
+
+        reset_parents(vs);
+        for (auto& v : vs.vertices)
+        {
+            v.distAprox = dijkstra_max_dist();
+            v.isInQueue = false;
+        }
+        vs.vertices[from].distAprox = potential(from);
+        vs.vertices[from].handle    = queue.insert(&vs.vertices[from]);
+        vs.vertices[from].isInQueue = true;
+
+        while (!queue.empty())
+        {
+            auto const current = queue.find_min();
+            queue.delete_min();
+            current->isInQueue = false;
+
+            auto const currentDist = current->distAprox - potentials[current->id];
+
+            if (current == &vs.vertices[to])
+            {
+                return path_t {from, to, currentDist};
+            }
+
+            for (auto const edge : current->forward)
+            {
+                auto const target = &vs.vertices[edge.target];
+                auto const key    = currentDist + edge.cost + potential(edge.target);
+                if (key < target->distAprox)
+                {
+                    target->distAprox = key;
+                    vs.parents[edge.target] = static_cast<parent_t>(current->id);
+
+                    if (target->isInQueue)
+                    {
+                        queue.decrease_key(std::any_cast<handle_t>(target->handle));
+                    }
+                    else
+                    {
+                        target->handle    = queue.insert(target);
+                        target->isInQueue = true;
+                    }
+                }
+            }
+        }
+
+        return path_t {0, 0, dijkstra_max_dist()};
+    }
+}
+
+#endif
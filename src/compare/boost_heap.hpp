@@ -3,6 +3,7 @@
 
 #include <boost/heap/pairing_heap.hpp>
 #include <boost/heap/fibonacci_heap.hpp>
+#include <boost/heap/d_ary_heap.hpp>
 
 namespace mix::ds
 {
@@ -71,6 +72,11 @@ namespace mix::ds
             return heap_.size();
         }
 
+        auto clear () -> void
+        {
+            heap_.clear();
+        }
+
         auto begin () -> iterator
         {
             return heap_.begin();
@@ -97,6 +103,18 @@ namespace mix::ds
 
     template<class T, class Compare>
     using boost_fibonacci_heap = boost_heap<boost::heap::fibonacci_heap, T, Compare>;
+
+    /**
+        Addressable 4-ary heap.
+     */
+    template<class T, class... Options>
+    using boost_mutable_d_ary = boost::heap::d_ary_heap< T
+                                                       , boost::heap::arity<4>
+                                                       , boost::heap::mutable_<true>
+                                                       , Options... >;
+
+    template<class T, class Compare>
+    using boost_d_ary_heap = boost_heap<boost_mutable_d_ary, T, Compare>;
 }
 
 #endif
\ No newline at end of file
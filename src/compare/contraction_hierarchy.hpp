@@ -0,0 +1,415 @@
+#ifndef MIX_DS_CONTRACTION_HIERARCHY_HPP
+#define MIX_DS_CONTRACTION_HIERARCHY_HPP
+
+#include "dijkstra.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <optional>
+#include <algorithm>
+
+namespace mix::ds
+{
+    struct ch_edge
+    {
+        dist_t cost;
+        id_t   target;
+    };
+
+    /**
+        Contracted graph. Vertex v has upward edges in
+        upEdges[upOffsets[v] .. upOffsets[v + 1]) that lead to vertices
+        contracted later than v, and downward edges in
+        downEdges[downOffsets[v] .. downOffsets[v + 1]) that are reversed
+        edges coming into v from vertices contracted later than v.
+     */
+    struct contraction_hierarchy
+    {
+        std::vector<std::uint32_t> rank;
+        std::vector<std::size_t>   upOffsets;
+        std::vector<ch_edge>       upEdges;
+        std::vector<std::size_t>   downOffsets;
+        std::vector<ch_edge>       downEdges;
+    };
+
+    namespace ch_impl
+    {
+        /**
+            Witness searches give up after settling this many vertices.
+            A missed witness only adds a superfluous shortcut so priority
+            estimates use a smaller limit than the actual contraction.
+         */
+        inline auto constexpr WitnessSettledLimit   = 200ul;
+        inline auto constexpr SimulatedSettledLimit = 10ul;
+
+        using adjacency_t = std::vector<std::vector<ch_edge>>;
+
+        inline auto add_or_update_edge
+            (std::vector<ch_edge>& edges, id_t const target, dist_t const cost) -> void
+        {
+            auto const it = std::find_if(std::begin(edges), std::end(edges), [target](auto const& e)
+            {
+                return e.target == target;
+            });
+
+            if (std::end(edges) == it)
+            {
+                edges.emplace_back(ch_edge {cost, target});
+            }
+            else
+            {
+                it->cost = std::min(it->cost, cost);
+            }
+        }
+
+        inline auto remove_edge
+            (std::vector<ch_edge>& edges, id_t const target) -> void
+        {
+            edges.erase( std::remove_if( std::begin(edges), std::end(edges)
+                                       , [target](auto const& e) { return e.target == target; } )
+                       , std::end(edges) );
+        }
+
+        inline auto to_csr
+            (adjacency_t const& adjacency, std::vector<std::size_t>& offsets, std::vector<ch_edge>& edges) -> void
+        {
+            offsets.reserve(adjacency.size() + 1);
+            offsets.emplace_back(0);
+
+            for (auto const& es : adjacency)
+            {
+                edges.insert(std::end(edges), std::begin(es), std::end(es));
+                offsets.emplace_back(edges.size());
+            }
+        }
+
+        /**
+            Holds the remaining (not yet contracted) graph during preprocessing.
+         */
+        template<template<class, class, class...> class PrioQueue, class... Options>
+        class contractor
+        {
+        public:
+            contractor (graph_t const& g);
+
+            auto run () -> contraction_hierarchy;
+
+        private:
+            auto contract      (id_t const v, bool const simulate) -> std::int64_t;
+            auto priority      (id_t const v)                      -> std::int64_t;
+            auto witness_search ( id_t const from, id_t const ignore, dist_t const maxDist
+                                , std::size_t const targetCount, std::size_t const settledLimit ) -> void;
+
+        private:
+            adjacency_t                           out_;
+            adjacency_t                           in_;
+            adjacency_t                           up_;
+            adjacency_t                           down_;
+            std::vector<std::uint32_t>            deletedNeighbours_;
+            std::vector<std::uint32_t>            level_;
+            std::vector<std::uint32_t>            targetMarks_;
+            std::uint32_t                         currentMark_;
+            search_state<PrioQueue, Options...>   witness_;
+        };
+
+        template<template<class, class, class...> class PrioQueue, class... Options>
+        contractor<PrioQueue, Options...>::contractor
+            (graph_t const& g) :
+            out_               (g.vertices.size()),
+            in_                (g.vertices.size()),
+            up_                (g.vertices.size()),
+            down_              (g.vertices.size()),
+            deletedNeighbours_ (g.vertices.size(), 0),
+            level_             (g.vertices.size(), 0),
+            targetMarks_       (g.vertices.size(), 0),
+            currentMark_       (0),
+            witness_           (g.vertices.size())
+        {
+            for (auto const& v : g.vertices)
+            {
+                for (auto const e : v.forward)
+                {
+                    if (e.target != v.id)
+                    {
+                        add_or_update_edge(out_[v.id], e.target, e.cost);
+                        add_or_update_edge(in_[e.target], v.id, e.cost);
+                    }
+                }
+            }
+        }
+
+        template<template<class, class, class...> class PrioQueue, class... Options>
+        auto contractor<PrioQueue, Options...>::run
+            () -> contraction_hierarchy
+        {
+            using queue_t  = PrioQueue<queue_entry, queue_entry_compare, Options...>;
+            using handle_t = typename queue_t::handle_t;
+
+            auto const n = out_.size();
+            auto queue   = queue_t();
+            auto handles = std::vector<std::optional<handle_t>>(n);
+            auto ranks   = std::vector<std::uint32_t>(n);
+            auto order   = std::uint32_t {0};
+
+            for (auto v = 0ul; v < n; ++v)
+            {
+                handles[v] = queue.insert(queue_entry {this->priority(v), v});
+            }
+
+            while (!queue.empty())
+            {
+                auto const v = queue.find_min().id;
+                queue.delete_min();
+                handles[v].reset();
+
+                // Lazy update, priority of v might be outdated.
+                auto const prio = this->priority(v);
+                if (!queue.empty() && prio > queue.find_min().dist)
+                {
+                    handles[v] = queue.insert(queue_entry {prio, v});
+                    continue;
+                }
+
+                this->contract(v, false);
+                ranks[v] = order++;
+
+                auto neighbours = std::vector<id_t>();
+                for (auto const& e : out_[v])
+                {
+                    neighbours.emplace_back(e.target);
+                }
+                for (auto const& e : in_[v])
+                {
+                    neighbours.emplace_back(e.target);
+                }
+
+                up_[v]   = std::move(out_[v]);
+                down_[v] = std::move(in_[v]);
+                out_[v].clear();
+                in_[v].clear();
+                for (auto const& e : up_[v])
+                {
+                    remove_edge(in_[e.target], v);
+                }
+                for (auto const& e : down_[v])
+                {
+                    remove_edge(out_[e.target], v);
+                }
+
+                std::sort(std::begin(neighbours), std::end(neighbours));
+                neighbours.erase(std::unique(std::begin(neighbours), std::end(neighbours)), std::end(neighbours));
+
+                for (auto const u : neighbours)
+                {
+                    ++deletedNeighbours_[u];
+                    level_[u] = std::max(level_[u], level_[v] + 1);
+
+                    auto& handle       = *handles[u];
+                    auto const newPrio = this->priority(u);
+
+                    if (newPrio < (*handle).dist)
+                    {
+                        (*handle).dist = newPrio;
+                        queue.decrease_key(handle);
+                    }
+                    else if (newPrio > (*handle).dist)
+                    {
+                        queue.erase(handle);
+                        handles[u] = queue.insert(queue_entry {newPrio, u});
+                    }
+                }
+            }
+
+            auto ch = contraction_hierarchy {std::move(ranks), {}, {}, {}, {}};
+            to_csr(up_, ch.upOffsets, ch.upEdges);
+            to_csr(down_, ch.downOffsets, ch.downEdges);
+            return ch;
+        }
+
+        /**
+            Contracts @p v or only counts the shortcuts that its contraction
+            would need if @p simulate is true.
+            @return number of shortcuts.
+         */
+        template<template<class, class, class...> class PrioQueue, class... Options>
+        auto contractor<PrioQueue, Options...>::contract
+            (id_t const v, bool const simulate) -> std::int64_t
+        {
+            auto shortcuts    = std::int64_t {0};
+            auto const limit  = simulate ? SimulatedSettledLimit : WitnessSettledLimit;
+
+            for (auto const& in : in_[v])
+            {
+                ++currentMark_;
+                auto maxDist     = dist_t {0};
+                auto targetCount = 0ul;
+                for (auto const& out : out_[v])
+                {
+                    if (out.target != in.target)
+                    {
+                        maxDist = std::max(maxDist, in.cost + out.cost);
+                        targetMarks_[out.target] = currentMark_;
+                        ++targetCount;
+                    }
+                }
+
+                if (0 == targetCount)
+                {
+                    continue;
+                }
+
+                this->witness_search(in.target, v, maxDist, targetCount, limit);
+
+                for (auto const& out : out_[v])
+                {
+                    auto const viaDist = in.cost + out.cost;
+                    if (out.target == in.target || witness_.dist(out.target) <= viaDist)
+                    {
+                        continue;
+                    }
+
+                    ++shortcuts;
+                    if (!simulate)
+                    {
+                        add_or_update_edge(out_[in.target], out.target, viaDist);
+                        add_or_update_edge(in_[out.target], in.target, viaDist);
+                    }
+                }
+            }
+
+            return shortcuts;
+        }
+
+        /**
+            Edge difference combined with the number of already contracted
+            neighbours and the level, the latter two keep the hierarchy uniform.
+         */
+        template<template<class, class, class...> class PrioQueue, class... Options>
+        auto contractor<PrioQueue, Options...>::priority
+            (id_t const v) -> std::int64_t
+        {
+            auto const shortcuts    = this->contract(v, true);
+            auto const removed      = static_cast<std::int64_t>(in_[v].size() + out_[v].size());
+            auto const edgeDiff     = shortcuts - removed;
+            return 4 * edgeDiff + 2 * deletedNeighbours_[v] + level_[v];
+        }
+
+        template<template<class, class, class...> class PrioQueue, class... Options>
+        auto contractor<PrioQueue, Options...>::witness_search
+            ( id_t const from, id_t const ignore, dist_t const maxDist
+            , std::size_t targetCount, std::size_t const settledLimit ) -> void
+        {
+            witness_.reset();
+            witness_.relax(from, 0);
+
+            auto settled = 0ul;
+            while (!witness_.empty() && settled < settledLimit)
+            {
+                auto const current = witness_.pop();
+                if (current.dist > maxDist)
+                {
+                    break;
+                }
+
+                if (targetMarks_[current.id] == currentMark_ && 0 == --targetCount)
+                {
+                    break;
+                }
+
+                ++settled;
+                for (auto const& e : out_[current.id])
+                {
+                    if (e.target != ignore && current.dist + e.cost <= maxDist)
+                    {
+                        witness_.relax(e.target, current.dist + e.cost);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+        Builds contraction hierarchy of @p g. Vertices are ordered by
+        a priority queue of type PrioQueue with lazy updates and the same
+        queue type is used in witness searches.
+     */
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto make_contraction_hierarchy
+        (graph_t const& g) -> contraction_hierarchy
+    {
+        return ch_impl::contractor<PrioQueue, Options...>(g).run();
+    }
+
+    /**
+        Bidirectional upward search in a contraction hierarchy.
+        Search state is kept between queries so that each query only pays
+        for the vertices it touches.
+     */
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    class ch_query
+    {
+    public:
+        ch_query (contraction_hierarchy const& ch);
+
+        auto find_point_to_point (id_t const from, id_t const to) -> path_t;
+
+    private:
+        contraction_hierarchy const*        ch_;
+        search_state<PrioQueue, Options...> forward_;
+        search_state<PrioQueue, Options...> backward_;
+    };
+
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    ch_query<PrioQueue, Options...>::ch_query
+        (contraction_hierarchy const& ch) :
+        ch_       (&ch),
+        forward_  (ch.rank.size()),
+        backward_ (ch.rank.size())
+    {
+    }
+
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto ch_query<PrioQueue, Options...>::find_point_to_point
+        (id_t const from, id_t const to) -> path_t
+    {
+        forward_.reset();
+        backward_.reset();
+        forward_.relax(from, 0);
+        backward_.relax(to, 0);
+
+        auto best = dijkstra_max_dist();
+
+        for (;;)
+        {
+            auto const forwardMin  = forward_.min_dist();
+            auto const backwardMin = backward_.min_dist();
+
+            if (std::min(forwardMin, backwardMin) >= best)
+            {
+                break;
+            }
+
+            auto const isForward = forwardMin <= backwardMin;
+            auto& state          = isForward ? forward_ : backward_;
+            auto& other          = isForward ? backward_ : forward_;
+            auto const& offsets  = isForward ? ch_->upOffsets : ch_->downOffsets;
+            auto const& edges    = isForward ? ch_->upEdges : ch_->downEdges;
+            auto const current   = state.pop();
+
+            if (dijkstra_max_dist() != other.dist(current.id))
+            {
+                best = std::min(best, current.dist + other.dist(current.id));
+            }
+
+            for (auto i = offsets[current.id]; i < offsets[current.id + 1]; ++i)
+            {
+                state.relax(edges[i].target, current.dist + edges[i].cost);
+            }
+        }
+
+        return dijkstra_max_dist() == best ? path_t {0, 0, dijkstra_max_dist()}
+                                           : path_t {from, to, best};
+    }
+}
+
+#endif
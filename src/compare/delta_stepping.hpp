@@ -0,0 +1,228 @@
+#ifndef MIX_DS_DELTA_STEPPING_HPP
+#define MIX_DS_DELTA_STEPPING_HPP
+
+#include "dijkstra.hpp"
+#include "../utils/parallel.hpp"
+
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+namespace mix::ds
+{
+    namespace delta_impl
+    {
+        using bucket_t  = std::vector<id_t>;
+        using buckets_t = std::vector<bucket_t>;
+
+        /**
+            Lowers @p target to @p d if @p d is smaller.
+            @return true if the value was lowered.
+         */
+        inline auto atomic_min
+            (std::atomic<dist_t>& target, dist_t const d) -> bool
+        {
+            auto old = target.load(std::memory_order_relaxed);
+            while (d < old)
+            {
+                if (target.compare_exchange_weak(old, d, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        inline auto push
+            (buckets_t& buckets, std::size_t const bucket, id_t const v) -> void
+        {
+            if (bucket >= buckets.size())
+            {
+                buckets.resize(bucket + 1);
+            }
+            buckets[bucket].emplace_back(v);
+        }
+    }
+
+    /**
+        Parallel single source shortest paths using delta-stepping.
+        Vertices are kept in buckets of width @p delta. The smallest non-empty
+        bucket is emptied in phases that relax light edges (cost <= delta) of all
+        its vertices in parallel until no vertex falls back into it, then heavy edges
+        of the vertices removed from the bucket are relaxed once.
+
+        Each thread owns its own buckets and frontiers are split evenly between threads.
+        Distances are lowered using compare-and-swap so no locks are needed.
+
+        Small delta makes the algorithm behave like Dijkstra (little parallelism),
+        big delta like Bellman-Ford (much redundant work). Maximal edge cost divided
+        by average degree is a reasonable first guess.
+
+        @return distances from @p from to all vertices,
+                dijkstra_max_dist() for unreachable vertices.
+        @throws std::invalid_argument if @p delta or @p threadCount is 0.
+     */
+    inline auto find_point_to_all_delta
+        ( graph_t const&    g
+        , id_t const        from
+        , dist_t const      delta
+        , std::size_t const threadCount = utils::default_thread_count() ) -> std::vector<dist_t>
+    {
+        using namespace delta_impl;
+
+        if (delta < 1)
+        {
+            throw std::invalid_argument("Delta must be positive.");
+        }
+
+        if (threadCount < 1)
+        {
+            throw std::invalid_argument("Thread count must be positive.");
+        }
+
+        auto const n = g.vertices.size();
+
+        auto dists      = std::unique_ptr<std::atomic<dist_t>[]>(new std::atomic<dist_t>[n]);
+        auto lightMarks = std::unique_ptr<std::atomic<std::size_t>[]>(new std::atomic<std::size_t>[n]);
+        auto heavyMarks = std::unique_ptr<std::atomic<std::size_t>[]>(new std::atomic<std::size_t>[n]);
+        for (auto v = 0ul; v < n; ++v)
+        {
+            dists[v].store(dijkstra_max_dist(), std::memory_order_relaxed);
+            lightMarks[v].store(0, std::memory_order_relaxed);
+            heavyMarks[v].store(0, std::memory_order_relaxed);
+        }
+
+        auto buckets  = std::vector<buckets_t>(threadCount);
+        auto frontier = std::vector<bucket_t>(threadCount);
+        auto removed  = std::vector<bucket_t>(threadCount);
+        auto barrier  = utils::spin_barrier(threadCount);
+        auto current  = std::size_t {0};
+        auto isDone   = false;
+
+        dists[from].store(0, std::memory_order_relaxed);
+        push(buckets[0], 0, from);
+
+        auto const bucket_of = [delta](dist_t const d)
+        {
+            return static_cast<std::size_t>(d / delta);
+        };
+
+        // Light edges lead to the current or the next bucket,
+        // heavy edges to any bucket after the current one.
+        auto const relax = [&](std::size_t const t, id_t const u, bool const light)
+        {
+            auto const du = dists[u].load(std::memory_order_relaxed);
+            for (auto const e : g.vertices[u].forward)
+            {
+                if ((e.cost <= delta) == light && atomic_min(dists[e.target], du + e.cost))
+                {
+                    push(buckets[t], bucket_of(du + e.cost), e.target);
+                }
+            }
+        };
+
+        utils::run_on_threads(threadCount, [&](std::size_t const t)
+        {
+            auto phase = std::size_t {0};
+
+            for (;;)
+            {
+                barrier.wait();
+                if (isDone)
+                {
+                    return;
+                }
+
+                for (;;)
+                {
+                    ++phase;
+                    frontier[t].clear();
+                    if (current < buckets[t].size())
+                    {
+                        frontier[t].swap(buckets[t][current]);
+                    }
+                    barrier.wait();
+
+                    // Every thread takes the same share of all frontiers.
+                    auto total = 0ul;
+                    for (auto const& f : frontier)
+                    {
+                        total += f.size();
+                    }
+
+                    if (0 == total)
+                    {
+                        break;
+                    }
+
+                    auto const first = total * t / threadCount;
+                    auto const last  = total * (t + 1) / threadCount;
+                    auto offset      = 0ul;
+                    for (auto const& f : frontier)
+                    {
+                        auto const lo = std::max(first, offset);
+                        auto const hi = std::min(last, offset + f.size());
+                        for (auto i = lo; i < hi; ++i)
+                        {
+                            auto const u = f[i - offset];
+                            auto const isStale = bucket_of(dists[u].load(std::memory_order_relaxed)) != current;
+                            if (isStale || phase == lightMarks[u].exchange(phase, std::memory_order_relaxed))
+                            {
+                                continue;
+                            }
+                            removed[t].emplace_back(u);
+                            relax(t, u, true);
+                        }
+                        offset += f.size();
+                    }
+
+                    barrier.wait();
+                }
+
+                for (auto const u : removed[t])
+                {
+                    if (current + 1 != heavyMarks[u].exchange(current + 1, std::memory_order_relaxed))
+                    {
+                        relax(t, u, false);
+                    }
+                }
+                removed[t].clear();
+
+                barrier.wait();
+                if (0 == t)
+                {
+                    // Find next non-empty bucket. Stale entries are skipped later.
+                    auto maxBucket = 0ul;
+                    for (auto const& bs : buckets)
+                    {
+                        maxBucket = std::max(maxBucket, bs.size());
+                    }
+
+                    isDone = true;
+                    for (auto b = current + 1; b < maxBucket && isDone; ++b)
+                    {
+                        for (auto const& bs : buckets)
+                        {
+                            if (b < bs.size() && !bs[b].empty())
+                            {
+                                current = b;
+                                isDone  = false;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        });
+
+        auto result = std::vector<dist_t>(n);
+        for (auto v = 0ul; v < n; ++v)
+        {
+            result[v] = dists[v].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+}
+
+#endif
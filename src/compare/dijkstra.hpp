@@ -7,11 +7,15 @@
 #include <fstream>
 #include <algorithm>
 #include <any>
+#include <optional>
+#include <limits>
+#include <stdexcept>
 
 namespace mix::ds
 {
-    using dist_t  = std::int64_t;
-    using id_t    = std::uint64_t;
+    using dist_t   = std::int64_t;
+    using id_t     = std::uint64_t;
+    using parent_t = std::uint32_t;
 
     struct edge
     {
@@ -25,15 +29,20 @@ namespace mix::ds
     {
         id_t     id;
         dist_t   distAprox;
-        vertex*  prev;
         edges_t  forward;
         std::any handle;
         bool     isInQueue;
     };
 
+    /**
+        Vertices of the graph and the shortest path tree of the last search.
+        parents[v] is the id of the predecessor of v, parents are kept
+        apart from vertices so that walking a path touches only this array.
+     */
     struct graph_t
     {
-        std::vector<vertex> vertices;
+        std::vector<vertex>   vertices;
+        std::vector<parent_t> parents {};
     };
 
     struct path_t
@@ -43,6 +52,16 @@ namespace mix::ds
         dist_t cost;
     };
     
+    /**
+        Vertices and edges of a path, edges[i] leads from vertices[i] to vertices[i + 1].
+     */
+    struct route_t
+    {
+        std::vector<id_t> vertices;
+        edges_t           edges;
+        dist_t            cost;
+    };
+
     struct road_graph_header
     {
         std::size_t vertexCount;
@@ -56,6 +75,36 @@ namespace mix::ds
         {
             return lhs->distAprox < rhs->distAprox;      
         }
+
+        static auto key
+            (vertex* const v) -> dist_t
+        {
+            return v->distAprox;
+        }
+    };
+
+    /**
+        Queue element for searches that keep distances outside of the graph.
+     */
+    struct queue_entry
+    {
+        dist_t dist;
+        id_t   id;
+    };
+
+    struct queue_entry_compare
+    {
+        auto operator()
+            (queue_entry const& lhs, queue_entry const& rhs) const
+        {
+            return lhs.dist < rhs.dist;
+        }
+
+        static auto key
+            (queue_entry const& e) -> dist_t
+        {
+            return e.dist;
+        }
     };
 
     inline auto to_words (std::string s)
@@ -132,35 +181,176 @@ namespace mix::ds
         auto vertices = std::vector<vertex>(header.vertexCount);
         std::generate(begin(vertices), end(vertices), [i = 0ul]() mutable { return vertex {i++}; });
 
-        auto line = parse_line(eat_comments(fstr));
-        for (auto i = 0ul; i < header.vertexCount - 1; ++i)
+        auto line = eat_comments(fstr);
+        for (auto i = 0ul; i < header.edgeCount; ++i)
         {
-            vertices[line.from].forward.emplace_back(edge {line.cost, line.to});
-            line = parse_line(read_line(fstr));
+            auto const arc = parse_line(0 == i ? std::move(line) : read_line(fstr));
+            vertices[arc.from].forward.emplace_back(edge {arc.cost, arc.to});
         }
 
         return graph_t {vertices};
     }
 
+    /**
+        @return new graph with the same vertices and all edges reversed.
+     */
+    inline auto reverse_graph
+        (graph_t const& g) -> graph_t
+    {
+        auto vertices = std::vector<vertex>(g.vertices.size());
+        std::generate(begin(vertices), end(vertices), [i = 0ul]() mutable
+        {
+            return vertex {i++, 0, edges_t(), std::any(), false};
+        });
+
+        for (auto const& v : g.vertices)
+        {
+            for (auto const e : v.forward)
+            {
+                vertices[e.target].forward.emplace_back(edge {e.cost, v.id});
+            }
+        }
+
+        return graph_t {std::move(vertices)};
+    }
+
     inline auto constexpr dijkstra_max_dist
         () -> dist_t
     {
         return std::numeric_limits<dist_t>::max() / 2;
     }
 
+    /**
+        Parent of the source of a search and of unreached vertices.
+     */
+    inline auto constexpr no_parent
+        () -> parent_t
+    {
+        return std::numeric_limits<parent_t>::max();
+    }
+
+    /**
+        Clears the shortest path tree before a new search.
+        @throws std::length_error if vertex ids do not fit into parent_t.
+     */
+    inline auto reset_parents
+        (graph_t& vs) -> void
+    {
+        if (vs.vertices.size() > no_parent())
+        {
+            throw std::length_error("Graph has too many vertices for parent_t.");
+        }
+
+        vs.parents.assign(vs.vertices.size(), no_parent());
+    }
+
+    /**
+        @return shortest path tree of the last search on @p vs as parent ids,
+                no_parent() for the source and for unreached vertices.
+     */
+    inline auto shortest_path_tree
+        (graph_t const& vs) -> std::vector<parent_t> const&
+    {
+        return vs.parents;
+    }
+
+    /**
+        Reconstructs the path from the source of the last search to @p to
+        by walking the shortest path tree. Only parents are read while walking,
+        vertices are touched once each to look the edges up.
+        @return route with no vertices and dijkstra_max_dist() cost
+                if @p to was not reached.
+     */
+    inline auto extract_path
+        (graph_t const& vs, id_t const to) -> route_t
+    {
+        auto route = route_t {{}, {}, 0};
+
+        if (vs.parents.size() <= to)
+        {
+            return route_t {{}, {}, dijkstra_max_dist()};
+        }
+
+        for (auto v = to; ; v = vs.parents[v])
+        {
+            route.vertices.emplace_back(v);
+            if (no_parent() == vs.parents[v])
+            {
+                break;
+            }
+        }
+        std::reverse(std::begin(route.vertices), std::end(route.vertices));
+
+        if (1 == route.vertices.size() && dijkstra_max_dist() == vs.vertices[to].distAprox)
+        {
+            return route_t {{}, {}, dijkstra_max_dist()};
+        }
+
+        route.edges.reserve(route.vertices.size() - 1);
+        for (auto i = 1ul; i < route.vertices.size(); ++i)
+        {
+            // Relaxation keeps the cheapest of parallel edges.
+            auto const& forward = vs.vertices[route.vertices[i - 1]].forward;
+            auto const target   = route.vertices[i];
+            auto best           = edge {dijkstra_max_dist(), target};
+            for (auto const e : forward)
+            {
+                if (e.target == target && e.cost < best.cost)
+                {
+                    best = e;
+                }
+            }
+            route.edges.emplace_back(best);
+            route.cost += best.cost;
+        }
+
+        return route;
+    }
+
+    /**
+        Distances and queue handles of a single Dijkstra search that keeps
+        its state outside of the graph. Only touched vertices are reset
+        between searches so the state can be reused for many small searches
+        on a big graph.
+     */
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    class search_state
+    {
+    public:
+        using queue_t  = PrioQueue<queue_entry, queue_entry_compare, Options...>;
+        using handle_t = typename queue_t::handle_t;
+
+    public:
+        search_state (std::size_t const vertexCount);
+
+        auto reset    ()                             -> void;
+        auto relax    (id_t const v, dist_t const d) -> bool;
+        auto pop      ()                             -> queue_entry;
+        auto dist     (id_t const v) const           -> dist_t;
+        auto min_dist () const                       -> dist_t;
+        auto empty    () const                       -> bool;
+        auto touched  () const                       -> std::vector<id_t> const&;
+
+    private:
+        queue_t                              queue_;
+        std::vector<dist_t>                  dists_;
+        std::vector<std::optional<handle_t>> handles_;
+        std::vector<id_t>                    touched_;
+    };
+
     template<template<class, class, class...> class PrioQueue, class... Options>
     auto find_point_to_all
         (graph_t& vs, id_t const from)
     {
-        using queue_t  = PrioQueue<vertex*, vertex_ptr_compare>;
+        using queue_t  = PrioQueue<vertex*, vertex_ptr_compare, Options...>;
         using handle_t = typename queue_t::handle_t;
 
         auto queue = queue_t();
 
+        reset_parents(vs);
         for (auto& v : vs.vertices)
         {
             v.distAprox = dijkstra_max_dist();
-            v.prev      = nullptr;
             v.isInQueue = false;
         }
         vs.vertices[from].distAprox = 0;
@@ -178,7 +368,7 @@ namespace mix::ds
                 if (current->distAprox + edge.cost < target->distAprox)
                 {
                     target->distAprox = current->distAprox + edge.cost;
-                    target->prev      = current;
+                    vs.parents[edge.target] = static_cast<parent_t>(current->id);
 
                     if (target->isInQueue)
                     {
@@ -198,15 +388,15 @@ namespace mix::ds
     auto find_point_to_point
         (graph_t& vs, id_t const from, id_t const to)
     {
-        using queue_t  = PrioQueue<vertex*, vertex_ptr_compare>;
+        using queue_t  = PrioQueue<vertex*, vertex_ptr_compare, Options...>;
         using handle_t = typename queue_t::handle_t;
 
         auto queue = queue_t();
 
+        reset_parents(vs);
         for (auto& v : vs.vertices)
         {
             v.distAprox = dijkstra_max_dist();
-            v.prev      = nullptr;
             v.isInQueue = false;
         }
         vs.vertices[from].distAprox = 0;
@@ -229,7 +419,7 @@ namespace mix::ds
                 if (current->distAprox + edge.cost < target->distAprox)
                 {
                     target->distAprox = current->distAprox + edge.cost;
-                    target->prev      = current;
+                    vs.parents[edge.target] = static_cast<parent_t>(current->id);
 
                     if (target->isInQueue)
                     {
@@ -246,6 +436,194 @@ namespace mix::ds
 
         return path_t {0, 0, dijkstra_max_dist()};
     }
+
+    /**
+        Dijkstra without decrease_key. An improved vertex is inserted again
+        and outdated queue entries are skipped when popped. Works with any queue
+        providing insert, find_min, delete_min and empty, no handles are needed.
+     */
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto find_point_to_all_lazy
+        (graph_t& vs, id_t const from)
+    {
+        using queue_t = PrioQueue<queue_entry, queue_entry_compare, Options...>;
+
+        auto queue = queue_t();
+
+        reset_parents(vs);
+        for (auto& v : vs.vertices)
+        {
+            v.distAprox = dijkstra_max_dist();
+        }
+        vs.vertices[from].distAprox = 0;
+        queue.insert(queue_entry {0, from});
+
+        while (!queue.empty())
+        {
+            auto const [dist, id] = queue.find_min();
+            queue.delete_min();
+
+            auto const current = &vs.vertices[id];
+            if (dist > current->distAprox)
+            {
+                continue;
+            }
+
+            for (auto const edge : current->forward)
+            {
+                auto const target = &vs.vertices[edge.target];
+                if (dist + edge.cost < target->distAprox)
+                {
+                    target->distAprox = dist + edge.cost;
+                    vs.parents[edge.target] = static_cast<parent_t>(id);
+                    queue.insert(queue_entry {target->distAprox, edge.target});
+                }
+            }
+        }
+    }
+
+    /**
+        Point to point version of find_point_to_all_lazy.
+     */
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto find_point_to_point_lazy
+        (graph_t& vs, id_t const from, id_t const to)
+    {
+        using queue_t = PrioQueue<queue_entry, queue_entry_compare, Options...>;
+
+        auto queue = queue_t();
+
+        reset_parents(vs);
+        for (auto& v : vs.vertices)
+        {
+            v.distAprox = dijkstra_max_dist();
+        }
+        vs.vertices[from].distAprox = 0;
+        queue.insert(queue_entry {0, from});
+
+        while (!queue.empty())
+        {
+            auto const [dist, id] = queue.find_min();
+            queue.delete_min();
+
+            auto const current = &vs.vertices[id];
+            if (dist > current->distAprox)
+            {
+                continue;
+            }
+
+            if (id == to)
+            {
+                return path_t {from, to, dist};
+            }
+
+            for (auto const edge : current->forward)
+            {
+                auto const target = &vs.vertices[edge.target];
+                if (dist + edge.cost < target->distAprox)
+                {
+                    target->distAprox = dist + edge.cost;
+                    vs.parents[edge.target] = static_cast<parent_t>(id);
+                    queue.insert(queue_entry {target->distAprox, edge.target});
+                }
+            }
+        }
+
+        return path_t {0, 0, dijkstra_max_dist()};
+    }
+
+// search_state definition:
+
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    search_state<PrioQueue, Options...>::search_state
+        (std::size_t const vertexCount) :
+        dists_   (vertexCount, dijkstra_max_dist()),
+        handles_ (vertexCount)
+    {
+    }
+
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto search_state<PrioQueue, Options...>::reset
+        () -> void
+    {
+        for (auto const v : touched_)
+        {
+            dists_[v] = dijkstra_max_dist();
+            handles_[v].reset();
+        }
+        touched_.clear();
+
+        if (!queue_.empty())
+        {
+            queue_.clear();
+        }
+    }
+
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto search_state<PrioQueue, Options...>::relax
+        (id_t const v, dist_t const d) -> bool
+    {
+        if (d >= dists_[v])
+        {
+            return false;
+        }
+
+        if (dijkstra_max_dist() == dists_[v])
+        {
+            touched_.emplace_back(v);
+        }
+        dists_[v] = d;
+
+        if (handles_[v])
+        {
+            (**handles_[v]).dist = d;
+            queue_.decrease_key(*handles_[v]);
+        }
+        else
+        {
+            handles_[v] = queue_.insert(queue_entry {d, v});
+        }
+
+        return true;
+    }
+
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto search_state<PrioQueue, Options...>::pop
+        () -> queue_entry
+    {
+        auto const entry = queue_.find_min();
+        queue_.delete_min();
+        handles_[entry.id].reset();
+        return entry;
+    }
+
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto search_state<PrioQueue, Options...>::dist
+        (id_t const v) const -> dist_t
+    {
+        return dists_[v];
+    }
+
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto search_state<PrioQueue, Options...>::min_dist
+        () const -> dist_t
+    {
+        return queue_.empty() ? dijkstra_max_dist() : queue_.find_min().dist;
+    }
+
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto search_state<PrioQueue, Options...>::empty
+        () const -> bool
+    {
+        return queue_.empty();
+    }
+
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto search_state<PrioQueue, Options...>::touched
+        () const -> std::vector<id_t> const&
+    {
+        return touched_;
+    }
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef MIX_DS_DISTANCE_TABLE_HPP
+#define MIX_DS_DISTANCE_TABLE_HPP
+
+#include "dijkstra.hpp"
+#include "../utils/parallel.hpp"
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+namespace mix::ds
+{
+    /**
+        Computes distances from each of @p sources to each of @p targets.
+        Runs one Dijkstra search per source that stops as soon as all targets
+        are settled. Sources are distributed dynamically between threads and each
+        thread reuses its search_state so only touched vertices are reset
+        between searches.
+
+        @return row-major table where element [i * targets.size() + j]
+                is the distance from sources[i] to targets[j],
+                dijkstra_max_dist() if the target is unreachable.
+        @throws std::invalid_argument if @p threadCount is 0.
+     */
+    template<template<class, class, class...> class PrioQueue, class... Options>
+    auto distance_table
+        ( graph_t const&           g
+        , std::vector<id_t> const& sources
+        , std::vector<id_t> const& targets
+        , std::size_t const        threadCount = utils::default_thread_count() ) -> std::vector<dist_t>
+    {
+        auto const n     = g.vertices.size();
+        auto table       = std::vector<dist_t>(sources.size() * targets.size(), dijkstra_max_dist());
+        auto isTarget    = std::vector<bool>(n, false);
+        auto targetCount = std::size_t {0};
+        auto nextSource  = std::atomic<std::size_t> {0};
+
+        if (threadCount < 1)
+        {
+            throw std::invalid_argument("Thread count must be positive.");
+        }
+
+        if (sources.empty() || targets.empty())
+        {
+            return table;
+        }
+
+        for (auto const t : targets)
+        {
+            if (!isTarget[t])
+            {
+                isTarget[t] = true;
+                ++targetCount;
+            }
+        }
+
+        utils::run_on_threads(std::min(threadCount, sources.size()), [&](std::size_t)
+        {
+            auto state = search_state<PrioQueue, Options...>(n);
+
+            for (;;)
+            {
+                auto const i = nextSource.fetch_add(1, std::memory_order_relaxed);
+                if (i >= sources.size())
+                {
+                    return;
+                }
+
+                auto targetsLeft = targetCount;
+                state.reset();
+                state.relax(sources[i], 0);
+
+                while (!state.empty() && targetsLeft > 0)
+                {
+                    auto const [d, u] = state.pop();
+
+                    if (isTarget[u])
+                    {
+                        --targetsLeft;
+                    }
+
+                    for (auto const e : g.vertices[u].forward)
+                    {
+                        state.relax(e.target, d + e.cost);
+                    }
+                }
+
+                auto const row = table.data() + i * targets.size();
+                for (auto j = 0ul; j < targets.size(); ++j)
+                {
+                    row[j] = state.dist(targets[j]);
+                }
+            }
+        });
+
+        return table;
+    }
+}
+
+#endif
@@ -0,0 +1,265 @@
+#ifndef MIX_DS_GRAPH_GENERATOR_HPP
+#define MIX_DS_GRAPH_GENERATOR_HPP
+
+#include "dijkstra.hpp"
+#include "graph_order.hpp"
+#include "../utils/random_wrap.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <random>
+
+namespace mix::ds
+{
+    namespace generator_impl
+    {
+        /**
+            Side of the square in which random points are generated.
+         */
+        inline auto constexpr PlaneSide = std::int64_t {1} << 24;
+
+        inline auto make_vertices
+            (std::size_t const n) -> std::vector<vertex>
+        {
+            auto vertices = std::vector<vertex>(n);
+            for (auto i = 0ul; i < n; ++i)
+            {
+                vertices[i].id = i;
+            }
+            return vertices;
+        }
+
+        inline auto add_both
+            (std::vector<vertex>& vertices, id_t const u, id_t const v, dist_t const cost) -> void
+        {
+            vertices[u].forward.emplace_back(edge {cost, v});
+            vertices[v].forward.emplace_back(edge {cost, u});
+        }
+    }
+
+    /**
+        Road-like grid graph. Every vertex is connected with its (up to four)
+        neighbours by edges in both directions with the same uniformly
+        distributed cost from [1, maxCost]. Vertex r * cols + c lies at (c, r).
+     */
+    inline auto make_grid_graph
+        ( std::size_t const   rows
+        , std::size_t const   cols
+        , dist_t const        maxCost
+        , unsigned long const seed ) -> graph_t
+    {
+        auto vertices = generator_impl::make_vertices(rows * cols);
+        auto rngCost  = utils::random_uniform_int<dist_t>(1, maxCost, seed);
+
+        for (auto r = 0ul; r < rows; ++r)
+        {
+            for (auto c = 0ul; c < cols; ++c)
+            {
+                auto const v = r * cols + c;
+                if (c + 1 < cols)
+                {
+                    generator_impl::add_both(vertices, v, v + 1, rngCost.next_int());
+                }
+                if (r + 1 < rows)
+                {
+                    generator_impl::add_both(vertices, v, v + cols, rngCost.next_int());
+                }
+            }
+        }
+
+        return graph_t {std::move(vertices)};
+    }
+
+    /**
+        @return coordinates of vertices of a graph created by make_grid_graph.
+     */
+    inline auto grid_coordinates
+        (std::size_t const rows, std::size_t const cols) -> std::vector<coordinate>
+    {
+        auto coords = std::vector<coordinate>(rows * cols);
+        for (auto v = 0ul; v < coords.size(); ++v)
+        {
+            coords[v] = coordinate { static_cast<std::int64_t>(v % cols)
+                                   , static_cast<std::int64_t>(v / cols) };
+        }
+        return coords;
+    }
+
+    /**
+        @return @p n points uniformly distributed in a square.
+     */
+    inline auto make_random_points
+        (std::size_t const n, unsigned long const seed) -> std::vector<coordinate>
+    {
+        auto rng    = utils::random_uniform_int<std::int64_t>(0, generator_impl::PlaneSide - 1, seed);
+        auto points = std::vector<coordinate>(n);
+        for (auto& p : points)
+        {
+            p.x = rng.next_int();
+            p.y = rng.next_int();
+        }
+        return points;
+    }
+
+    /**
+        Random geometric graph. Two points are connected in both directions
+        if they are closer than a radius that gives @p avgDegree neighbours on average
+        for uniformly distributed points. Cost of an edge is the rounded euclidean
+        distance. Points are bucketed into cells of the radius size so only
+        neighbouring cells are compared.
+     */
+    inline auto make_geometric_graph
+        (std::vector<coordinate> const& points, double const avgDegree) -> graph_t
+    {
+        auto constexpr Pi = 3.14159265358979323846;
+        auto const n      = points.size();
+        auto vertices     = generator_impl::make_vertices(n);
+
+        if (n < 2)
+        {
+            return graph_t {std::move(vertices)};
+        }
+
+        auto minX = points[0].x;
+        auto minY = points[0].y;
+        auto maxX = points[0].x;
+        auto maxY = points[0].y;
+        for (auto const p : points)
+        {
+            minX = std::min(minX, p.x);
+            minY = std::min(minY, p.y);
+            maxX = std::max(maxX, p.x);
+            maxY = std::max(maxY, p.y);
+        }
+
+        auto const area   = static_cast<double>(maxX - minX + 1) * static_cast<double>(maxY - minY + 1);
+        auto const radius = std::max(1.0, std::sqrt(avgDegree * area / (Pi * n)));
+        auto const cols   = static_cast<std::size_t>((maxX - minX) / radius) + 1;
+        auto const rows   = static_cast<std::size_t>((maxY - minY) / radius) + 1;
+        auto const cellOf = [&](coordinate const p)
+        {
+            auto const c = static_cast<std::size_t>((p.x - minX) / radius);
+            auto const r = static_cast<std::size_t>((p.y - minY) / radius);
+            return std::make_pair(r, c);
+        };
+
+        // Counting sort of points by cell.
+        auto cellStart = std::vector<std::size_t>(rows * cols + 1, 0);
+        auto byCell    = std::vector<id_t>(n);
+        for (auto const p : points)
+        {
+            auto const [r, c] = cellOf(p);
+            ++cellStart[r * cols + c + 1];
+        }
+        for (auto i = 1ul; i < cellStart.size(); ++i)
+        {
+            cellStart[i] += cellStart[i - 1];
+        }
+        auto fill = std::vector<std::size_t>(std::begin(cellStart), std::end(cellStart) - 1);
+        for (auto v = 0ul; v < n; ++v)
+        {
+            auto const [r, c] = cellOf(points[v]);
+            byCell[fill[r * cols + c]++] = v;
+        }
+
+        auto const radiusSq = radius * radius;
+        for (auto u = 0ul; u < n; ++u)
+        {
+            auto const [r, c] = cellOf(points[u]);
+            for (auto nr = r > 0 ? r - 1 : r; nr <= std::min(r + 1, rows - 1); ++nr)
+            {
+                for (auto nc = c > 0 ? c - 1 : c; nc <= std::min(c + 1, cols - 1); ++nc)
+                {
+                    auto const cell = nr * cols + nc;
+                    for (auto i = cellStart[cell]; i < cellStart[cell + 1]; ++i)
+                    {
+                        auto const v = byCell[i];
+                        if (v <= u)
+                        {
+                            continue;
+                        }
+
+                        auto const dx = static_cast<double>(points[u].x - points[v].x);
+                        auto const dy = static_cast<double>(points[u].y - points[v].y);
+                        auto const sq = dx * dx + dy * dy;
+                        if (sq < radiusSq)
+                        {
+                            auto const cost = std::max(dist_t {1}, static_cast<dist_t>(std::llround(std::sqrt(sq))));
+                            generator_impl::add_both(vertices, u, v, cost);
+                        }
+                    }
+                }
+            }
+        }
+
+        return graph_t {std::move(vertices)};
+    }
+
+    /**
+        Power-law graph created by preferential attachment (Barabasi-Albert).
+        Every new vertex is connected to @p edgesPerVertex distinct older vertices
+        chosen with probability proportional to their degree. Edges go in both
+        directions and have uniformly distributed cost from [1, maxCost].
+     */
+    inline auto make_power_law_graph
+        ( std::size_t const   n
+        , std::size_t const   edgesPerVertex
+        , dist_t const        maxCost
+        , unsigned long const seed ) -> graph_t
+    {
+        if (0 == edgesPerVertex)
+        {
+            throw std::invalid_argument("Vertices must have at least one edge.");
+        }
+
+        auto vertices  = generator_impl::make_vertices(n);
+        auto rngSeed   = utils::random_uniform_int<unsigned long>(seed);
+        auto rngCost   = utils::random_uniform_int<dist_t>(1, maxCost, rngSeed.next_int());
+        auto generator = std::mt19937_64(rngSeed.next_int());
+        auto core      = std::min(n, edgesPerVertex + 1);
+
+        // Every endpoint of every edge is listed once, so uniform choice
+        // from this list is a choice proportional to the degree.
+        auto endpoints = std::vector<id_t>();
+        endpoints.reserve(2 * n * edgesPerVertex);
+
+        for (auto u = 0ul; u < core; ++u)
+        {
+            for (auto v = u + 1; v < core; ++v)
+            {
+                generator_impl::add_both(vertices, u, v, rngCost.next_int());
+                endpoints.emplace_back(u);
+                endpoints.emplace_back(v);
+            }
+        }
+
+        auto targets = std::vector<id_t>();
+        for (auto u = core; u < n; ++u)
+        {
+            targets.clear();
+            while (targets.size() < edgesPerVertex)
+            {
+                auto pick    = std::uniform_int_distribution<std::size_t>(0, endpoints.size() - 1);
+                auto const v = endpoints[pick(generator)];
+                if (std::find(std::begin(targets), std::end(targets), v) == std::end(targets))
+                {
+                    targets.emplace_back(v);
+                }
+            }
+
+            for (auto const v : targets)
+            {
+                generator_impl::add_both(vertices, u, v, rngCost.next_int());
+                endpoints.emplace_back(u);
+                endpoints.emplace_back(v);
+            }
+        }
+
+        return graph_t {std::move(vertices)};
+    }
+}
+
+#endif
@@ -0,0 +1,305 @@
+#ifndef MIX_DS_GRAPH_ORDER_HPP
+#define MIX_DS_GRAPH_ORDER_HPP
+
+#include "dijkstra.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <limits>
+
+namespace mix::ds
+{
+    /**
+        Vertex coordinates as stored in DIMACS .co files.
+     */
+    struct coordinate
+    {
+        std::int64_t x;
+        std::int64_t y;
+    };
+
+    /**
+        Bijection between vertex ids of the original and of the reordered graph.
+        newToOld[i] is the original id of the vertex that has id i after reordering.
+     */
+    struct vertex_order
+    {
+        std::vector<id_t> newToOld;
+        std::vector<id_t> oldToNew;
+    };
+
+    namespace order_impl
+    {
+        inline auto constexpr HilbertBits = 16u;
+
+        /**
+            Position of the point (x, y) on the Hilbert curve
+            that fills the 2^HilbertBits x 2^HilbertBits grid.
+         */
+        inline auto hilbert_index
+            (std::uint32_t x, std::uint32_t y) -> std::uint64_t
+        {
+            auto constexpr N = std::uint32_t {1} << HilbertBits;
+            auto d = std::uint64_t {0};
+
+            for (auto s = N / 2; s > 0; s /= 2)
+            {
+                auto const rx = (x & s) ? 1u : 0u;
+                auto const ry = (y & s) ? 1u : 0u;
+                d += std::uint64_t {s} * s * ((3 * rx) ^ ry);
+
+                if (0 == ry)
+                {
+                    if (1 == rx)
+                    {
+                        x = N - 1 - x;
+                        y = N - 1 - y;
+                    }
+                    std::swap(x, y);
+                }
+            }
+
+            return d;
+        }
+
+        /**
+            Neighbours of each vertex regardless of the edge direction.
+         */
+        inline auto undirected_adjacency
+            (graph_t const& g) -> std::vector<std::vector<id_t>>
+        {
+            auto adjacency = std::vector<std::vector<id_t>>(g.vertices.size());
+
+            for (auto const& v : g.vertices)
+            {
+                for (auto const e : v.forward)
+                {
+                    adjacency[v.id].emplace_back(e.target);
+                    adjacency[e.target].emplace_back(v.id);
+                }
+            }
+
+            for (auto& ns : adjacency)
+            {
+                std::sort(std::begin(ns), std::end(ns));
+                ns.erase(std::unique(std::begin(ns), std::end(ns)), std::end(ns));
+            }
+
+            return adjacency;
+        }
+    }
+
+    /**
+        Creates vertex_order from the new-to-old mapping.
+     */
+    inline auto make_vertex_order
+        (std::vector<id_t> newToOld) -> vertex_order
+    {
+        auto oldToNew = std::vector<id_t>(newToOld.size());
+
+        for (auto i = 0ul; i < newToOld.size(); ++i)
+        {
+            oldToNew[newToOld[i]] = i;
+        }
+
+        return vertex_order {std::move(newToOld), std::move(oldToNew)};
+    }
+
+    /**
+        Cuthill-McKee order. Vertices are numbered in breadth-first order,
+        neighbours of a vertex in increasing order of their degree. Each component
+        is started from its vertex with the smallest degree. Edge directions
+        are ignored so that the order works for asymmetric graphs as well.
+     */
+    inline auto cuthill_mckee_order
+        (graph_t const& g) -> vertex_order
+    {
+        auto const n         = g.vertices.size();
+        auto const adjacency = order_impl::undirected_adjacency(g);
+        auto const degree    = [&adjacency](id_t const v) { return adjacency[v].size(); };
+        auto byDegree        = std::vector<id_t>(n);
+        auto isVisited       = std::vector<bool>(n, false);
+        auto newToOld        = std::vector<id_t>();
+        newToOld.reserve(n);
+
+        std::iota(std::begin(byDegree), std::end(byDegree), id_t {0});
+        std::stable_sort(std::begin(byDegree), std::end(byDegree), [&](auto const l, auto const r)
+        {
+            return degree(l) < degree(r);
+        });
+
+        auto neighbours = std::vector<id_t>();
+        for (auto const start : byDegree)
+        {
+            if (isVisited[start])
+            {
+                continue;
+            }
+
+            // newToOld itself serves as the queue of the search.
+            auto head = newToOld.size();
+            isVisited[start] = true;
+            newToOld.emplace_back(start);
+
+            while (head < newToOld.size())
+            {
+                auto const v = newToOld[head++];
+
+                neighbours.clear();
+                for (auto const u : adjacency[v])
+                {
+                    if (!isVisited[u])
+                    {
+                        isVisited[u] = true;
+                        neighbours.emplace_back(u);
+                    }
+                }
+
+                std::stable_sort(std::begin(neighbours), std::end(neighbours), [&](auto const l, auto const r)
+                {
+                    return degree(l) < degree(r);
+                });
+                newToOld.insert(std::end(newToOld), std::begin(neighbours), std::end(neighbours));
+            }
+        }
+
+        return make_vertex_order(std::move(newToOld));
+    }
+
+    /**
+        Orders vertices along the Hilbert curve laid over their coordinates,
+        so that vertices close in the plane get close ids.
+     */
+    inline auto hilbert_order
+        (std::vector<coordinate> const& coords) -> vertex_order
+    {
+        using order_impl::HilbertBits;
+
+        if (coords.empty())
+        {
+            return make_vertex_order({});
+        }
+
+        auto const n = coords.size();
+        auto keys    = std::vector<std::uint64_t>(n);
+        auto minX    = std::numeric_limits<std::int64_t>::max();
+        auto minY    = std::numeric_limits<std::int64_t>::max();
+        auto maxX    = std::numeric_limits<std::int64_t>::min();
+        auto maxY    = std::numeric_limits<std::int64_t>::min();
+
+        for (auto const c : coords)
+        {
+            minX = std::min(minX, c.x);
+            minY = std::min(minY, c.y);
+            maxX = std::max(maxX, c.x);
+            maxY = std::max(maxY, c.y);
+        }
+
+        auto const span  = std::max({maxX - minX, maxY - minY, std::int64_t {1}});
+        auto const scale = [span](std::int64_t const offset)
+        {
+            auto const cells = (std::int64_t {1} << HilbertBits) - 1;
+            return static_cast<std::uint32_t>(static_cast<double>(offset) / span * cells);
+        };
+
+        for (auto v = 0ul; v < n; ++v)
+        {
+            keys[v] = order_impl::hilbert_index(scale(coords[v].x - minX), scale(coords[v].y - minY));
+        }
+
+        auto newToOld = std::vector<id_t>(n);
+        std::iota(std::begin(newToOld), std::end(newToOld), id_t {0});
+        std::stable_sort(std::begin(newToOld), std::end(newToOld), [&keys](auto const l, auto const r)
+        {
+            return keys[l] < keys[r];
+        });
+
+        return make_vertex_order(std::move(newToOld));
+    }
+
+    /**
+        @return new graph where vertex i is the vertex order.newToOld[i] of @p g.
+        Edges of each vertex are sorted by target so that relaxations
+        sweep memory in one direction.
+     */
+    inline auto permute_graph
+        (graph_t const& g, vertex_order const& order) -> graph_t
+    {
+        auto vertices = std::vector<vertex>(g.vertices.size());
+
+        for (auto i = 0ul; i < vertices.size(); ++i)
+        {
+            auto& v = vertices[i];
+            v.id    = i;
+            v.forward.reserve(g.vertices[order.newToOld[i]].forward.size());
+
+            for (auto const e : g.vertices[order.newToOld[i]].forward)
+            {
+                v.forward.emplace_back(edge {e.cost, order.oldToNew[e.target]});
+            }
+
+            std::sort(std::begin(v.forward), std::end(v.forward), [](auto const& l, auto const& r)
+            {
+                return l.target < r.target;
+            });
+        }
+
+        return graph_t {std::move(vertices)};
+    }
+
+    /**
+        Translates values indexed by new ids (e.g. distances returned
+        by a search on the permuted graph) back to original ids.
+     */
+    template<class T>
+    auto to_original_order
+        (std::vector<T> const& values, vertex_order const& order) -> std::vector<T>
+    {
+        auto result = std::vector<T>(values.size());
+
+        for (auto i = 0ul; i < values.size(); ++i)
+        {
+            result[order.newToOld[i]] = values[i];
+        }
+
+        return result;
+    }
+
+    /**
+        Loads coordinates from a DIMACS .co file.
+     */
+    inline auto load_road_coordinates
+        (std::string const& filePath) -> std::vector<coordinate>
+    {
+        auto fstr = std::fstream(filePath);
+
+        if (!fstr.is_open())
+        {
+            throw std::runtime_error("Failed to open " + filePath);
+        }
+
+        auto const header = to_words(eat_comments(fstr));
+        auto coords       = std::vector<coordinate>(std::stoull(header[4]));
+
+        auto line = std::string();
+        while (std::getline(fstr, line))
+        {
+            if (line.empty() || 'v' != line[0])
+            {
+                continue;
+            }
+
+            auto const words = to_words(std::move(line));
+            coords.at(std::stoull(words[1]) - 1) = coordinate {std::stoll(words[2]), std::stoll(words[3])};
+        }
+
+        return coords;
+    }
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef MIX_DS_INTRUSIVE_DIJKSTRA_HPP
+#define MIX_DS_INTRUSIVE_DIJKSTRA_HPP
+
+#include "dijkstra.hpp"
+#include "../lib/intrusive_pairing_heap.hpp"
+
+#include <vector>
+
+namespace mix::ds
+{
+    /**
+        Search node of a vertex with an embedded pairing heap hook.
+        Vertex is in the queue iff its dist is finite and it was not settled yet.
+     */
+    struct intrusive_entry : public pairing_hook<>
+    {
+        dist_t dist {dijkstra_max_dist()};
+    };
+
+    struct intrusive_entry_compare
+    {
+        auto operator()
+            (intrusive_entry const& lhs, intrusive_entry const& rhs) const
+        {
+            return lhs.dist < rhs.dist;
+        }
+    };
+
+    namespace intrusive_impl
+    {
+        /**
+            Dijkstra over intrusive_pairing_heap. Search nodes live in one array
+            allocated up front so the queue itself never allocates. Stops when
+            @p to is settled, distances are copied to the vertices at the end.
+         */
+        template<class MergeMode>
+        auto search
+            (graph_t& vs, id_t const from, id_t const to) -> dist_t
+        {
+            using queue_t = intrusive_pairing_heap<intrusive_entry, intrusive_entry_compare, MergeMode>;
+
+            auto queue   = queue_t();
+            auto entries = std::vector<intrusive_entry>(vs.vertices.size());
+            auto result  = dijkstra_max_dist();
+
+            reset_parents(vs);
+            entries[from].dist = 0;
+            queue.insert(entries[from]);
+
+            while (!queue.empty())
+            {
+                auto& current = queue.find_min();
+                queue.delete_min();
+
+                auto const id = static_cast<id_t>(&current - entries.data());
+                if (id == to)
+                {
+                    result = current.dist;
+                    break;
+                }
+
+                for (auto const edge : vs.vertices[id].forward)
+                {
+                    auto& target = entries[edge.target];
+                    if (current.dist + edge.cost < target.dist)
+                    {
+                        // Settled vertex can not be improved so a finite dist means queued.
+                        auto const isInQueue    = dijkstra_max_dist() != target.dist;
+                        target.dist             = current.dist + edge.cost;
+                        vs.parents[edge.target] = static_cast<parent_t>(id);
+
+                        if (isInQueue)
+                        {
+                            queue.decrease_key(target);
+                        }
+                        else
+                        {
+                            queue.insert(target);
+                        }
+                    }
+                }
+            }
+
+            for (auto& v : vs.vertices)
+            {
+                v.distAprox = entries[v.id].dist;
+            }
+
+            return result;
+        }
+    }
+
+    /**
+        Same as find_point_to_all but no node is allocated for queued vertices,
+        they are linked by the hooks of their search nodes.
+     */
+    template<class MergeMode = merge_modes::two_pass>
+    auto find_point_to_all_intrusive
+        (graph_t& vs, id_t const from)
+    {
+        intrusive_impl::search<MergeMode>(vs, from, vs.vertices.size());
+    }
+
+    /**
+        Point to point version of find_point_to_all_intrusive.
+     */
+    template<class MergeMode = merge_modes::two_pass>
+    auto find_point_to_point_intrusive
+        (graph_t& vs, id_t const from, id_t const to)
+    {
+        auto const cost = intrusive_impl::search<MergeMode>(vs, from, to);
+        return dijkstra_max_dist() == cost ? path_t {0, 0, dijkstra_max_dist()}
+                                           : path_t {from, to, cost};
+    }
+}
+
+#endif
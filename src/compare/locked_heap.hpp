@@ -0,0 +1,54 @@
+#ifndef MIX_DS_LOCKED_HEAP_HPP
+#define MIX_DS_LOCKED_HEAP_HPP
+
+#include "../lib/pairing_heap.hpp"
+
+#include <mutex>
+
+namespace mix::ds
+{
+    /**
+        Single pairing_heap behind one mutex. Baseline for the concurrent
+        queues, it has the same interface as multi_queue.
+     */
+    template<class T, class Compare = std::less<T>>
+    class locked_heap
+    {
+    public:
+        auto insert (T const& t) -> void
+        {
+            auto const guard = std::lock_guard<std::mutex>(mutex_);
+            heap_.insert(t);
+        }
+
+        auto try_delete_min (T& out) -> bool
+        {
+            auto const guard = std::lock_guard<std::mutex>(mutex_);
+            if (heap_.empty())
+            {
+                return false;
+            }
+
+            out = heap_.find_min();
+            heap_.delete_min();
+            return true;
+        }
+
+        auto size () -> std::size_t
+        {
+            auto const guard = std::lock_guard<std::mutex>(mutex_);
+            return heap_.size();
+        }
+
+        auto empty () -> bool
+        {
+            return 0 == this->size();
+        }
+
+    private:
+        std::mutex               mutex_;
+        pairing_heap<T, Compare> heap_;
+    };
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef MIX_DS_PLAIN_HEAP_HPP
+#define MIX_DS_PLAIN_HEAP_HPP
+
+#include <queue>
+#include <vector>
+#include <boost/heap/d_ary_heap.hpp>
+
+namespace mix::ds
+{
+    template<class Cmp>
+    struct swapped_compare
+    {
+        template<class T>
+        auto operator() (T const& lhs, T const& rhs) const -> bool
+        {
+            return Cmp () (rhs, lhs);
+        }
+    };
+
+    /**
+        Wrapper of a non-addressable heap (push, top, pop) so that
+        it has the interface needed by the lazy Dijkstra variants.
+        Heap must be a max-heap with respect to swapped_compare<Compare>,
+        so that find_min returns the minimum with respect to Compare.
+     */
+    template<class Heap, class T>
+    class plain_heap
+    {
+    private:
+        Heap heap_;
+
+    public:
+        auto insert (T const& t) -> void
+        {
+            heap_.push(t);
+        }
+
+        auto delete_min () -> void
+        {
+            heap_.pop();
+        }
+
+        auto find_min () const -> T const&
+        {
+            return heap_.top();
+        }
+
+        auto empty () const -> bool
+        {
+            return heap_.empty();
+        }
+
+        auto size () const -> std::size_t
+        {
+            return heap_.size();
+        }
+
+        auto clear () -> void
+        {
+            heap_ = Heap();
+        }
+    };
+
+    template<class T, class Compare>
+    using std_priority_queue = plain_heap< std::priority_queue<T, std::vector<T>, swapped_compare<Compare>>
+                                         , T >;
+
+    template<class T, class Compare>
+    using boost_plain_d_ary_heap = plain_heap< boost::heap::d_ary_heap< T
+                                                                      , boost::heap::arity<4>
+                                                                      , boost::heap::compare<swapped_compare<Compare>> >
+                                             , T >;
+}
+
+#endif
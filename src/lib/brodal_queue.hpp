@@ -2768,8 +2768,10 @@ namespace mix::ds
 
         while (it != end)
         {
-            this->delete_node(it.current());
+            // Move past the node first, the iterator reads its children.
+            auto const node = it.current();
             ++it;
+            this->delete_node(node);
         }
     }
 
@@ -2988,7 +2990,9 @@ namespace mix::ds
     auto brodal_queue<T, Compare, Allocator>::clear
         () -> void
     {
-        *this = brodal_queue {};
+        // Nodes are released by the destructor of the empty queue that shares the allocator.
+        auto empty = brodal_queue(Allocator(nodeAllocator_));
+        this->swap(empty);
     }
 
     template<class T, class Compare, class Allocator>
@@ -0,0 +1,484 @@
+#ifndef MIX_DS_CACHED_KEY_HEAP_HPP
+#define MIX_DS_CACHED_KEY_HEAP_HPP
+
+#include "pairing_heap.hpp"
+#include "fibonacci_heap.hpp"
+
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <memory>
+#include <type_traits>
+#include <algorithm>
+
+namespace mix::ds
+{
+    namespace cached_impl
+    {
+        template<class Compare, class T, class = void>
+        struct has_static_key : std::false_type
+        {
+        };
+
+        template<class Compare, class T>
+        struct has_static_key<Compare, T, std::void_t<decltype(Compare::key(std::declval<T const&>()))>>
+            : std::true_type
+        {
+        };
+
+        /**
+            Uses Compare::key as the key. The key must be ordered by operator<
+            the same way as the values are ordered by Compare.
+         */
+        template<class T, class Compare, bool = has_static_key<Compare, T>::value>
+        struct key_policy
+        {
+            static_assert( has_static_key<Compare, T>::value
+                         , "Compare must provide static key function, caching a copy of T defeats the adaptor." );
+        };
+
+        template<class T, class Compare>
+        struct key_policy<T, Compare, true>
+        {
+            using key_t     = std::decay_t<decltype(Compare::key(std::declval<T const&>()))>;
+            using compare_t = std::less<key_t>;
+
+            static auto key (T const& value) -> key_t
+            {
+                return Compare::key(value);
+            }
+        };
+    }
+
+    /**
+        Element of the underlying heap. Key is stored next to the links of the node.
+     */
+    template<class Key, class T>
+    struct cached_entry
+    {
+        Key key;
+        T   value;
+    };
+
+    /**
+        Compares entries by their keys only.
+     */
+    template<class KeyCompare>
+    struct cached_entry_compare
+    {
+        template<class Key, class T>
+        auto operator() (cached_entry<Key, T> const& lhs, cached_entry<Key, T> const& rhs) const -> bool
+        {
+            return KeyCompare () (lhs.key, rhs.key);
+        }
+    };
+
+    /**
+        Cached key heap forward declaration.
+     */
+    template< template<class, class, class...> class Heap
+            , class T
+            , class Compare
+            , class... Options >
+    class cached_key_heap;
+
+    /**
+        Handle that is returned after an insertion
+        and can be used for decrease_key and erase.
+     */
+    template<class Handle, class T>
+    class cached_key_handle
+    {
+    public:
+        auto operator*  ()       -> T&;
+        auto operator*  () const -> T const&;
+        auto operator-> ()       -> T*;
+        auto operator-> () const -> T const*;
+
+    private:
+        template<template<class, class, class...> class, class, class, class...>
+        friend class cached_key_heap;
+        cached_key_handle(Handle const handle);
+        Handle handle_;
+    };
+
+    /**
+        Iterator over values of the cached key heap.
+     */
+    template<class Iterator, class T, bool IsConst>
+    class cached_key_iterator
+    {
+    public:
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::conditional_t<IsConst, T const, T>;
+        using pointer           = value_type*;
+        using reference         = value_type&;
+        using iterator_category = std::forward_iterator_tag;
+
+    public:
+        cached_key_iterator () = default;
+        cached_key_iterator (Iterator const it);
+
+        auto operator++ ()       -> cached_key_iterator&;
+        auto operator++ (int)    -> cached_key_iterator;
+        auto operator*  () const -> reference;
+        auto operator-> () const -> pointer;
+        auto operator== (cached_key_iterator const&) const -> bool;
+        auto operator!= (cached_key_iterator const&) const -> bool;
+
+    private:
+        Iterator it_;
+    };
+
+    /**
+        Adaptor of an addressable heap that stores the key of each element
+        inside the node next to the links. Comparisons inside the heap touch
+        only node memory even if the elements are pointers to the real data.
+        Key of an element is refreshed from the element on decrease_key.
+
+        @tparam Heap        Underlying heap e.g. pairing_heap or fibonacci_heap.
+        @tparam T           The type of the stored elements.
+        @tparam Compare     Type providing a strict weak ordering and static
+                            key(T const&). Only the key is cached and compared.
+        @tparam Options     Other template parameters of the underlying heap.
+     */
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    class cached_key_heap
+    {
+    public:
+        using key_policy      = cached_impl::key_policy<T, Compare>;
+        using key_t           = typename key_policy::key_t;
+        using entry_t         = cached_entry<key_t, T>;
+        using entry_compare   = cached_entry_compare<typename key_policy::compare_t>;
+        using heap_t          = Heap<entry_t, entry_compare, Options...>;
+        using handle_t        = cached_key_handle<typename heap_t::handle_t, T>;
+        using value_type      = T;
+        using reference       = T&;
+        using const_reference = T const&;
+        using size_type       = std::size_t;
+        using iterator        = cached_key_iterator<typename heap_t::iterator, T, false>;
+        using const_iterator  = cached_key_iterator<typename heap_t::const_iterator, T, true>;
+
+    public:
+        template<class... Args>
+        auto emplace      (Args&&... args)                -> handle_t;
+        auto insert       (value_type const& value)       -> handle_t;
+        auto insert       (value_type&& value)            -> handle_t;
+        auto delete_min   ()                              -> void;
+        auto find_min     ()                              -> reference;
+        auto find_min     () const                        -> const_reference;
+        auto decrease_key (handle_t const handle)         -> void;
+        auto erase        (handle_t const handle)         -> void;
+        auto meld         (cached_key_heap rhs)           -> cached_key_heap&;
+        auto swap         (cached_key_heap& rhs) noexcept -> void;
+        auto empty        () const                        -> bool;
+        auto size         () const                        -> size_type;
+        auto max_size     () const                        -> size_type;
+        auto clear        ()                              -> void;
+        auto begin        ()                              -> iterator;
+        auto end          ()                              -> iterator;
+        auto begin        () const                        -> const_iterator;
+        auto end          () const                        -> const_iterator;
+        auto cbegin       () const                        -> const_iterator;
+        auto cend         () const                        -> const_iterator;
+
+    private:
+        heap_t heap_;
+    };
+
+    template<class T, class Compare, class MergeMode = merge_modes::two_pass>
+    using cached_pairing_heap = cached_key_heap<pairing_heap, T, Compare, MergeMode>;
+
+    template<class T, class Compare>
+    using cached_fibonacci_heap = cached_key_heap<fibonacci_heap, T, Compare>;
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto meld ( cached_key_heap<Heap, T, Compare, Options...>
+              , cached_key_heap<Heap, T, Compare, Options...> ) noexcept
+              -> cached_key_heap<Heap, T, Compare, Options...>;
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto swap ( cached_key_heap<Heap, T, Compare, Options...>&
+              , cached_key_heap<Heap, T, Compare, Options...>& ) noexcept -> void;
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto operator== ( cached_key_heap<Heap, T, Compare, Options...> const&
+                    , cached_key_heap<Heap, T, Compare, Options...> const& ) -> bool;
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto operator!= ( cached_key_heap<Heap, T, Compare, Options...> const&
+                    , cached_key_heap<Heap, T, Compare, Options...> const& ) -> bool;
+
+/// definitions:
+
+// cached_key_handle definition:
+
+    template<class Handle, class T>
+    cached_key_handle<Handle, T>::cached_key_handle(Handle const handle) :
+        handle_ (handle)
+    {
+    }
+
+    template<class Handle, class T>
+    auto cached_key_handle<Handle, T>::operator*
+        () -> T&
+    {
+        return (*handle_).value;
+    }
+
+    template<class Handle, class T>
+    auto cached_key_handle<Handle, T>::operator*
+        () const -> T const&
+    {
+        return (*handle_).value;
+    }
+
+    template<class Handle, class T>
+    auto cached_key_handle<Handle, T>::operator->
+        () -> T*
+    {
+        return std::addressof(**this);
+    }
+
+    template<class Handle, class T>
+    auto cached_key_handle<Handle, T>::operator->
+        () const -> T const*
+    {
+        return std::addressof(**this);
+    }
+
+// cached_key_iterator definition:
+
+    template<class Iterator, class T, bool IsConst>
+    cached_key_iterator<Iterator, T, IsConst>::cached_key_iterator
+        (Iterator const it) :
+        it_ (it)
+    {
+    }
+
+    template<class Iterator, class T, bool IsConst>
+    auto cached_key_iterator<Iterator, T, IsConst>::operator++
+        () -> cached_key_iterator&
+    {
+        ++it_;
+        return *this;
+    }
+
+    template<class Iterator, class T, bool IsConst>
+    auto cached_key_iterator<Iterator, T, IsConst>::operator++
+        (int) -> cached_key_iterator
+    {
+        auto const ret = *this;
+        ++(*this);
+        return ret;
+    }
+
+    template<class Iterator, class T, bool IsConst>
+    auto cached_key_iterator<Iterator, T, IsConst>::operator*
+        () const -> reference
+    {
+        return (*it_).value;
+    }
+
+    template<class Iterator, class T, bool IsConst>
+    auto cached_key_iterator<Iterator, T, IsConst>::operator->
+        () const -> pointer
+    {
+        return std::addressof(**this);
+    }
+
+    template<class Iterator, class T, bool IsConst>
+    auto cached_key_iterator<Iterator, T, IsConst>::operator==
+        (cached_key_iterator const& rhs) const -> bool
+    {
+        return it_ == rhs.it_;
+    }
+
+    template<class Iterator, class T, bool IsConst>
+    auto cached_key_iterator<Iterator, T, IsConst>::operator!=
+        (cached_key_iterator const& rhs) const -> bool
+    {
+        return !(*this == rhs);
+    }
+
+// cached_key_heap definition:
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    template<class... Args>
+    auto cached_key_heap<Heap, T, Compare, Options...>::emplace
+        (Args&&... args) -> handle_t
+    {
+        return this->insert(value_type(std::forward<Args>(args)...));
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::insert
+        (value_type const& value) -> handle_t
+    {
+        return handle_t(heap_.insert(entry_t {key_policy::key(value), value}));
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::insert
+        (value_type&& value) -> handle_t
+    {
+        // Elements of braced init list are evaluated in order so the key is taken first.
+        return handle_t(heap_.insert(entry_t {key_policy::key(value), std::move(value)}));
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::delete_min
+        () -> void
+    {
+        heap_.delete_min();
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::find_min
+        () -> reference
+    {
+        return heap_.find_min().value;
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::find_min
+        () const -> const_reference
+    {
+        return heap_.find_min().value;
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::decrease_key
+        (handle_t const handle) -> void
+    {
+        auto heapHandle = handle.handle_;
+        auto& entry     = *heapHandle;
+        entry.key       = key_policy::key(entry.value);
+        heap_.decrease_key(heapHandle);
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::erase
+        (handle_t const handle) -> void
+    {
+        heap_.erase(handle.handle_);
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::meld
+        (cached_key_heap rhs) -> cached_key_heap&
+    {
+        heap_.meld(std::move(rhs.heap_));
+        return *this;
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::swap
+        (cached_key_heap& rhs) noexcept -> void
+    {
+        heap_.swap(rhs.heap_);
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::empty
+        () const -> bool
+    {
+        return heap_.empty();
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::size
+        () const -> size_type
+    {
+        return heap_.size();
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::max_size
+        () const -> size_type
+    {
+        return heap_.max_size();
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::clear
+        () -> void
+    {
+        heap_.clear();
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::begin
+        () -> iterator
+    {
+        return iterator(heap_.begin());
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::end
+        () -> iterator
+    {
+        return iterator(heap_.end());
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::begin
+        () const -> const_iterator
+    {
+        return this->cbegin();
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::end
+        () const -> const_iterator
+    {
+        return this->cend();
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::cbegin
+        () const -> const_iterator
+    {
+        return const_iterator(heap_.cbegin());
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto cached_key_heap<Heap, T, Compare, Options...>::cend
+        () const -> const_iterator
+    {
+        return const_iterator(heap_.cend());
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto meld ( cached_key_heap<Heap, T, Compare, Options...> lhs
+              , cached_key_heap<Heap, T, Compare, Options...> rhs ) noexcept
+              -> cached_key_heap<Heap, T, Compare, Options...>
+    {
+        lhs.meld(std::move(rhs));
+        return cached_key_heap<Heap, T, Compare, Options...>(std::move(lhs));
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto swap ( cached_key_heap<Heap, T, Compare, Options...>& lhs
+              , cached_key_heap<Heap, T, Compare, Options...>& rhs ) noexcept -> void
+    {
+        lhs.swap(rhs);
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto operator== ( cached_key_heap<Heap, T, Compare, Options...> const& lhs
+                    , cached_key_heap<Heap, T, Compare, Options...> const& rhs ) -> bool
+    {
+        return lhs.size() == rhs.size()
+            && std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs));
+    }
+
+    template<template<class, class, class...> class Heap, class T, class Compare, class... Options>
+    auto operator!= ( cached_key_heap<Heap, T, Compare, Options...> const& lhs
+                    , cached_key_heap<Heap, T, Compare, Options...> const& rhs ) -> bool
+    {
+        return ! (lhs == rhs);
+    }
+}
+
+#endif
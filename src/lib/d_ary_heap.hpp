@@ -0,0 +1,879 @@
+#ifndef MIX_DS_D_ARY_HEAP_HPP
+#define MIX_DS_D_ARY_HEAP_HPP
+
+#include <functional>
+#include <utility>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace mix::ds
+{
+    /**
+        Number of sons of each node of the d_ary_heap.
+     */
+    template<std::size_t D>
+    struct heap_arity
+    {
+        static_assert(D >= 2, "Heap must have at least two sons per node.");
+        static constexpr std::size_t value = D;
+    };
+
+    namespace d_ary_impl
+    {
+        inline constexpr std::size_t CacheLineSize = 64;
+
+        /**
+            Unit of allocation of the element array so that
+            the array starts at the beginning of a cache line.
+         */
+        struct alignas(CacheLineSize) cache_line
+        {
+            unsigned char bytes_[CacheLineSize];
+        };
+    }
+
+    /**
+        Element of the d-ary heap together with its id.
+        Id is the index of the element in the position index.
+     */
+    template<class T>
+    class d_ary_slot
+    {
+    public:
+        using id_t = std::uint32_t;
+
+    public:
+        template<class... Args>
+        d_ary_slot (id_t const id, std::piecewise_construct_t, Args&&... args);
+
+        T    data_;
+        id_t id_;
+    };
+
+    /**
+        Iterator of the d-ary heap.
+     */
+    template<class T, bool IsConst>
+    class d_ary_heap_iterator;
+
+    /**
+        D-ary heap.
+     */
+    template< class T
+            , class Compare   = std::less<T>
+            , class Arity     = heap_arity<4>
+            , class Allocator = std::allocator<T> >
+    class d_ary_heap;
+
+    /**
+        Element handle that is returned after an insertion
+        and can be used for decrease_key and erase.
+     */
+    template<class T, class Compare, class Arity, class Allocator>
+    class d_ary_heap_handle
+    {
+    public:
+        auto operator*  ()       -> T&;
+        auto operator*  () const -> T const&;
+        auto operator-> ()       -> T*;
+        auto operator-> () const -> T const*;
+
+    private:
+        using heap_t = d_ary_heap<T, Compare, Arity, Allocator>;
+        using id_t   = typename d_ary_slot<T>::id_t;
+        friend class d_ary_heap<T, Compare, Arity, Allocator>;
+        d_ary_heap_handle(heap_t* const heap, id_t const id);
+        heap_t* heap_;
+        id_t    id_;
+    };
+
+    template<class T, bool IsConst>
+    class d_ary_heap_iterator
+    {
+    public:
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::conditional_t<IsConst, T const, T>;
+        using pointer           = value_type*;
+        using reference         = value_type&;
+        using iterator_category = std::forward_iterator_tag;
+        using slot_t            = std::conditional_t<IsConst, d_ary_slot<T> const, d_ary_slot<T>>;
+
+    public:
+        d_ary_heap_iterator () = default;
+        d_ary_heap_iterator (slot_t* const slot);
+
+        auto operator++ ()       -> d_ary_heap_iterator&;
+        auto operator++ (int)    -> d_ary_heap_iterator;
+        auto operator*  () const -> reference;
+        auto operator-> () const -> pointer;
+        auto operator== (d_ary_heap_iterator const&) const -> bool;
+        auto operator!= (d_ary_heap_iterator const&) const -> bool;
+
+    private:
+        slot_t* slot_ {nullptr};
+    };
+
+    /**
+        Addressable implicit d-ary heap. Elements are stored by value in one
+        array that starts at a cache line boundary. The array is shifted by
+        D - 1 slots so that all sons of a node start at a multiple of D
+        and they share a cache line if D slots fit into one.
+        Position index maps the id of each element to its current index
+        in the array, ids of erased elements are reused.
+        Handles refer to the heap object that returned them, they are
+        invalidated when the heap is moved or swapped and handles of rhs
+        are invalidated by meld. Meld is linear in the size of both heaps.
+        Unlike std::priority_queue in this heap an element "which is less"
+        has a higher priority.
+
+        @tparam T           The type of the stored elements.
+        @tparam Compare     Type providing a strict weak ordering.
+                            See https://en.cppreference.com/w/cpp/named_req/Compare
+        @tparam Arity       Number of sons of each node. See heap_arity.
+        @tparam Allocator   Allocator. See https://en.cppreference.com/w/cpp/named_req/Allocator
+     */
+    template<class T, class Compare, class Arity, class Allocator>
+    class d_ary_heap
+    {
+    public:
+        using slot_t            = d_ary_slot<T>;
+        using id_t              = typename slot_t::id_t;
+        using line_t            = d_ary_impl::cache_line;
+        using handle_t          = d_ary_heap_handle<T, Compare, Arity, Allocator>;
+        using value_type        = T;
+        using reference         = T&;
+        using const_reference   = T const&;
+        using size_type         = std::size_t;
+        using difference_type   = std::ptrdiff_t;
+        using iterator          = d_ary_heap_iterator<T, false>;
+        using const_iterator    = d_ary_heap_iterator<T, true>;
+        using type_alloc_traits = std::allocator_traits<Allocator>;
+        using slot_alloc_traits = typename type_alloc_traits::template rebind_traits<slot_t>;
+        using slot_allocator    = typename type_alloc_traits::template rebind_alloc<slot_t>;
+        using line_alloc_traits = typename type_alloc_traits::template rebind_traits<line_t>;
+        using line_allocator    = typename type_alloc_traits::template rebind_alloc<line_t>;
+        using id_allocator      = typename type_alloc_traits::template rebind_alloc<id_t>;
+
+        static constexpr size_type D      = Arity::value;
+        static constexpr size_type Offset = D - 1;
+
+        static_assert( alignof(slot_t) <= alignof(line_t)
+                     , "Element must not be over-aligned." );
+
+    public:
+        d_ary_heap  (Allocator const& alloc = Allocator());
+        d_ary_heap  (d_ary_heap const& other);
+        d_ary_heap  (d_ary_heap&& other) noexcept;
+        ~d_ary_heap ();
+
+        auto operator= (d_ary_heap other) noexcept -> d_ary_heap&;
+
+        template<class... Args>
+        auto emplace      (Args&&... args)           -> handle_t;
+        auto insert       (value_type const& value)  -> handle_t;
+        auto insert       (value_type&& value)       -> handle_t;
+        auto delete_min   ()                         -> void;
+        auto find_min     ()                         -> reference;
+        auto find_min     () const                   -> const_reference;
+        auto decrease_key (handle_t const handle)    -> void;
+        auto meld         (d_ary_heap rhs)           -> d_ary_heap&;
+        auto erase        (handle_t const handle)    -> void;
+        auto swap         (d_ary_heap& rhs) noexcept -> void;
+        auto reserve      (size_type const n)        -> void;
+        auto empty        () const                   -> bool;
+        auto size         () const                   -> size_type;
+        auto max_size     () const                   -> size_type;
+        auto clear        ()                         -> void;
+        auto begin        ()                         -> iterator;
+        auto end          ()                         -> iterator;
+        auto begin        () const                   -> const_iterator;
+        auto end          () const                   -> const_iterator;
+        auto cbegin       () const                   -> const_iterator;
+        auto cend         () const                   -> const_iterator;
+
+    private:
+        friend class d_ary_heap_handle<T, Compare, Arity, Allocator>;
+
+        template<class... Args>
+        auto insert_impl  (Args&&... args)     -> handle_t;
+        auto erase_at     (size_type const i)  -> void;
+        auto sift_up      (size_type i)        -> void;
+        auto sift_down    (size_type i)        -> void;
+        auto place        (slot_t* const slot, size_type const i) -> void;
+        auto grow         (size_type const n)  -> void;
+        auto new_id       ()                   -> id_t;
+        auto free_id      (id_t const id)      -> void;
+        auto destroy_all  ()                   -> void;
+        auto deallocate   ()                   -> void;
+        auto empty_check  () const             -> void;
+        auto slot_of      (id_t const id)      -> slot_t&;
+
+        static auto line_count (size_type const slots) -> size_type;
+        static auto parent     (size_type const i)     -> size_type;
+        static auto first_son  (size_type const i)     -> size_type;
+
+    private:
+        static constexpr id_t NoId = std::numeric_limits<id_t>::max();
+
+        slot_allocator                  slotAlloc_;
+        line_allocator                  lineAlloc_;
+        line_t*                         lines_;
+        slot_t*                         data_;
+        size_type                       size_;
+        size_type                       capacity_;
+        size_type                       lineCount_;
+        std::vector<id_t, id_allocator> index_;
+        id_t                            freeId_;
+    };
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto meld ( d_ary_heap<T, Compare, Arity, Allocator>
+              , d_ary_heap<T, Compare, Arity, Allocator> )
+              -> d_ary_heap<T, Compare, Arity, Allocator>;
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto swap ( d_ary_heap<T, Compare, Arity, Allocator>&
+              , d_ary_heap<T, Compare, Arity, Allocator>& ) noexcept -> void;
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto operator== ( d_ary_heap<T, Compare, Arity, Allocator> const&
+                    , d_ary_heap<T, Compare, Arity, Allocator> const& ) -> bool;
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto operator!= ( d_ary_heap<T, Compare, Arity, Allocator> const&
+                    , d_ary_heap<T, Compare, Arity, Allocator> const& ) -> bool;
+
+/// definitions:
+
+// d_ary_slot definition:
+
+    template<class T>
+    template<class... Args>
+    d_ary_slot<T>::d_ary_slot(id_t const id, std::piecewise_construct_t, Args&&... args) :
+        data_ (std::forward<Args>(args)...),
+        id_   (id)
+    {
+    }
+
+// d_ary_heap_handle definition:
+
+    template<class T, class Compare, class Arity, class Allocator>
+    d_ary_heap_handle<T, Compare, Arity, Allocator>::d_ary_heap_handle
+        (heap_t* const heap, id_t const id) :
+        heap_ (heap),
+        id_   (id)
+    {
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap_handle<T, Compare, Arity, Allocator>::operator*
+        () -> T&
+    {
+        return heap_->slot_of(id_).data_;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap_handle<T, Compare, Arity, Allocator>::operator*
+        () const -> T const&
+    {
+        return heap_->slot_of(id_).data_;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap_handle<T, Compare, Arity, Allocator>::operator->
+        () -> T*
+    {
+        return std::addressof(**this);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap_handle<T, Compare, Arity, Allocator>::operator->
+        () const -> T const*
+    {
+        return std::addressof(**this);
+    }
+
+// d_ary_heap_iterator definition:
+
+    template<class T, bool IsConst>
+    d_ary_heap_iterator<T, IsConst>::d_ary_heap_iterator
+        (slot_t* const slot) :
+        slot_ (slot)
+    {
+    }
+
+    template<class T, bool IsConst>
+    auto d_ary_heap_iterator<T, IsConst>::operator++
+        () -> d_ary_heap_iterator&
+    {
+        ++slot_;
+        return *this;
+    }
+
+    template<class T, bool IsConst>
+    auto d_ary_heap_iterator<T, IsConst>::operator++
+        (int) -> d_ary_heap_iterator
+    {
+        auto const ret = *this;
+        ++(*this);
+        return ret;
+    }
+
+    template<class T, bool IsConst>
+    auto d_ary_heap_iterator<T, IsConst>::operator*
+        () const -> reference
+    {
+        return slot_->data_;
+    }
+
+    template<class T, bool IsConst>
+    auto d_ary_heap_iterator<T, IsConst>::operator->
+        () const -> pointer
+    {
+        return std::addressof(**this);
+    }
+
+    template<class T, bool IsConst>
+    auto d_ary_heap_iterator<T, IsConst>::operator==
+        (d_ary_heap_iterator const& rhs) const -> bool
+    {
+        return slot_ == rhs.slot_;
+    }
+
+    template<class T, bool IsConst>
+    auto d_ary_heap_iterator<T, IsConst>::operator!=
+        (d_ary_heap_iterator const& rhs) const -> bool
+    {
+        return !(*this == rhs);
+    }
+
+// d_ary_heap definition:
+
+    template<class T, class Compare, class Arity, class Allocator>
+    d_ary_heap<T, Compare, Arity, Allocator>::d_ary_heap
+        (Allocator const& alloc) :
+        slotAlloc_ (alloc),
+        lineAlloc_ (alloc),
+        lines_     (nullptr),
+        data_      (nullptr),
+        size_      (0),
+        capacity_  (0),
+        lineCount_ (0),
+        index_     (id_allocator(alloc)),
+        freeId_    (NoId)
+    {
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    d_ary_heap<T, Compare, Arity, Allocator>::d_ary_heap
+        (d_ary_heap const& other) :
+        slotAlloc_ (other.slotAlloc_),
+        lineAlloc_ (other.lineAlloc_),
+        lines_     (nullptr),
+        data_      (nullptr),
+        size_      (0),
+        capacity_  (0),
+        lineCount_ (0),
+        index_     (other.index_),
+        freeId_    (other.freeId_)
+    {
+        // Same layout so that the ids in the index stay valid.
+        this->grow(other.size_);
+        for (; size_ < other.size_; ++size_)
+        {
+            slot_alloc_traits::construct(slotAlloc_, data_ + size_, other.data_[size_]);
+        }
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    d_ary_heap<T, Compare, Arity, Allocator>::d_ary_heap
+        (d_ary_heap&& other) noexcept :
+        slotAlloc_ (std::move(other.slotAlloc_)),
+        lineAlloc_ (std::move(other.lineAlloc_)),
+        lines_     (std::exchange(other.lines_, nullptr)),
+        data_      (std::exchange(other.data_, nullptr)),
+        size_      (std::exchange(other.size_, 0)),
+        capacity_  (std::exchange(other.capacity_, 0)),
+        lineCount_ (std::exchange(other.lineCount_, 0)),
+        index_     (std::move(other.index_)),
+        freeId_    (std::exchange(other.freeId_, NoId))
+    {
+        other.index_.clear();
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    d_ary_heap<T, Compare, Arity, Allocator>::~d_ary_heap()
+    {
+        this->destroy_all();
+        this->deallocate();
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::operator=
+        (d_ary_heap other) noexcept -> d_ary_heap&
+    {
+        this->swap(other);
+        return *this;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    template<class... Args>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::emplace
+        (Args&&... args) -> handle_t
+    {
+        return this->insert_impl(std::forward<Args>(args)...);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::insert
+        (value_type const& value) -> handle_t
+    {
+        return this->insert_impl(value);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::insert
+        (value_type&& value) -> handle_t
+    {
+        return this->insert_impl(std::move(value));
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::delete_min
+        () -> void
+    {
+        this->empty_check();
+        this->erase_at(0);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::find_min
+        () -> reference
+    {
+        this->empty_check();
+        return data_[0].data_;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::find_min
+        () const -> const_reference
+    {
+        this->empty_check();
+        return data_[0].data_;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::decrease_key
+        (handle_t const handle) -> void
+    {
+        this->sift_up(index_[handle.id_]);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::meld
+        (d_ary_heap rhs) -> d_ary_heap&
+    {
+        if (0 == rhs.size_)
+        {
+            return *this;
+        }
+
+        this->grow(size_ + rhs.size_);
+        for (auto i = size_type {0}; i < rhs.size_; ++i)
+        {
+            auto const id = this->new_id();
+            slot_alloc_traits::construct( slotAlloc_, data_ + size_, id
+                                        , std::piecewise_construct, std::move(rhs.data_[i].data_) );
+            index_[id] = static_cast<id_t>(size_);
+            ++size_;
+        }
+        rhs.clear();
+
+        // Bottom-up heap construction, it is only ever sifted down.
+        for (auto i = d_ary_heap::parent(size_ - 1) + 1; i > 0; --i)
+        {
+            this->sift_down(i - 1);
+        }
+
+        return *this;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::erase
+        (handle_t const handle) -> void
+    {
+        this->erase_at(index_[handle.id_]);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::swap
+        (d_ary_heap& rhs) noexcept -> void
+    {
+        using std::swap;
+        swap(lines_, rhs.lines_);
+        swap(data_, rhs.data_);
+        swap(size_, rhs.size_);
+        swap(capacity_, rhs.capacity_);
+        swap(lineCount_, rhs.lineCount_);
+        swap(index_, rhs.index_);
+        swap(freeId_, rhs.freeId_);
+
+        if constexpr (slot_alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(slotAlloc_, rhs.slotAlloc_);
+        }
+
+        if constexpr (line_alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(lineAlloc_, rhs.lineAlloc_);
+        }
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::reserve
+        (size_type const n) -> void
+    {
+        this->grow(n);
+        index_.reserve(n);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::empty
+        () const -> bool
+    {
+        return 0 == this->size();
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::size
+        () const -> size_type
+    {
+        return size_;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::max_size
+        () const -> size_type
+    {
+        return NoId;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::clear
+        () -> void
+    {
+        this->destroy_all();
+        index_.clear();
+        freeId_ = NoId;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::begin
+        () -> iterator
+    {
+        return iterator(data_);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::end
+        () -> iterator
+    {
+        return iterator(data_ + size_);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::begin
+        () const -> const_iterator
+    {
+        return this->cbegin();
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::end
+        () const -> const_iterator
+    {
+        return this->cend();
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::cbegin
+        () const -> const_iterator
+    {
+        return const_iterator(data_);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::cend
+        () const -> const_iterator
+    {
+        return const_iterator(data_ + size_);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    template<class... Args>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::insert_impl
+        (Args&&... args) -> handle_t
+    {
+        if (size_ == capacity_)
+        {
+            this->grow(std::max<size_type>(2 * capacity_, D * D));
+        }
+
+        auto const id = this->new_id();
+        slot_alloc_traits::construct( slotAlloc_, data_ + size_, id
+                                    , std::piecewise_construct, std::forward<Args>(args)... );
+        index_[id] = static_cast<id_t>(size_);
+        ++size_;
+        this->sift_up(size_ - 1);
+
+        return handle_t(this, id);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::erase_at
+        (size_type const i) -> void
+    {
+        auto const last = size_ - 1;
+        this->free_id(data_[i].id_);
+
+        if (i != last)
+        {
+            data_[i] = std::move(data_[last]);
+            index_[data_[i].id_] = static_cast<id_t>(i);
+        }
+
+        slot_alloc_traits::destroy(slotAlloc_, data_ + last);
+        --size_;
+
+        if (i < size_)
+        {
+            // Element from the end can be smaller than the parent of the erased one.
+            if (i > 0 && Compare () (data_[i].data_, data_[d_ary_heap::parent(i)].data_))
+            {
+                this->sift_up(i);
+            }
+            else
+            {
+                this->sift_down(i);
+            }
+        }
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::sift_up
+        (size_type i) -> void
+    {
+        if (0 == i || !Compare () (data_[i].data_, data_[d_ary_heap::parent(i)].data_))
+        {
+            return;
+        }
+
+        // Parents are moved down into the hole, the element is placed once.
+        auto slot = std::move(data_[i]);
+        do
+        {
+            auto const p = d_ary_heap::parent(i);
+            this->place(data_ + p, i);
+            i = p;
+        }
+        while (i > 0 && Compare () (slot.data_, data_[d_ary_heap::parent(i)].data_));
+
+        this->place(&slot, i);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::sift_down
+        (size_type i) -> void
+    {
+        auto slot = std::move(data_[i]);
+
+        for (;;)
+        {
+            auto const first = d_ary_heap::first_son(i);
+            if (first >= size_)
+            {
+                break;
+            }
+
+            auto const last = std::min(first + D, size_);
+            auto best       = first;
+            for (auto son = first + 1; son < last; ++son)
+            {
+                if (Compare () (data_[son].data_, data_[best].data_))
+                {
+                    best = son;
+                }
+            }
+
+            if (!Compare () (data_[best].data_, slot.data_))
+            {
+                break;
+            }
+
+            this->place(data_ + best, i);
+            i = best;
+        }
+
+        this->place(&slot, i);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::place
+        (slot_t* const slot, size_type const i) -> void
+    {
+        data_[i] = std::move(*slot);
+        index_[data_[i].id_] = static_cast<id_t>(i);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::grow
+        (size_type const n) -> void
+    {
+        if (n <= capacity_)
+        {
+            return;
+        }
+
+        auto const lineCount = d_ary_heap::line_count(n);
+        auto const lines     = line_alloc_traits::allocate(lineAlloc_, lineCount);
+        auto const data      = reinterpret_cast<slot_t*>(lines) + Offset;
+
+        for (auto i = size_type {0}; i < size_; ++i)
+        {
+            slot_alloc_traits::construct(slotAlloc_, data + i, std::move(data_[i]));
+            slot_alloc_traits::destroy(slotAlloc_, data_ + i);
+        }
+
+        this->deallocate();
+        lines_     = lines;
+        data_      = data;
+        lineCount_ = lineCount;
+        capacity_  = lineCount * sizeof(line_t) / sizeof(slot_t) - Offset;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::new_id
+        () -> id_t
+    {
+        if (NoId != freeId_)
+        {
+            // Free ids are linked through the index.
+            return std::exchange(freeId_, index_[freeId_]);
+        }
+
+        index_.emplace_back(0);
+        return static_cast<id_t>(index_.size() - 1);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::free_id
+        (id_t const id) -> void
+    {
+        index_[id] = freeId_;
+        freeId_    = id;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::destroy_all
+        () -> void
+    {
+        for (auto i = size_type {0}; i < size_; ++i)
+        {
+            slot_alloc_traits::destroy(slotAlloc_, data_ + i);
+        }
+        size_ = 0;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::deallocate
+        () -> void
+    {
+        if (lines_)
+        {
+            line_alloc_traits::deallocate(lineAlloc_, lines_, lineCount_);
+        }
+
+        lines_     = nullptr;
+        data_      = nullptr;
+        capacity_  = 0;
+        lineCount_ = 0;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::empty_check
+        () const -> void
+    {
+        if (this->empty())
+        {
+            throw std::out_of_range("Heap is empty!");
+        }
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::slot_of
+        (id_t const id) -> slot_t&
+    {
+        return data_[index_[id]];
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::line_count
+        (size_type const slots) -> size_type
+    {
+        auto const bytes = (slots + Offset) * sizeof(slot_t);
+        return (bytes + sizeof(line_t) - 1) / sizeof(line_t);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::parent
+        (size_type const i) -> size_type
+    {
+        return (i - 1) / D;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto d_ary_heap<T, Compare, Arity, Allocator>::first_son
+        (size_type const i) -> size_type
+    {
+        return D * i + 1;
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto meld ( d_ary_heap<T, Compare, Arity, Allocator> lhs
+              , d_ary_heap<T, Compare, Arity, Allocator> rhs )
+              -> d_ary_heap<T, Compare, Arity, Allocator>
+    {
+        lhs.meld(std::move(rhs));
+        return d_ary_heap<T, Compare, Arity, Allocator>(std::move(lhs));
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto swap ( d_ary_heap<T, Compare, Arity, Allocator>& lhs
+              , d_ary_heap<T, Compare, Arity, Allocator>& rhs ) noexcept -> void
+    {
+        lhs.swap(rhs);
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto operator== ( d_ary_heap<T, Compare, Arity, Allocator> const& lhs
+                    , d_ary_heap<T, Compare, Arity, Allocator> const& rhs ) -> bool
+    {
+        return lhs.size() == rhs.size()
+            && std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs));
+    }
+
+    template<class T, class Compare, class Arity, class Allocator>
+    auto operator!= ( d_ary_heap<T, Compare, Arity, Allocator> const& lhs
+                    , d_ary_heap<T, Compare, Arity, Allocator> const& rhs ) -> bool
+    {
+        return ! (lhs == rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,590 @@
+#ifndef MIX_DS_EXTERNAL_HEAP_HPP
+#define MIX_DS_EXTERNAL_HEAP_HPP
+
+#include "sequence_heap.hpp"
+
+#include <functional>
+#include <utility>
+#include <memory>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <type_traits>
+#include <random>
+#include <cstdio>
+
+namespace mix::ds
+{
+    namespace external_impl
+    {
+        /**
+            Random id that tells apart run files of heaps, even of
+            different processes, that share a directory.
+         */
+        inline auto random_id
+            () -> std::uint64_t
+        {
+            auto device = std::random_device();
+            return (std::uint64_t {device()} << 32) ^ device();
+        }
+    }
+
+    /**
+        Sorted run of an external heap stored in a file. Only one block
+        of the run is kept in memory. File is removed as soon as the last
+        element of the run is popped.
+     */
+    template<class T, class Allocator>
+    class external_run
+    {
+    public:
+        using size_type = std::size_t;
+        using buffer_t  = std::vector<T, Allocator>;
+
+    public:
+        external_run ( std::filesystem::path path
+                     , size_type const count
+                     , size_type const blockSize
+                     , Allocator const& alloc );
+        external_run (external_run&& other) noexcept;
+        ~external_run ();
+
+        external_run (external_run const&) = delete;
+
+        auto operator= (external_run const&)     -> external_run& = delete;
+        auto operator= (external_run&&) noexcept -> external_run&;
+
+        auto empty   () const -> bool;
+        auto head    () const -> T const&;
+        auto pop     ()       -> void;
+        auto size    () const -> size_type;
+
+    private:
+        auto read_block  () -> void;
+        auto remove_file () -> void;
+
+    private:
+        std::filesystem::path path_;
+        std::ifstream         file_;
+        buffer_t              block_;
+        size_type             first_;
+        size_type             onDisk_;
+        size_type             blockSize_;
+    };
+
+    /**
+        External memory priority queue. Elements are inserted into an in-memory
+        heap that uses half of the memory budget. When it is full it is sorted
+        and written into a new run file in the given directory. Minima of the
+        runs are merged lazily by a loser tree and every run is read in blocks
+        by large sequential reads. When the blocks of all runs would not fit
+        into the other half of the budget the smaller half of the runs is merged
+        into a single one on disk first, so that every element is rewritten only
+        a logarithmic number of times. Exhausted runs are removed from the disk
+        right away. Elements are written as raw bytes so T must be trivially
+        copyable. Heap can be neither copied nor moved.
+        Unlike std::priority_queue in this heap an element "which is less"
+        has a higher priority.
+
+        @tparam T           The type of the stored elements.
+        @tparam Compare     Type providing a strict weak ordering.
+                            See https://en.cppreference.com/w/cpp/named_req/Compare
+        @tparam Allocator   Allocator. See https://en.cppreference.com/w/cpp/named_req/Allocator
+     */
+    template< class T
+            , class Compare   = std::less<T>
+            , class Allocator = std::allocator<T> >
+    class external_heap
+    {
+    public:
+        using value_type      = T;
+        using reference       = T&;
+        using const_reference = T const&;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using run_t           = external_run<T, Allocator>;
+        using buffer_t        = std::vector<T, Allocator>;
+
+        static_assert( std::is_trivially_copyable_v<T>
+                     , "Elements are stored on disk as raw bytes." );
+
+        /**
+            Default memory budget in bytes.
+         */
+        static constexpr size_type DefaultBudget = size_type {1} << 28;
+
+        /**
+            Largest block that is read from a run at once in bytes.
+         */
+        static constexpr size_type MaxBlockBytes = size_type {1} << 20;
+
+    public:
+        external_heap ( std::filesystem::path directory = std::filesystem::temp_directory_path()
+                      , size_type const memoryBudget     = DefaultBudget
+                      , Allocator const& alloc           = Allocator() );
+
+        external_heap (external_heap const&) = delete;
+        external_heap (external_heap&&)      = delete;
+
+        auto operator= (external_heap const&) -> external_heap& = delete;
+        auto operator= (external_heap&&)      -> external_heap& = delete;
+
+        template<class... Args>
+        auto emplace    (Args&&... args)          -> void;
+        auto insert     (value_type const& value) -> void;
+        auto insert     (value_type&& value)      -> void;
+        auto delete_min ()                        -> void;
+        auto find_min   () const                  -> const_reference;
+        auto empty      () const                  -> bool;
+        auto size       () const                  -> size_type;
+        auto run_count  () const                  -> size_type;
+
+    private:
+        /**
+            Compares heads of two runs, exhausted runs are the greatest.
+         */
+        struct run_less
+        {
+            std::vector<run_t> const* runs_;
+
+            auto operator() (size_type const lhs, size_type const rhs) const -> bool;
+        };
+
+        /**
+            std heap algorithms keep the maximum on top.
+         */
+        struct heap_compare
+        {
+            auto operator() (T const& lhs, T const& rhs) const -> bool;
+        };
+
+    private:
+        auto spill            ()                                  -> void;
+        auto merge_smallest   ()                                  -> void;
+        auto write_run        (T const* data, size_type const n)  -> void;
+        auto new_run_file     ()                                  -> std::filesystem::path;
+        auto rebuild_tree     ()                                  -> void;
+        auto insert_min_first () const                            -> bool;
+        auto empty_check      () const                            -> void;
+
+    private:
+        Allocator                   alloc_;
+        std::filesystem::path       directory_;
+        size_type                   heapCapacity_;
+        size_type                   blockSize_;
+        size_type                   maxRuns_;
+        buffer_t                    insertHeap_;
+        std::vector<run_t>          runs_;
+        loser_tree<run_less>        tree_;
+        size_type                   size_;
+        std::uint64_t               id_;
+        size_type                   fileCounter_;
+    };
+
+/// definitions:
+
+// external_run definition:
+
+    template<class T, class Allocator>
+    external_run<T, Allocator>::external_run
+        ( std::filesystem::path path
+        , size_type const count
+        , size_type const blockSize
+        , Allocator const& alloc ) :
+        path_      (std::move(path)),
+        file_      (path_, std::ios::binary),
+        block_     (alloc),
+        first_     (0),
+        onDisk_    (count),
+        blockSize_ (blockSize)
+    {
+        if (!file_.is_open())
+        {
+            throw std::runtime_error("Failed to open " + path_.string());
+        }
+
+        block_.reserve(blockSize_);
+        this->read_block();
+    }
+
+    template<class T, class Allocator>
+    external_run<T, Allocator>::external_run
+        (external_run&& other) noexcept :
+        path_      (std::move(other.path_)),
+        file_      (std::move(other.file_)),
+        block_     (std::move(other.block_)),
+        first_     (other.first_),
+        onDisk_    (other.onDisk_),
+        blockSize_ (other.blockSize_)
+    {
+        other.path_.clear();
+    }
+
+    template<class T, class Allocator>
+    external_run<T, Allocator>::~external_run()
+    {
+        this->remove_file();
+    }
+
+    template<class T, class Allocator>
+    auto external_run<T, Allocator>::operator=
+        (external_run&& other) noexcept -> external_run&
+    {
+        this->remove_file();
+        path_      = std::move(other.path_);
+        file_      = std::move(other.file_);
+        block_     = std::move(other.block_);
+        first_     = other.first_;
+        onDisk_    = other.onDisk_;
+        blockSize_ = other.blockSize_;
+        other.path_.clear();
+        return *this;
+    }
+
+    template<class T, class Allocator>
+    auto external_run<T, Allocator>::empty
+        () const -> bool
+    {
+        return first_ == block_.size();
+    }
+
+    template<class T, class Allocator>
+    auto external_run<T, Allocator>::head
+        () const -> T const&
+    {
+        return block_[first_];
+    }
+
+    template<class T, class Allocator>
+    auto external_run<T, Allocator>::pop
+        () -> void
+    {
+        if (++first_ < block_.size())
+        {
+            return;
+        }
+
+        if (onDisk_ > 0)
+        {
+            this->read_block();
+        }
+        else
+        {
+            this->remove_file();
+            block_ = buffer_t(block_.get_allocator());
+            first_ = 0;
+        }
+    }
+
+    template<class T, class Allocator>
+    auto external_run<T, Allocator>::size
+        () const -> size_type
+    {
+        return block_.size() - first_ + onDisk_;
+    }
+
+    template<class T, class Allocator>
+    auto external_run<T, Allocator>::read_block
+        () -> void
+    {
+        auto const count = std::min(blockSize_, onDisk_);
+        block_.resize(count);
+        first_ = 0;
+        file_.read( reinterpret_cast<char*>(block_.data())
+                  , static_cast<std::streamsize>(count * sizeof(T)) );
+
+        if (!file_)
+        {
+            throw std::runtime_error(path_.string() + " is truncated.");
+        }
+
+        onDisk_ -= count;
+    }
+
+    template<class T, class Allocator>
+    auto external_run<T, Allocator>::remove_file
+        () -> void
+    {
+        if (!path_.empty())
+        {
+            file_.close();
+            auto ec = std::error_code();
+            std::filesystem::remove(path_, ec);
+            path_.clear();
+        }
+    }
+
+// external_heap definition:
+
+    template<class T, class Compare, class Allocator>
+    external_heap<T, Compare, Allocator>::external_heap
+        ( std::filesystem::path directory
+        , size_type const memoryBudget
+        , Allocator const& alloc ) :
+        alloc_        (alloc),
+        directory_    (std::move(directory)),
+        heapCapacity_ (std::max<size_type>(1, memoryBudget / 2 / sizeof(T))),
+        blockSize_    (std::max<size_type>(1, std::min(MaxBlockBytes, memoryBudget / 32) / sizeof(T))),
+        maxRuns_      (std::max<size_type>(2, memoryBudget / 2 / (blockSize_ * sizeof(T)))),
+        insertHeap_   (alloc),
+        runs_         (),
+        tree_         (0, run_less {&runs_}),
+        size_         (0),
+        id_           (external_impl::random_id()),
+        fileCounter_  (0)
+    {
+        insertHeap_.reserve(heapCapacity_);
+        runs_.reserve(maxRuns_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    auto external_heap<T, Compare, Allocator>::emplace
+        (Args&&... args) -> void
+    {
+        if (insertHeap_.size() == heapCapacity_)
+        {
+            this->spill();
+        }
+
+        insertHeap_.emplace_back(std::forward<Args>(args)...);
+        std::push_heap(std::begin(insertHeap_), std::end(insertHeap_), heap_compare ());
+        ++size_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::insert
+        (value_type const& value) -> void
+    {
+        this->emplace(value);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::insert
+        (value_type&& value) -> void
+    {
+        this->emplace(std::move(value));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::delete_min
+        () -> void
+    {
+        this->empty_check();
+
+        if (this->insert_min_first())
+        {
+            std::pop_heap(std::begin(insertHeap_), std::end(insertHeap_), heap_compare ());
+            insertHeap_.pop_back();
+        }
+        else
+        {
+            runs_[tree_.winner()].pop();
+            tree_.replay();
+        }
+
+        --size_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::find_min
+        () const -> const_reference
+    {
+        this->empty_check();
+        return this->insert_min_first() ? insertHeap_.front()
+                                        : runs_[tree_.winner()].head();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::empty
+        () const -> bool
+    {
+        return 0 == this->size();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::size
+        () const -> size_type
+    {
+        return size_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::run_count
+        () const -> size_type
+    {
+        return runs_.size();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::spill
+        () -> void
+    {
+        runs_.erase( std::remove_if( std::begin(runs_), std::end(runs_)
+                                   , [](auto const& r) { return r.empty(); } )
+                   , std::end(runs_) );
+
+        if (runs_.size() == maxRuns_)
+        {
+            this->merge_smallest();
+        }
+
+        std::sort(std::begin(insertHeap_), std::end(insertHeap_), Compare ());
+        this->write_run(insertHeap_.data(), insertHeap_.size());
+        insertHeap_.clear();
+        this->rebuild_tree();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::merge_smallest
+        () -> void
+    {
+        std::sort( std::begin(runs_), std::end(runs_)
+                 , [](auto const& l, auto const& r) { return l.size() > r.size(); } );
+
+        // Runs are sorted by size in descending order so the group is at the back.
+        auto const groupSize  = std::max<size_type>(2, runs_.size() / 2);
+        auto const groupFirst = std::prev(std::end(runs_), static_cast<difference_type>(groupSize));
+        auto group            = std::vector<run_t>( std::make_move_iterator(groupFirst)
+                                                  , std::make_move_iterator(std::end(runs_)) );
+        runs_.erase(groupFirst, std::end(runs_));
+
+        auto tree       = loser_tree<run_less>(group.size(), run_less {&group});
+        auto const path = this->new_run_file();
+        auto file       = std::ofstream(path, std::ios::binary);
+        auto block      = buffer_t(alloc_);
+        auto count      = size_type {0};
+        block.reserve(blockSize_);
+
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open " + path.string());
+        }
+
+        auto const flush = [&]()
+        {
+            file.write( reinterpret_cast<char const*>(block.data())
+                      , static_cast<std::streamsize>(block.size() * sizeof(T)) );
+            count += block.size();
+            block.clear();
+        };
+
+        while (!group[tree.winner()].empty())
+        {
+            auto& r = group[tree.winner()];
+            block.push_back(r.head());
+            r.pop();
+            tree.replay();
+
+            if (block.size() == blockSize_)
+            {
+                flush();
+            }
+        }
+        flush();
+        file.close();
+
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write " + path.string());
+        }
+
+        runs_.emplace_back(path, count, blockSize_, alloc_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::write_run
+        (T const* const data, size_type const n) -> void
+    {
+        auto const path = this->new_run_file();
+        auto file       = std::ofstream(path, std::ios::binary);
+
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open " + path.string());
+        }
+
+        file.write( reinterpret_cast<char const*>(data)
+                  , static_cast<std::streamsize>(n * sizeof(T)) );
+        file.close();
+
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write " + path.string());
+        }
+
+        runs_.emplace_back(path, n, blockSize_, alloc_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::new_run_file
+        () -> std::filesystem::path
+    {
+        auto const path = directory_ / ( "mix_ds_run_" + std::to_string(id_)
+                                       + "_" + std::to_string(fileCounter_++) + ".bin" );
+
+        // Created exclusively so that a file of another heap is never truncated.
+        auto const file = std::fopen(path.string().c_str(), "wbx");
+        if (!file)
+        {
+            throw std::runtime_error("Failed to create " + path.string() + ", it may already exist.");
+        }
+        std::fclose(file);
+
+        return path;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::rebuild_tree
+        () -> void
+    {
+        tree_ = loser_tree<run_less>(runs_.size(), run_less {&runs_});
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::insert_min_first
+        () const -> bool
+    {
+        if (runs_.empty() || runs_[tree_.winner()].empty())
+        {
+            return true;
+        }
+
+        return !insertHeap_.empty()
+            && Compare () (insertHeap_.front(), runs_[tree_.winner()].head());
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::empty_check
+        () const -> void
+    {
+        if (this->empty())
+        {
+            throw std::out_of_range("Heap is empty!");
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::run_less::operator()
+        (size_type const lhs, size_type const rhs) const -> bool
+    {
+        auto const& l = (*runs_)[lhs];
+        auto const& r = (*runs_)[rhs];
+        return !l.empty() && (r.empty() || Compare () (l.head(), r.head()));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto external_heap<T, Compare, Allocator>::heap_compare::operator()
+        (T const& lhs, T const& rhs) const -> bool
+    {
+        return Compare () (rhs, lhs);
+    }
+}
+
+#endif
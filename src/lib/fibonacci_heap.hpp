@@ -455,7 +455,7 @@ namespace mix::ds
     auto fib_heap_iterator<T, Compare, Allocator, IsConst>::operator=
         (fib_heap_iterator other) -> fib_heap_iterator&
     {
-        swap(*this, other);
+        this->swap(other);
         return *this;
     }
 
@@ -597,20 +597,14 @@ namespace mix::ds
     fibonacci_heap<T, Compare, Allocator>::~fibonacci_heap
         ()
     {
-        this->for_each_node([this](auto const node)
-        {
-            this->delete_node(node);
-        });
-
-        root_ = nullptr;
-        size_ = 0;
+        this->clear();
     }
 
     template<class T, class Compare, class Allocator>
     auto fibonacci_heap<T, Compare, Allocator>::operator=
         (fibonacci_heap<T, Compare, Allocator> other) noexcept -> fibonacci_heap&
     {
-        swap(*this, other);
+        this->swap(other);
         return *this;
     }
 
@@ -793,7 +787,13 @@ namespace mix::ds
     auto fibonacci_heap<T, Compare, Allocator>::clear
         () -> void
     {
-        *this = fibonacci_heap();
+        this->for_each_node([this](auto const node)
+        {
+            this->delete_node(node);
+        });
+
+        root_ = nullptr;
+        size_ = 0;
     }
 
     template<class T, class Compare, class Allocator>
@@ -828,14 +828,14 @@ namespace mix::ds
     auto fibonacci_heap<T, Compare, Allocator>::cbegin
         () const -> const_iterator
     {
-        return iterator(root_);
+        return const_iterator(root_);
     }
 
     template<class T, class Compare, class Allocator>
     auto fibonacci_heap<T, Compare, Allocator>::cend
         () const -> const_iterator
     {
-        return iterator();
+        return const_iterator();
     }
 
     template<class T, class Compare, class Allocator>
@@ -867,8 +867,10 @@ namespace mix::ds
 
         while (it != end)
         {
-            op(it.current());
+            // Move past the node first so that op is free to delete it.
+            auto const node = it.current();
             ++it;
+            op(node);
         }
     }
 
@@ -0,0 +1,903 @@
+#ifndef MIX_DS_HOLLOW_HEAP_HPP
+#define MIX_DS_HOLLOW_HEAP_HPP
+
+#include <functional>
+#include <utility>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <queue>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+namespace mix::ds
+{
+    /**
+        Node of a hollow heap. Node is hollow if it has no item.
+     */
+    template<class T>
+    class hollow_node;
+
+    /**
+        Element of a hollow heap. It moves to a new node on decrease_key
+        so handles point to items rather than to nodes.
+     */
+    template<class T>
+    class hollow_item
+    {
+    public:
+        template<class... Args>
+        hollow_item (std::piecewise_construct_t, Args&&... args);
+
+        T               data_;
+        hollow_node<T>* node_;
+    };
+
+    template<class T>
+    class hollow_node
+    {
+    public:
+        using rank_t = unsigned int;
+
+    public:
+        hollow_node (hollow_item<T>* const item);
+
+        auto is_hollow () const -> bool;
+
+        hollow_item<T>* item_;
+        hollow_node*    child_;
+        hollow_node*    next_;
+        hollow_node*    secondParent_;
+        rank_t          rank_;
+    };
+
+    /**
+        Iterator of the hollow heap.
+     */
+    template<class T, class Compare, class Allocator, bool IsConst>
+    class hollow_heap_iterator;
+
+    /**
+        Hollow heap.
+     */
+    template< class T
+            , class Compare   = std::less<T>
+            , class Allocator = std::allocator<T> >
+    class hollow_heap;
+
+    /**
+        Item handle that is returned after an insertion
+        and can be used for decrease_key and erase.
+     */
+    template<class T, class Compare, class Allocator>
+    class hollow_heap_handle
+    {
+    public:
+        auto operator*  ()       -> T&;
+        auto operator*  () const -> T const&;
+        auto operator-> ()       -> T*;
+        auto operator-> () const -> T const*;
+
+    private:
+        using item_t = hollow_item<T>;
+        friend class hollow_heap<T, Compare, Allocator>;
+        hollow_heap_handle(item_t* const item);
+        item_t* item_;
+    };
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    class hollow_heap_iterator
+    {
+    public:
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::conditional_t<IsConst, T const, T>;
+        using pointer           = value_type*;
+        using reference         = value_type&;
+        using iterator_category = std::forward_iterator_tag;
+        using node_t            = hollow_node<T>;
+
+    public:
+        hollow_heap_iterator () = default;
+        hollow_heap_iterator (node_t* const root);
+
+        auto operator++ ()       -> hollow_heap_iterator&;
+        auto operator++ (int)    -> hollow_heap_iterator;
+        auto operator*  () const -> reference;
+        auto operator-> () const -> pointer;
+        auto operator== (hollow_heap_iterator const&) const -> bool;
+        auto operator!= (hollow_heap_iterator const&) const -> bool;
+
+    private:
+        auto push_children (node_t* const node) -> void;
+        auto skip_hollow   ()                   -> void;
+
+    private:
+        std::queue<node_t*> queue_;
+    };
+
+    /**
+        Hollow heap (Hansen, Kaplan, Tarjan, Zwick) with two parents.
+        Instead of moving the subtree on decrease_key the item is moved into
+        a new node and the old node is left hollow in place. Hollow nodes
+        are destroyed lazily in delete_min. Erase of an item other than
+        the minimum only makes its node hollow.
+        Unlike std::priority_queue in this heap an element "which is less"
+        has a higher priority.
+
+        @tparam T           The type of the stored elements.
+        @tparam Compare     Type providing a strict weak ordering.
+                            See https://en.cppreference.com/w/cpp/named_req/Compare
+        @tparam Allocator   Allocator. See https://en.cppreference.com/w/cpp/named_req/Allocator
+     */
+    template<class T, class Compare, class Allocator>
+    class hollow_heap
+    {
+    public:
+        using node_t            = hollow_node<T>;
+        using item_t            = hollow_item<T>;
+        using handle_t          = hollow_heap_handle<T, Compare, Allocator>;
+        using value_type        = T;
+        using reference         = T&;
+        using const_reference   = T const&;
+        using size_type         = std::size_t;
+        using difference_type   = std::ptrdiff_t;
+        using iterator          = hollow_heap_iterator<T, Compare, Allocator, false>;
+        using const_iterator    = hollow_heap_iterator<T, Compare, Allocator, true>;
+        using type_alloc_traits = std::allocator_traits<Allocator>;
+        using node_alloc_traits = typename type_alloc_traits::template rebind_traits<node_t>;
+        using node_allocator    = typename type_alloc_traits::template rebind_alloc<node_t>;
+        using item_alloc_traits = typename type_alloc_traits::template rebind_traits<item_t>;
+        using item_allocator    = typename type_alloc_traits::template rebind_alloc<item_t>;
+        using node_map          = std::unordered_map<node_t const*, node_t*>;
+
+    public:
+        hollow_heap  (Allocator const& alloc = Allocator());
+        hollow_heap  (hollow_heap const& other);
+        hollow_heap  (hollow_heap&& other) noexcept;
+        ~hollow_heap ();
+
+        auto operator= (hollow_heap other) noexcept -> hollow_heap&;
+
+        template<class... Args>
+        auto emplace      (Args&&... args)            -> handle_t;
+        auto insert       (value_type const& value)   -> handle_t;
+        auto insert       (value_type&& value)        -> handle_t;
+        auto delete_min   ()                          -> void;
+        auto find_min     ()                          -> reference;
+        auto find_min     () const                    -> const_reference;
+        auto decrease_key (handle_t const handle)     -> void;
+        auto meld         (hollow_heap rhs)           -> hollow_heap&;
+        auto erase        (handle_t const handle)     -> void;
+        auto swap         (hollow_heap& rhs) noexcept -> void;
+        auto empty        () const                    -> bool;
+        auto size         () const                    -> size_type;
+        auto max_size     () const                    -> size_type;
+        auto clear        ()                          -> void;
+        auto begin        ()                          -> iterator;
+        auto end          ()                          -> iterator;
+        auto begin        () const                    -> const_iterator;
+        auto end          () const                    -> const_iterator;
+        auto cbegin       () const                    -> const_iterator;
+        auto cend         () const                    -> const_iterator;
+
+    private:
+        template<class... Args>
+        auto new_item    (Args&&... args)           -> item_t*;
+        auto new_node    (item_t* const item)       -> node_t*;
+        auto delete_item (item_t* const item)       -> void;
+        auto delete_node (node_t* const node)       -> void;
+        auto insert_impl (item_t* const item)       -> handle_t;
+        auto erase_impl  (item_t* const item)       -> void;
+        auto rebuild     ()                         -> void;
+        auto empty_check () const                   -> void;
+        auto deep_copy   (hollow_heap const& other) -> node_t*;
+
+        template<class NodeOp>
+        auto for_each_node (NodeOp op) const -> void;
+
+        static auto link      (node_t* const lhs, node_t* const rhs)      -> node_t*;
+        static auto add_child (node_t* const child, node_t* const parent) -> void;
+
+    private:
+        node_allocator       nodeAlloc_;
+        item_allocator       itemAlloc_;
+        node_t*              root_;
+        size_type            size_;
+        std::vector<node_t*> ranks_;
+    };
+
+    template<class T, class Compare, class Allocator>
+    auto meld ( hollow_heap<T, Compare, Allocator>
+              , hollow_heap<T, Compare, Allocator> ) noexcept
+              -> hollow_heap<T, Compare, Allocator>;
+
+    template<class T, class Compare, class Allocator>
+    auto swap ( hollow_heap<T, Compare, Allocator>&
+              , hollow_heap<T, Compare, Allocator>& ) noexcept -> void;
+
+    template<class T, class Compare, class Allocator>
+    auto operator== ( hollow_heap<T, Compare, Allocator> const&
+                    , hollow_heap<T, Compare, Allocator> const& ) -> bool;
+
+    template<class T, class Compare, class Allocator>
+    auto operator!= ( hollow_heap<T, Compare, Allocator> const&
+                    , hollow_heap<T, Compare, Allocator> const& ) -> bool;
+
+/// definitions:
+
+    namespace hollow_impl
+    {
+        /**
+            Calls f for each son of node that belongs to it. Hollow node with
+            two parents is the last son of its second parent but is visited
+            only from the first one.
+         */
+        template<class T, class UnaryFunction>
+        auto for_each_son (hollow_node<T>* const node, UnaryFunction f) -> void
+        {
+            for (auto son = node->child_; son; son = son->next_)
+            {
+                if (son->secondParent_ == node)
+                {
+                    break;
+                }
+
+                f(son);
+            }
+        }
+    }
+
+// hollow_item definition:
+
+    template<class T>
+    template<class... Args>
+    hollow_item<T>::hollow_item(std::piecewise_construct_t, Args&&... args) :
+        data_ (std::forward<Args>(args)...),
+        node_ (nullptr)
+    {
+    }
+
+// hollow_node definition:
+
+    template<class T>
+    hollow_node<T>::hollow_node(hollow_item<T>* const item) :
+        item_         (item),
+        child_        (nullptr),
+        next_         (nullptr),
+        secondParent_ (nullptr),
+        rank_         (0)
+    {
+    }
+
+    template<class T>
+    auto hollow_node<T>::is_hollow
+        () const -> bool
+    {
+        return !item_;
+    }
+
+// hollow_heap_handle definition:
+
+    template<class T, class Compare, class Allocator>
+    hollow_heap_handle<T, Compare, Allocator>::hollow_heap_handle(item_t* const item) :
+        item_ (item)
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap_handle<T, Compare, Allocator>::operator*
+        () -> T&
+    {
+        return item_->data_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap_handle<T, Compare, Allocator>::operator*
+        () const -> T const&
+    {
+        return item_->data_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap_handle<T, Compare, Allocator>::operator->
+        () -> T*
+    {
+        return std::addressof(**this);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap_handle<T, Compare, Allocator>::operator->
+        () const -> T const*
+    {
+        return std::addressof(**this);
+    }
+
+// hollow_heap_iterator definition:
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    hollow_heap_iterator<T, Compare, Allocator, IsConst>::hollow_heap_iterator
+        (node_t* const root) :
+        queue_ (std::deque {root})
+    {
+        this->skip_hollow();
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto hollow_heap_iterator<T, Compare, Allocator, IsConst>::operator++
+        () -> hollow_heap_iterator&
+    {
+        this->push_children(queue_.front());
+        queue_.pop();
+        this->skip_hollow();
+        return *this;
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto hollow_heap_iterator<T, Compare, Allocator, IsConst>::operator++
+        (int) -> hollow_heap_iterator
+    {
+        auto const ret = *this;
+        ++(*this);
+        return ret;
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto hollow_heap_iterator<T, Compare, Allocator, IsConst>::operator*
+        () const -> reference
+    {
+        return queue_.front()->item_->data_;
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto hollow_heap_iterator<T, Compare, Allocator, IsConst>::operator->
+        () const -> pointer
+    {
+        return std::addressof(**this);
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto hollow_heap_iterator<T, Compare, Allocator, IsConst>::operator==
+        (hollow_heap_iterator const& rhs) const -> bool
+    {
+        return (queue_.empty() && rhs.queue_.empty())
+            || (queue_.size()  == rhs.queue_.size()
+            &&  queue_.front() == rhs.queue_.front());
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto hollow_heap_iterator<T, Compare, Allocator, IsConst>::operator!=
+        (hollow_heap_iterator const& rhs) const -> bool
+    {
+        return !(*this == rhs);
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto hollow_heap_iterator<T, Compare, Allocator, IsConst>::push_children
+        (node_t* const node) -> void
+    {
+        hollow_impl::for_each_son(node, [this](auto const son)
+        {
+            queue_.push(son);
+        });
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto hollow_heap_iterator<T, Compare, Allocator, IsConst>::skip_hollow
+        () -> void
+    {
+        while (!queue_.empty() && queue_.front()->is_hollow())
+        {
+            this->push_children(queue_.front());
+            queue_.pop();
+        }
+    }
+
+// hollow_heap definition:
+
+    template<class T, class Compare, class Allocator>
+    hollow_heap<T, Compare, Allocator>::hollow_heap
+        (Allocator const& alloc) :
+        nodeAlloc_ (alloc),
+        itemAlloc_ (alloc),
+        root_      (nullptr),
+        size_      (0),
+        ranks_     ()
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    hollow_heap<T, Compare, Allocator>::hollow_heap
+        (hollow_heap const& other) :
+        nodeAlloc_ (other.nodeAlloc_),
+        itemAlloc_ (other.itemAlloc_),
+        root_      (this->deep_copy(other)),
+        size_      (other.size_),
+        ranks_     ()
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    hollow_heap<T, Compare, Allocator>::hollow_heap
+        (hollow_heap&& other) noexcept :
+        nodeAlloc_ (std::move(other.nodeAlloc_)),
+        itemAlloc_ (std::move(other.itemAlloc_)),
+        root_      (std::exchange(other.root_, nullptr)),
+        size_      (std::exchange(other.size_, 0)),
+        ranks_     (std::move(other.ranks_))
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    hollow_heap<T, Compare, Allocator>::~hollow_heap()
+    {
+        this->clear();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::operator=
+        (hollow_heap other) noexcept -> hollow_heap&
+    {
+        this->swap(other);
+        return *this;
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    auto hollow_heap<T, Compare, Allocator>::emplace
+        (Args&&... args) -> handle_t
+    {
+        return this->insert_impl(this->new_item(std::forward<Args>(args)...));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::insert
+        (value_type const& value) -> handle_t
+    {
+        return this->insert_impl(this->new_item(value));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::insert
+        (value_type&& value) -> handle_t
+    {
+        return this->insert_impl(this->new_item(std::move(value)));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::delete_min
+        () -> void
+    {
+        this->empty_check();
+        this->erase_impl(root_->item_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::find_min
+        () -> reference
+    {
+        this->empty_check();
+        return root_->item_->data_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::find_min
+        () const -> const_reference
+    {
+        this->empty_check();
+        return root_->item_->data_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::decrease_key
+        (handle_t const handle) -> void
+    {
+        auto const item    = handle.item_;
+        auto const oldNode = item->node_;
+
+        if (oldNode == root_)
+        {
+            return;
+        }
+
+        // Old node stays in place as hollow and becomes the only son of the new one.
+        auto const node        = this->new_node(item);
+        oldNode->item_         = nullptr;
+        oldNode->secondParent_ = node;
+        node->child_           = oldNode;
+        node->rank_            = oldNode->rank_ > 2 ? oldNode->rank_ - 2 : 0;
+
+        root_ = hollow_heap::link(node, root_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::meld
+        (hollow_heap rhs) -> hollow_heap&
+    {
+        auto const otherRoot = std::exchange(rhs.root_, nullptr);
+
+        if (root_ && otherRoot)
+        {
+            root_ = hollow_heap::link(root_, otherRoot);
+        }
+        else if (!root_)
+        {
+            root_ = otherRoot;
+        }
+
+        size_ += std::exchange(rhs.size_, 0);
+        return *this;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::erase
+        (handle_t const handle) -> void
+    {
+        this->erase_impl(handle.item_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::swap
+        (hollow_heap& rhs) noexcept -> void
+    {
+        using std::swap;
+        swap(root_, rhs.root_);
+        swap(size_, rhs.size_);
+        swap(ranks_, rhs.ranks_);
+
+        if constexpr (node_alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(nodeAlloc_, rhs.nodeAlloc_);
+        }
+
+        if constexpr (item_alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(itemAlloc_, rhs.itemAlloc_);
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::empty
+        () const -> bool
+    {
+        return 0 == this->size();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::size
+        () const -> size_type
+    {
+        return size_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::max_size
+        () const -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::clear
+        () -> void
+    {
+        this->for_each_node([this](auto const node)
+        {
+            if (!node->is_hollow())
+            {
+                this->delete_item(node->item_);
+            }
+            this->delete_node(node);
+        });
+
+        root_ = nullptr;
+        size_ = 0;
+        ranks_.clear();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::begin
+        () -> iterator
+    {
+        return root_ ? iterator(root_) : iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::end
+        () -> iterator
+    {
+        return iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::begin
+        () const -> const_iterator
+    {
+        return this->cbegin();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::end
+        () const -> const_iterator
+    {
+        return this->cend();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::cbegin
+        () const -> const_iterator
+    {
+        return root_ ? const_iterator(root_) : const_iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::cend
+        () const -> const_iterator
+    {
+        return const_iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    auto hollow_heap<T, Compare, Allocator>::new_item
+        (Args&&... args) -> item_t*
+    {
+        auto const p = item_alloc_traits::allocate(itemAlloc_, 1);
+        item_alloc_traits::construct(itemAlloc_, p, std::piecewise_construct, std::forward<Args>(args)...);
+        return p;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::new_node
+        (item_t* const item) -> node_t*
+    {
+        auto const p = node_alloc_traits::allocate(nodeAlloc_, 1);
+        node_alloc_traits::construct(nodeAlloc_, p, item);
+        item->node_ = p;
+        return p;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::delete_item
+        (item_t* const item) -> void
+    {
+        item_alloc_traits::destroy(itemAlloc_, item);
+        item_alloc_traits::deallocate(itemAlloc_, item, 1);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::delete_node
+        (node_t* const node) -> void
+    {
+        node_alloc_traits::destroy(nodeAlloc_, node);
+        node_alloc_traits::deallocate(nodeAlloc_, node, 1);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::insert_impl
+        (item_t* const item) -> handle_t
+    {
+        auto const node = this->new_node(item);
+        root_ = root_ ? hollow_heap::link(root_, node) : node;
+        ++size_;
+        return handle_t(item);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::erase_impl
+        (item_t* const item) -> void
+    {
+        item->node_->item_ = nullptr;
+        this->delete_item(item);
+        --size_;
+
+        // Hollow nodes other than the root are removed lazily.
+        if (root_->is_hollow())
+        {
+            this->rebuild();
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::rebuild
+        () -> void
+    {
+        auto maxRank  = 0u;
+        auto toDelete = root_;
+        toDelete->next_ = nullptr;
+        root_           = nullptr;
+
+        // Full sons of destroyed hollow nodes are linked by rank,
+        // hollow sons that lose their last parent are destroyed as well.
+        while (toDelete)
+        {
+            auto const parent = toDelete;
+            auto son          = parent->child_;
+            toDelete          = toDelete->next_;
+
+            while (son)
+            {
+                auto node = son;
+                son       = son->next_;
+
+                if (node->is_hollow())
+                {
+                    if (!node->secondParent_)
+                    {
+                        node->next_ = toDelete;
+                        toDelete    = node;
+                    }
+                    else
+                    {
+                        if (node->secondParent_ == parent)
+                        {
+                            son = nullptr;
+                        }
+                        else
+                        {
+                            node->next_ = nullptr;
+                        }
+                        node->secondParent_ = nullptr;
+                    }
+                }
+                else
+                {
+                    while (node->rank_ < ranks_.size() && ranks_[node->rank_])
+                    {
+                        auto const other = std::exchange(ranks_[node->rank_], nullptr);
+                        node = hollow_heap::link(node, other);
+                        ++node->rank_;
+                    }
+
+                    if (node->rank_ >= ranks_.size())
+                    {
+                        ranks_.resize(node->rank_ + 1, nullptr);
+                    }
+
+                    ranks_[node->rank_] = node;
+                    maxRank = std::max(maxRank, node->rank_ + 1);
+                }
+            }
+
+            this->delete_node(parent);
+        }
+
+        for (auto rank = 0u; rank < maxRank; ++rank)
+        {
+            if (ranks_[rank])
+            {
+                auto const node = std::exchange(ranks_[rank], nullptr);
+                node->next_ = nullptr;
+                root_ = root_ ? hollow_heap::link(root_, node) : node;
+            }
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::empty_check
+        () const -> void
+    {
+        if (this->empty())
+        {
+            throw std::out_of_range("Heap is empty!");
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::deep_copy
+        (hollow_heap const& other) -> node_t*
+    {
+        if (!other.root_)
+        {
+            return nullptr;
+        }
+
+        auto map = node_map();
+        other.for_each_node([&map, this](auto const node)
+        {
+            auto const item = node->is_hollow() ? nullptr : this->new_item(node->item_->data_);
+            auto const copy = node_alloc_traits::allocate(nodeAlloc_, 1);
+            node_alloc_traits::construct(nodeAlloc_, copy, *node);
+            copy->item_ = item;
+            if (item)
+            {
+                item->node_ = copy;
+            }
+            map.emplace(node, copy);
+        });
+        map.emplace(nullptr, nullptr);
+
+        for (auto [original, copy] : map)
+        {
+            if (original)
+            {
+                copy->child_        = map.at(original->child_);
+                copy->next_         = map.at(original->next_);
+                copy->secondParent_ = map.at(original->secondParent_);
+            }
+        }
+
+        return map.at(other.root_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class NodeOp>
+    auto hollow_heap<T, Compare, Allocator>::for_each_node
+        (NodeOp op) const -> void
+    {
+        if (!root_)
+        {
+            return;
+        }
+
+        // Sons are collected first so that op is free to delete the node.
+        auto stack = std::vector<node_t*> {root_};
+        while (!stack.empty())
+        {
+            auto const node = stack.back();
+            stack.pop_back();
+            hollow_impl::for_each_son(node, [&stack](auto const son)
+            {
+                stack.emplace_back(son);
+            });
+            op(node);
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::link
+        (node_t* const lhs, node_t* const rhs) -> node_t*
+    {
+        if (Compare () (rhs->item_->data_, lhs->item_->data_))
+        {
+            hollow_heap::add_child(lhs, rhs);
+            return rhs;
+        }
+        else
+        {
+            hollow_heap::add_child(rhs, lhs);
+            return lhs;
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto hollow_heap<T, Compare, Allocator>::add_child
+        (node_t* const child, node_t* const parent) -> void
+    {
+        child->next_   = parent->child_;
+        parent->child_ = child;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto meld ( hollow_heap<T, Compare, Allocator> lhs
+              , hollow_heap<T, Compare, Allocator> rhs ) noexcept
+              -> hollow_heap<T, Compare, Allocator>
+    {
+        lhs.meld(std::move(rhs));
+        return hollow_heap<T, Compare, Allocator>(std::move(lhs));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto swap ( hollow_heap<T, Compare, Allocator>& lhs
+              , hollow_heap<T, Compare, Allocator>& rhs ) noexcept -> void
+    {
+        lhs.swap(rhs);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto operator== ( hollow_heap<T, Compare, Allocator> const& lhs
+                    , hollow_heap<T, Compare, Allocator> const& rhs ) -> bool
+    {
+        return lhs.size() == rhs.size()
+            && std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto operator!= ( hollow_heap<T, Compare, Allocator> const& lhs
+                    , hollow_heap<T, Compare, Allocator> const& rhs ) -> bool
+    {
+        return ! (lhs == rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,510 @@
+#ifndef MIX_DS_INTRUSIVE_PAIRING_HEAP_HPP
+#define MIX_DS_INTRUSIVE_PAIRING_HEAP_HPP
+
+#include "pairing_heap.hpp"
+
+#include <functional>
+#include <utility>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mix::ds
+{
+    /**
+        Intrusive pairing heap.
+     */
+    template< class T
+            , class Compare   = std::less<T>
+            , class MergeMode = merge_modes::two_pass
+            , class Tag       = void >
+    class intrusive_pairing_heap;
+
+    /**
+        Base hook of the intrusive pairing heap. A type derived from it
+        can be linked into one intrusive_pairing_heap at a time. Derive from
+        several hooks with different tags to be in several heaps at once.
+        Links are not copied with the object.
+     */
+    template<class Tag = void>
+    class pairing_hook
+    {
+    public:
+        pairing_hook  () noexcept;
+        pairing_hook  (pairing_hook const&) noexcept;
+        auto operator= (pairing_hook const&) noexcept -> pairing_hook&;
+
+        template<class, class, class, class>
+        friend class intrusive_pairing_heap;
+
+    private:
+        auto unlink () noexcept -> void;
+
+    private:
+        pairing_hook* parent_;
+        pairing_hook* left_;
+        pairing_hook* right_;
+    };
+
+    /**
+        Pairing heap that links objects derived from pairing_hook<Tag>
+        instead of allocating nodes. Heap does not own the objects. Linked object
+        must not be moved or destroyed until it is removed from the heap.
+        None of the operations allocates.
+
+        @tparam T           The type of the stored elements, derived from pairing_hook<Tag>.
+        @tparam Compare     Type providing a strict weak ordering.
+                            See https://en.cppreference.com/w/cpp/named_req/Compare
+        @tparam MergeMode   See the merge_modes namespace in pairing_heap.hpp.
+        @tparam Tag         Tag of the hook that is used by this heap.
+     */
+    template<class T, class Compare, class MergeMode, class Tag>
+    class intrusive_pairing_heap
+    {
+    public:
+        using hook_t          = pairing_hook<Tag>;
+        using value_type      = T;
+        using reference       = T&;
+        using const_reference = T const&;
+        using size_type       = std::size_t;
+
+        static_assert( std::is_base_of_v<hook_t, T>
+                     , "T must be derived from pairing_hook<Tag>." );
+
+    public:
+        intrusive_pairing_heap  ();
+        intrusive_pairing_heap  (intrusive_pairing_heap const&) = delete;
+        intrusive_pairing_heap  (intrusive_pairing_heap&& other) noexcept;
+
+        auto operator= (intrusive_pairing_heap other) noexcept -> intrusive_pairing_heap&;
+
+        auto insert       (reference value)                      -> void;
+        auto delete_min   ()                                     -> void;
+        auto find_min     ()                                     -> reference;
+        auto find_min     () const                               -> const_reference;
+        auto decrease_key (reference value)                      -> void;
+        auto erase        (reference value)                      -> void;
+        auto meld         (intrusive_pairing_heap rhs)           -> intrusive_pairing_heap&;
+        auto swap         (intrusive_pairing_heap& rhs) noexcept -> void;
+        auto empty        () const                               -> bool;
+        auto size         () const                               -> size_type;
+        auto max_size     () const                               -> size_type;
+        auto clear        ()                                     -> void;
+
+    private:
+        auto empty_check () const -> void;
+
+        template<class Cmp = Compare>
+        auto dec_key_impl (hook_t* const node) -> void;
+
+        template<class Cmp = Compare>
+        static auto pair        (hook_t* const lhs, hook_t* const rhs)         -> hook_t*;
+        static auto merge       (hook_t* const first)                          -> hook_t*;
+        static auto merge       (hook_t* const first, merge_modes::two_pass)   -> hook_t*;
+        static auto merge       (hook_t* const first, merge_modes::fifo_queue) -> hook_t*;
+        static auto first_pass  (hook_t* first)                                -> hook_t*;
+        static auto second_pass (hook_t* last)                                 -> hook_t*;
+        static auto is_left_son (hook_t* const node)                           -> bool;
+        static auto value       (hook_t* const node)                           -> reference;
+
+    private:
+        hook_t*   root_;
+        size_type size_;
+    };
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto swap ( intrusive_pairing_heap<T, Compare, MergeMode, Tag>&
+              , intrusive_pairing_heap<T, Compare, MergeMode, Tag>& ) noexcept -> void;
+
+/// definitions:
+
+// pairing_hook definition:
+
+    template<class Tag>
+    pairing_hook<Tag>::pairing_hook
+        () noexcept :
+        parent_ (nullptr),
+        left_   (nullptr),
+        right_  (nullptr)
+    {
+    }
+
+    template<class Tag>
+    pairing_hook<Tag>::pairing_hook
+        (pairing_hook const&) noexcept :
+        pairing_hook ()
+    {
+    }
+
+    template<class Tag>
+    auto pairing_hook<Tag>::operator=
+        (pairing_hook const&) noexcept -> pairing_hook&
+    {
+        return *this;
+    }
+
+    template<class Tag>
+    auto pairing_hook<Tag>::unlink
+        () noexcept -> void
+    {
+        parent_ = nullptr;
+        left_   = nullptr;
+        right_  = nullptr;
+    }
+
+// intrusive_pairing_heap definition:
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    intrusive_pairing_heap<T, Compare, MergeMode, Tag>::intrusive_pairing_heap
+        () :
+        root_ (nullptr),
+        size_ (0)
+    {
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    intrusive_pairing_heap<T, Compare, MergeMode, Tag>::intrusive_pairing_heap
+        (intrusive_pairing_heap&& other) noexcept :
+        root_ (std::exchange(other.root_, nullptr)),
+        size_ (std::exchange(other.size_, 0))
+    {
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::operator=
+        (intrusive_pairing_heap other) noexcept -> intrusive_pairing_heap&
+    {
+        this->swap(other);
+        return *this;
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::insert
+        (reference value) -> void
+    {
+        auto const node = static_cast<hook_t*>(std::addressof(value));
+        node->unlink();
+        root_ = this->empty() ? node : intrusive_pairing_heap::pair(root_, node);
+        ++size_;
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::delete_min
+        () -> void
+    {
+        this->empty_check();
+        auto const oldRoot = root_;
+
+        if (1 == this->size())
+        {
+            root_ = nullptr;
+        }
+        else
+        {
+            root_->left_->parent_ = nullptr;
+            root_ = intrusive_pairing_heap::merge(root_->left_);
+        }
+
+        --size_;
+        oldRoot->unlink();
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::find_min
+        () -> reference
+    {
+        this->empty_check();
+        return intrusive_pairing_heap::value(root_);
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::find_min
+        () const -> const_reference
+    {
+        this->empty_check();
+        return intrusive_pairing_heap::value(root_);
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::decrease_key
+        (reference value) -> void
+    {
+        this->dec_key_impl(static_cast<hook_t*>(std::addressof(value)));
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::erase
+        (reference value) -> void
+    {
+        this->dec_key_impl<aux_impl::always_true_cmp>(static_cast<hook_t*>(std::addressof(value)));
+        this->delete_min();
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::meld
+        (intrusive_pairing_heap rhs) -> intrusive_pairing_heap&
+    {
+        auto const otherRoot = std::exchange(rhs.root_, nullptr);
+
+        if (root_ && otherRoot)
+        {
+            root_ = intrusive_pairing_heap::pair(root_, otherRoot);
+        }
+        else if (!root_)
+        {
+            root_ = otherRoot;
+        }
+
+        size_ += std::exchange(rhs.size_, 0);
+        return *this;
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::swap
+        (intrusive_pairing_heap& rhs) noexcept -> void
+    {
+        using std::swap;
+        swap(root_, rhs.root_);
+        swap(size_, rhs.size_);
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::empty
+        () const -> bool
+    {
+        return 0 == this->size();
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::size
+        () const -> size_type
+    {
+        return size_;
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::max_size
+        () const -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::clear
+        () -> void
+    {
+        // Objects are not owned, links are reset on their next insert.
+        root_ = nullptr;
+        size_ = 0;
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::empty_check
+        () const -> void
+    {
+        if (this->empty())
+        {
+            throw std::out_of_range("Heap is empty!");
+        }
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    template<class Cmp>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::dec_key_impl
+        (hook_t* const node) -> void
+    {
+        if (node == root_)
+        {
+            return;
+        }
+
+        if (intrusive_pairing_heap::is_left_son(node))
+        {
+            node->parent_->left_ = node->right_;
+        }
+        else
+        {
+            node->parent_->right_ = node->right_;
+        }
+
+        if (node->right_)
+        {
+            node->right_->parent_ = node->parent_;
+        }
+
+        node->parent_ = nullptr;
+        node->right_  = nullptr;
+
+        root_ = intrusive_pairing_heap::pair<Cmp>(node, root_);
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    template<class Cmp>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::pair
+        (hook_t* const lhs, hook_t* const rhs) -> hook_t*
+    {
+        auto const areOrdered = Cmp () (intrusive_pairing_heap::value(lhs), intrusive_pairing_heap::value(rhs));
+        auto const parent     = areOrdered ? lhs : rhs;
+        auto const son        = areOrdered ? rhs : lhs;
+        auto const oldLeftSon = parent->left_;
+
+        son->parent_  = parent;
+        son->right_   = oldLeftSon;
+        parent->left_ = son;
+
+        if (oldLeftSon)
+        {
+            oldLeftSon->parent_ = son;
+        }
+
+        return parent;
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::merge
+        (hook_t* const first) -> hook_t*
+    {
+        return intrusive_pairing_heap::merge(first, MergeMode());
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::merge
+        (hook_t* const first, merge_modes::two_pass) -> hook_t*
+    {
+        return intrusive_pairing_heap::second_pass(intrusive_pairing_heap::first_pass(first));
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::merge
+        (hook_t* const first, merge_modes::fifo_queue) -> hook_t*
+    {
+        // Sons are paired from the left, results are appended
+        // to the end of the same list, so no queue needs to be allocated.
+        auto head = first;
+        auto tail = first;
+        while (tail->right_)
+        {
+            tail = tail->right_;
+        }
+
+        while (head != tail)
+        {
+            auto const lhs = head;
+            auto const rhs = head->right_;
+            auto const end = rhs == tail;
+            head = rhs->right_;
+
+            lhs->right_  = nullptr;
+            lhs->parent_ = nullptr;
+            rhs->right_  = nullptr;
+            rhs->parent_ = nullptr;
+
+            auto const paired = intrusive_pairing_heap::pair(lhs, rhs);
+            if (end)
+            {
+                return paired;
+            }
+
+            tail->right_ = paired;
+            tail         = paired;
+        }
+
+        head->parent_ = nullptr;
+        return head;
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::first_pass
+        (hook_t* first) -> hook_t*
+    {
+        auto prev   = static_cast<hook_t*>(nullptr);
+        auto paired = static_cast<hook_t*>(nullptr);
+        auto next   = first;
+        auto second = first->right_;
+
+        for (;;)
+        {
+            first = next;
+            if (!first)
+            {
+                return prev;
+            }
+
+            second = first->right_;
+            if (second)
+            {
+                next            = second->right_;
+                first->right_   = nullptr;
+                first->parent_  = nullptr;
+                second->right_  = nullptr;
+                second->parent_ = nullptr;
+                paired          = intrusive_pairing_heap::pair(first, second);
+            }
+            else
+            {
+                paired = first;
+                next   = nullptr;
+            }
+
+            if (prev)
+            {
+                prev->right_    = paired;
+                paired->parent_ = prev;
+            }
+            prev = paired;
+
+            if (next)
+            {
+                next->parent_ = nullptr;
+            }
+            else
+            {
+                return prev;
+            }
+        }
+
+        return prev;
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::second_pass
+        (hook_t* last) -> hook_t*
+    {
+        auto parent   = last->parent_;
+        last->parent_ = nullptr;
+
+        while (parent)
+        {
+            auto const next = parent->parent_;
+            parent->right_  = nullptr;
+            parent->parent_ = nullptr;
+            last            = intrusive_pairing_heap::pair(last, parent);
+            parent          = next;
+        }
+
+        return last;
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::is_left_son
+        (hook_t* const node) -> bool
+    {
+        return node->parent_ && node == node->parent_->left_;
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto intrusive_pairing_heap<T, Compare, MergeMode, Tag>::value
+        (hook_t* const node) -> reference
+    {
+        return static_cast<reference>(*node);
+    }
+
+    template<class T, class Compare, class MergeMode, class Tag>
+    auto swap ( intrusive_pairing_heap<T, Compare, MergeMode, Tag>& lhs
+              , intrusive_pairing_heap<T, Compare, MergeMode, Tag>& rhs ) noexcept -> void
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef MIX_DS_MPSC_HEAP_HPP
+#define MIX_DS_MPSC_HEAP_HPP
+
+#include "pairing_heap.hpp"
+
+#include <functional>
+#include <utility>
+#include <memory>
+#include <atomic>
+#include <cstddef>
+
+namespace mix::ds
+{
+    /**
+        Pairing heap for many producers and a single consumer.
+        Producers push into a lock-free stack of pending elements and never
+        touch the heap. Before find_min and delete_min the consumer takes the
+        whole stack with one exchange, builds a heap from it and melds it into
+        the main heap as a single subtree.
+        Insertion can be called from any thread, all other operations only from
+        the consumer thread. Allocator must be usable from several threads.
+        Unlike std::priority_queue in this heap an element "which is less"
+        has a higher priority.
+
+        @tparam T           The type of the stored elements.
+        @tparam Compare     Type providing a strict weak ordering.
+                            See https://en.cppreference.com/w/cpp/named_req/Compare
+        @tparam Allocator   Allocator. See https://en.cppreference.com/w/cpp/named_req/Allocator
+     */
+    template< class T
+            , class Compare   = std::less<T>
+            , class Allocator = std::allocator<T> >
+    class mpsc_heap
+    {
+    public:
+        using value_type      = T;
+        using reference       = T&;
+        using const_reference = T const&;
+        using size_type       = std::size_t;
+        using heap_t          = pairing_heap<T, Compare, merge_modes::two_pass, Allocator>;
+
+    public:
+        mpsc_heap  (Allocator const& alloc = Allocator());
+        ~mpsc_heap ();
+
+        mpsc_heap (mpsc_heap const&) = delete;
+        auto operator= (mpsc_heap const&) -> mpsc_heap& = delete;
+
+        template<class... Args>
+        auto emplace        (Args&&... args)          -> void;
+        auto insert         (value_type const& value) -> void;
+        auto insert         (value_type&& value)      -> void;
+        auto find_min       ()                        -> reference;
+        auto delete_min     ()                        -> void;
+        auto try_delete_min (value_type& out)         -> bool;
+        auto drain          ()                        -> size_type;
+        auto size           ()                        -> size_type;
+        auto empty          ()                        -> bool;
+
+    private:
+        struct pending_node
+        {
+            T             data_;
+            pending_node* next_;
+
+            template<class... Args>
+            pending_node (std::piecewise_construct_t, Args&&... args);
+        };
+
+        using type_alloc_traits = std::allocator_traits<Allocator>;
+        using node_alloc_traits = typename type_alloc_traits::template rebind_traits<pending_node>;
+        using node_allocator    = typename type_alloc_traits::template rebind_alloc<pending_node>;
+
+    private:
+        template<class... Args>
+        auto new_node    (Args&&... args)           -> pending_node*;
+        auto delete_node (pending_node* const node) -> void;
+
+    private:
+        // Producers write only the stack head, keep it away from the heap.
+        alignas(64) std::atomic<pending_node*> pending_;
+        alignas(64) node_allocator             alloc_;
+        heap_t                                 heap_;
+    };
+
+/// definitions:
+
+// mpsc_heap::pending_node definition:
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    mpsc_heap<T, Compare, Allocator>::pending_node::pending_node
+        (std::piecewise_construct_t, Args&&... args) :
+        data_ (std::forward<Args>(args)...),
+        next_ (nullptr)
+    {
+    }
+
+// mpsc_heap definition:
+
+    template<class T, class Compare, class Allocator>
+    mpsc_heap<T, Compare, Allocator>::mpsc_heap
+        (Allocator const& alloc) :
+        pending_ (nullptr),
+        alloc_   (alloc),
+        heap_    (alloc)
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    mpsc_heap<T, Compare, Allocator>::~mpsc_heap
+        ()
+    {
+        auto node = pending_.exchange(nullptr, std::memory_order_acquire);
+        while (node)
+        {
+            auto const next = node->next_;
+            this->delete_node(node);
+            node = next;
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    auto mpsc_heap<T, Compare, Allocator>::emplace
+        (Args&&... args) -> void
+    {
+        auto const node = this->new_node(std::forward<Args>(args)...);
+        node->next_ = pending_.load(std::memory_order_relaxed);
+
+        // Only the consumer removes nodes and it takes all of them at once,
+        // a node is never popped and pushed back so there is no ABA.
+        while (!pending_.compare_exchange_weak( node->next_, node
+                                              , std::memory_order_release
+                                              , std::memory_order_relaxed ))
+        {
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto mpsc_heap<T, Compare, Allocator>::insert
+        (value_type const& value) -> void
+    {
+        this->emplace(value);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto mpsc_heap<T, Compare, Allocator>::insert
+        (value_type&& value) -> void
+    {
+        this->emplace(std::move(value));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto mpsc_heap<T, Compare, Allocator>::find_min
+        () -> reference
+    {
+        this->drain();
+        return heap_.find_min();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto mpsc_heap<T, Compare, Allocator>::delete_min
+        () -> void
+    {
+        this->drain();
+        heap_.delete_min();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto mpsc_heap<T, Compare, Allocator>::try_delete_min
+        (value_type& out) -> bool
+    {
+        this->drain();
+        if (heap_.empty())
+        {
+            return false;
+        }
+
+        out = std::move(heap_.find_min());
+        heap_.delete_min();
+        return true;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto mpsc_heap<T, Compare, Allocator>::drain
+        () -> size_type
+    {
+        auto node = pending_.exchange(nullptr, std::memory_order_acquire);
+        if (!node)
+        {
+            return 0;
+        }
+
+        auto batch = heap_t(Allocator(alloc_));
+        while (node)
+        {
+            auto const next = node->next_;
+            batch.insert(std::move(node->data_));
+            this->delete_node(node);
+            node = next;
+        }
+
+        auto const count = batch.size();
+        heap_.meld(std::move(batch));
+        return count;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto mpsc_heap<T, Compare, Allocator>::size
+        () -> size_type
+    {
+        this->drain();
+        return heap_.size();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto mpsc_heap<T, Compare, Allocator>::empty
+        () -> bool
+    {
+        return 0 == this->size();
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    auto mpsc_heap<T, Compare, Allocator>::new_node
+        (Args&&... args) -> pending_node*
+    {
+        auto const place = node_alloc_traits::allocate(alloc_, 1);
+        node_alloc_traits::construct(alloc_, place, std::piecewise_construct, std::forward<Args>(args)...);
+        return place;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto mpsc_heap<T, Compare, Allocator>::delete_node
+        (pending_node* const node) -> void
+    {
+        node_alloc_traits::destroy(alloc_, node);
+        node_alloc_traits::deallocate(alloc_, node, 1);
+    }
+}
+
+#endif
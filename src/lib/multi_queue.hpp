@@ -0,0 +1,329 @@
+#ifndef MIX_DS_MULTI_QUEUE_HPP
+#define MIX_DS_MULTI_QUEUE_HPP
+
+#include "pairing_heap.hpp"
+
+#include <functional>
+#include <utility>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace mix::ds
+{
+    /**
+        Test-and-test-and-set lock. Waiting thread yields
+        so that it does not starve a preempted owner.
+     */
+    class spinlock
+    {
+    public:
+        auto lock     () -> void;
+        auto try_lock () -> bool;
+        auto unlock   () -> void;
+
+    private:
+        std::atomic<bool> locked_ {false};
+    };
+
+    /**
+        Relaxed concurrent priority queue (Rihani, Sanders, Dementiev).
+        Elements are spread over c * p shards where p is the number of threads
+        and c is the relaxation factor. Each shard is a pairing_heap behind
+        its own spinlock. Insert goes to a random shard, delete_min samples two
+        shards and removes the smaller of their minima. Returned element is
+        therefore not necessarily the global minimum, it is close to it on
+        average and higher c means less contention but worse quality.
+        Busy shards are skipped rather than waited for.
+        Unlike std::priority_queue in this heap an element "which is less"
+        has a higher priority.
+
+        @tparam T           The type of the stored elements.
+        @tparam Compare     Type providing a strict weak ordering.
+                            See https://en.cppreference.com/w/cpp/named_req/Compare
+        @tparam Allocator   Allocator. See https://en.cppreference.com/w/cpp/named_req/Allocator
+     */
+    template< class T
+            , class Compare   = std::less<T>
+            , class Allocator = std::allocator<T> >
+    class multi_queue
+    {
+    public:
+        using value_type      = T;
+        using reference       = T&;
+        using const_reference = T const&;
+        using size_type       = std::size_t;
+        using heap_t          = pairing_heap<T, Compare, merge_modes::two_pass, Allocator>;
+
+        /**
+            Default relaxation factor.
+         */
+        static constexpr size_type DefaultRelaxation = 2;
+
+    public:
+        multi_queue ( size_type const threadCount = std::max(1u, std::thread::hardware_concurrency())
+                    , size_type const relaxation  = DefaultRelaxation
+                    , Allocator const& alloc      = Allocator() );
+
+        multi_queue (multi_queue const&) = delete;
+        auto operator= (multi_queue const&) -> multi_queue& = delete;
+
+        template<class... Args>
+        auto emplace        (Args&&... args)          -> void;
+        auto insert         (value_type const& value) -> void;
+        auto insert         (value_type&& value)      -> void;
+        auto try_delete_min (value_type& out)         -> bool;
+        auto size           () const                  -> size_type;
+        auto empty          () const                  -> bool;
+        auto shard_count    () const                  -> size_type;
+
+    private:
+        /**
+            Shards are on separate cache lines so that
+            their locks do not share one.
+         */
+        struct alignas(64) shard
+        {
+            spinlock lock_;
+            heap_t   heap_;
+
+            shard (Allocator const& alloc);
+        };
+
+    private:
+        auto random_shard () -> shard&;
+        auto pop_locked   (shard& s, value_type& out) -> bool;
+        auto delete_scan  (value_type& out)           -> bool;
+
+        static auto rng () -> std::minstd_rand&;
+
+    private:
+        std::vector<std::unique_ptr<shard>> shards_;
+        std::atomic<size_type>              size_;
+    };
+
+/// definitions:
+
+// spinlock definition:
+
+    inline auto spinlock::lock
+        () -> void
+    {
+        while (!this->try_lock())
+        {
+            while (locked_.load(std::memory_order_relaxed))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    inline auto spinlock::try_lock
+        () -> bool
+    {
+        return !locked_.load(std::memory_order_relaxed)
+            && !locked_.exchange(true, std::memory_order_acquire);
+    }
+
+    inline auto spinlock::unlock
+        () -> void
+    {
+        locked_.store(false, std::memory_order_release);
+    }
+
+// multi_queue::shard definition:
+
+    template<class T, class Compare, class Allocator>
+    multi_queue<T, Compare, Allocator>::shard::shard
+        (Allocator const& alloc) :
+        lock_ (),
+        heap_ (alloc)
+    {
+    }
+
+// multi_queue definition:
+
+    template<class T, class Compare, class Allocator>
+    multi_queue<T, Compare, Allocator>::multi_queue
+        ( size_type const threadCount
+        , size_type const relaxation
+        , Allocator const& alloc ) :
+        shards_ (),
+        size_   (0)
+    {
+        // At least two shards so that delete_min has two to sample.
+        auto const count = std::max<size_type>(2, threadCount * relaxation);
+        shards_.reserve(count);
+        for (auto i = size_type {0}; i < count; ++i)
+        {
+            shards_.emplace_back(std::make_unique<shard>(alloc));
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    auto multi_queue<T, Compare, Allocator>::emplace
+        (Args&&... args) -> void
+    {
+        for (;;)
+        {
+            auto& s = this->random_shard();
+            if (s.lock_.try_lock())
+            {
+                s.heap_.emplace(std::forward<Args>(args)...);
+                s.lock_.unlock();
+                size_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto multi_queue<T, Compare, Allocator>::insert
+        (value_type const& value) -> void
+    {
+        this->emplace(value);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto multi_queue<T, Compare, Allocator>::insert
+        (value_type&& value) -> void
+    {
+        this->emplace(std::move(value));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto multi_queue<T, Compare, Allocator>::try_delete_min
+        (value_type& out) -> bool
+    {
+        // Few rounds of sampling, empty or busy shards only cost a retry.
+        auto constexpr Attempts = 8;
+
+        for (auto attempt = 0; attempt < Attempts; ++attempt)
+        {
+            if (0 == size_.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+
+            auto* first  = &this->random_shard();
+            auto* second = &this->random_shard();
+            if (first == second)
+            {
+                continue;
+            }
+
+            // Lock order does not matter as neither lock is waited for.
+            if (!first->lock_.try_lock())
+            {
+                continue;
+            }
+
+            if (!second->lock_.try_lock())
+            {
+                first->lock_.unlock();
+                continue;
+            }
+
+            if ( first->heap_.empty()
+              || (!second->heap_.empty() && Compare () (second->heap_.find_min(), first->heap_.find_min())) )
+            {
+                std::swap(first, second);
+            }
+
+            second->lock_.unlock();
+            auto const popped = this->pop_locked(*first, out);
+            first->lock_.unlock();
+
+            if (popped)
+            {
+                return true;
+            }
+        }
+
+        return this->delete_scan(out);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto multi_queue<T, Compare, Allocator>::size
+        () const -> size_type
+    {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto multi_queue<T, Compare, Allocator>::empty
+        () const -> bool
+    {
+        return 0 == this->size();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto multi_queue<T, Compare, Allocator>::shard_count
+        () const -> size_type
+    {
+        return shards_.size();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto multi_queue<T, Compare, Allocator>::random_shard
+        () -> shard&
+    {
+        auto const i = static_cast<size_type>(multi_queue::rng()()) % shards_.size();
+        return *shards_[i];
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto multi_queue<T, Compare, Allocator>::pop_locked
+        (shard& s, value_type& out) -> bool
+    {
+        if (s.heap_.empty())
+        {
+            return false;
+        }
+
+        out = std::move(s.heap_.find_min());
+        s.heap_.delete_min();
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto multi_queue<T, Compare, Allocator>::delete_scan
+        (value_type& out) -> bool
+    {
+        // Sampling keeps missing when only few shards are not empty.
+        while (0 != size_.load(std::memory_order_relaxed))
+        {
+            for (auto& s : shards_)
+            {
+                s->lock_.lock();
+                auto const popped = this->pop_locked(*s, out);
+                s->lock_.unlock();
+
+                if (popped)
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto multi_queue<T, Compare, Allocator>::rng
+        () -> std::minstd_rand&
+    {
+        thread_local auto engine = std::minstd_rand(static_cast<std::uint_fast32_t>(
+            std::hash<std::thread::id>()(std::this_thread::get_id())));
+        return engine;
+    }
+}
+
+#endif
@@ -10,6 +10,10 @@
 #include <tuple>
 #include <algorithm>
 #include <unordered_map>
+#include <vector>
+#include <thread>
+#include <iterator>
+#include <exception>
 
 namespace mix::ds
 {
@@ -188,6 +192,35 @@ namespace mix::ds
         auto cbegin       () const                     -> const_iterator;
         auto cend         () const                     -> const_iterator;
 
+        /**
+            Builds heap from elements in [first, last) by pairing them
+            in a balanced way. Uses linear number of comparisons and the root
+            of the resulting heap has only logarithmic number of sons.
+         */
+        template<class InputIt>
+        static auto from_range ( InputIt first
+                               , InputIt last
+                               , Allocator const& alloc = Allocator() ) -> pairing_heap;
+
+        /**
+            Same as from_range but splits [first, last) into @p threadCount parts,
+            builds subheaps on separate threads and melds them using meld_all.
+            Allocator must be usable from several threads.
+         */
+        template<class RandomIt>
+        static auto from_range_parallel ( RandomIt first
+                                        , RandomIt last
+                                        , size_type const threadCount
+                                        , Allocator const& alloc = Allocator() ) -> pairing_heap;
+
+        /**
+            Melds all heaps in @p heaps into one. Roots are paired in a balanced
+            way so that the root of the result has logarithmic number of sons.
+            Heaps in the range are left empty.
+         */
+        template<class Range>
+        static auto meld_all (Range&& heaps) -> pairing_heap;
+
     private:
         template<class... Args>
         auto new_node     (Args&&... args)            -> node_t*;
@@ -217,6 +250,8 @@ namespace mix::ds
         static auto second_pass (node_t* last)                                 -> node_t*;
         static auto fill_queue  (node_t* first)                                -> std::queue<node_t*>;
         static auto is_left_son (node_t* const node)                           -> bool;
+        static auto add_tree    (std::vector<node_t*>& trees, node_t* tree)    -> void;
+        static auto pair_trees  (std::vector<node_t*>& trees)                  -> node_t*;
 
     private:
         node_allocator alloc_;
@@ -422,20 +457,14 @@ namespace mix::ds
     template<class T, class Compare, class MergeMode, class Allocator>
     pairing_heap<T, Compare, MergeMode, Allocator>::~pairing_heap()
     {
-        this->for_each_node([this](auto const node)
-        {
-            this->delete_node(node);
-        });
-
-        root_ = nullptr;
-        size_ = 0;
+        this->clear();
     }
 
     template<class T, class Compare, class MergeMode, class Allocator>
     auto pairing_heap<T, Compare, MergeMode, Allocator>::operator=
         (pairing_heap other) noexcept -> pairing_heap&
     {
-        swap(*this, other);
+        this->swap(other);
         return *this;
     }
 
@@ -603,7 +632,13 @@ namespace mix::ds
     auto pairing_heap<T, Compare, MergeMode, Allocator>::clear
         () -> void
     {
-        *this = pairing_heap();
+        this->for_each_node([this](auto const node)
+        {
+            this->delete_node(node);
+        });
+
+        root_ = nullptr;
+        size_ = 0;
     }
 
     template<class T, class Compare, class MergeMode, class Allocator>
@@ -648,6 +683,115 @@ namespace mix::ds
         return const_iterator();
     }
 
+    template<class T, class Compare, class MergeMode, class Allocator>
+    template<class InputIt>
+    auto pairing_heap<T, Compare, MergeMode, Allocator>::from_range
+        (InputIt first, InputIt last, Allocator const& alloc) -> pairing_heap
+    {
+        auto heap  = pairing_heap(alloc);
+        auto trees = std::vector<node_t*>();
+
+        try
+        {
+            while (first != last)
+            {
+                pairing_heap::add_tree(trees, heap.new_node(*first));
+                ++heap.size_;
+                ++first;
+            }
+        }
+        catch (...)
+        {
+            heap.root_ = pairing_heap::pair_trees(trees);
+            throw;
+        }
+
+        heap.root_ = pairing_heap::pair_trees(trees);
+        return heap;
+    }
+
+    template<class T, class Compare, class MergeMode, class Allocator>
+    template<class RandomIt>
+    auto pairing_heap<T, Compare, MergeMode, Allocator>::from_range_parallel
+        (RandomIt first, RandomIt last, size_type const threadCount, Allocator const& alloc) -> pairing_heap
+    {
+        auto const count  = static_cast<size_type>(std::distance(first, last));
+        auto const parts  = std::max<size_type>(1, std::min(threadCount, count));
+        auto heaps        = std::vector<pairing_heap>(parts, pairing_heap(alloc));
+        auto errors       = std::vector<std::exception_ptr>(parts);
+        auto threads      = std::vector<std::thread>();
+        auto const build  = [&](auto const part)
+        {
+            auto const partFirst = std::next(first, static_cast<std::ptrdiff_t>(count * part / parts));
+            auto const partLast  = std::next(first, static_cast<std::ptrdiff_t>(count * (part + 1) / parts));
+            try
+            {
+                heaps[part] = pairing_heap::from_range(partFirst, partLast, alloc);
+            }
+            catch (...)
+            {
+                errors[part] = std::current_exception();
+            }
+        };
+
+        threads.reserve(parts - 1);
+        for (auto part = size_type {1}; part < parts; ++part)
+        {
+            threads.emplace_back(build, part);
+        }
+
+        build(size_type {0});
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (auto const& error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        return pairing_heap::meld_all(heaps);
+    }
+
+    template<class T, class Compare, class MergeMode, class Allocator>
+    template<class Range>
+    auto pairing_heap<T, Compare, MergeMode, Allocator>::meld_all
+        (Range&& heaps) -> pairing_heap
+    {
+        auto it  = std::begin(heaps);
+        auto end = std::end(heaps);
+
+        if (it == end)
+        {
+            return pairing_heap();
+        }
+
+        auto result = pairing_heap(std::move(*it));
+        auto trees  = std::vector<node_t*>();
+
+        if (result.root_)
+        {
+            pairing_heap::add_tree(trees, std::exchange(result.root_, nullptr));
+        }
+
+        for (++it; it != end; ++it)
+        {
+            if (it->root_)
+            {
+                pairing_heap::add_tree(trees, std::exchange(it->root_, nullptr));
+                result.size_ += std::exchange(it->size_, 0);
+            }
+        }
+
+        result.root_ = pairing_heap::pair_trees(trees);
+        return result;
+    }
+
     template<class T, class Compare, class MergeMode, class Allocator>
     template<class... Args>
     auto pairing_heap<T, Compare, MergeMode, Allocator>::new_node
@@ -777,8 +921,10 @@ namespace mix::ds
 
         while (it != end)
         {
-            op(it.current());
+            // Move past the node first so that op is free to delete it.
+            auto const node = it.current();
             ++it;
+            op(node);
         }
     }
 
@@ -814,6 +960,47 @@ namespace mix::ds
         return parent;
     }
 
+    template<class T, class Compare, class MergeMode, class Allocator>
+    auto pairing_heap<T, Compare, MergeMode, Allocator>::add_tree
+        (std::vector<node_t*>& trees, node_t* tree) -> void
+    {
+        // Works like incrementing a binary counter, trees[i] is either null
+        // or a result of 2^i pairings. Carry is paired with the next slot.
+        auto i = std::size_t {0};
+        while (i < trees.size() && trees[i])
+        {
+            tree     = pairing_heap::pair(trees[i], tree);
+            trees[i] = nullptr;
+            ++i;
+        }
+
+        if (i == trees.size())
+        {
+            trees.push_back(tree);
+        }
+        else
+        {
+            trees[i] = tree;
+        }
+    }
+
+    template<class T, class Compare, class MergeMode, class Allocator>
+    auto pairing_heap<T, Compare, MergeMode, Allocator>::pair_trees
+        (std::vector<node_t*>& trees) -> node_t*
+    {
+        auto root = static_cast<node_t*>(nullptr);
+        for (auto const tree : trees)
+        {
+            if (tree)
+            {
+                root = root ? pairing_heap::pair(root, tree) : tree;
+            }
+        }
+
+        trees.clear();
+        return root;
+    }
+
     template<class T, class Compare, class MergeMode, class Allocator>
     auto pairing_heap<T, Compare, MergeMode, Allocator>::merge
         (node_t* const first) -> node_t*
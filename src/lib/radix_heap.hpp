@@ -0,0 +1,953 @@
+#ifndef MIX_DS_RADIX_HEAP_HPP
+#define MIX_DS_RADIX_HEAP_HPP
+
+#include <functional>
+#include <utility>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <algorithm>
+
+namespace mix::ds
+{
+    /**
+        Node of a bucket list.
+     */
+    template<class T>
+    class radix_node;
+
+    /**
+        Iterator over all buckets of the heap.
+     */
+    template<class T, class Compare, class Allocator, bool IsConst>
+    class radix_heap_iterator;
+
+    /**
+        Radix heap.
+     */
+    template< class T
+            , class Compare   = std::less<T>
+            , class Allocator = std::allocator<T> >
+    class radix_heap;
+
+    using radix_key_t = std::uint64_t;
+
+    /**
+        Bucket 0 and one bucket for each bit of the key.
+     */
+    inline auto constexpr RadixBucketCount = std::size_t {65};
+
+    /**
+        Node of a bucket list.
+     */
+    template<class T>
+    class radix_node
+    {
+    public:
+        using node_t = radix_node;
+
+        template<class... Args>
+        radix_node (std::piecewise_construct_t, Args&&... args);
+
+        auto operator* ()       -> T&;
+        auto operator* () const -> T const&;
+
+        template<class, class, class>
+        friend class radix_heap;
+
+        template<class, class, class, bool>
+        friend class radix_heap_iterator;
+
+    private:
+        T             data_;
+        radix_key_t   key_;
+        node_t*       prev_;
+        node_t*       next_;
+        std::uint32_t bucket_;
+    };
+
+    /**
+        Node handle that is returned after an insertion
+        and can be used for decrease_key and erase.
+     */
+    template<class T, class Compare, class Allocator>
+    class radix_node_handle
+    {
+    public:
+        auto operator*  ()       -> T&;
+        auto operator*  () const -> T const&;
+        auto operator-> ()       -> T*;
+        auto operator-> () const -> T const*;
+
+    private:
+        using node_t = radix_node<T>;
+        friend class radix_heap<T, Compare, Allocator>;
+        radix_node_handle(node_t* const node);
+        node_t* node_;
+    };
+
+    /**
+        Iterator over all buckets of the heap.
+     */
+    template<class T, class Compare, class Allocator, bool IsConst>
+    class radix_heap_iterator
+    {
+    public:
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::conditional_t<IsConst, T const, T>;
+        using pointer           = value_type*;
+        using reference         = value_type&;
+        using iterator_category = std::forward_iterator_tag;
+        using node_t            = radix_node<T>;
+
+    public:
+        radix_heap_iterator () = default;
+        radix_heap_iterator (node_t* const* buckets, std::size_t const bucket, node_t* const node);
+
+        auto operator++ ()       -> radix_heap_iterator&;
+        auto operator++ (int)    -> radix_heap_iterator;
+        auto operator*  () const -> reference;
+        auto operator-> () const -> pointer;
+        auto operator== (radix_heap_iterator const&) const -> bool;
+        auto operator!= (radix_heap_iterator const&) const -> bool;
+
+    private:
+        friend class radix_heap<T, Compare, Allocator>;
+        auto current () const -> node_t*;
+
+    private:
+        node_t* const* buckets_ {nullptr};
+        std::size_t    bucket_  {0};
+        node_t*        node_    {nullptr};
+    };
+
+    /**
+        Monotone priority queue for non-negative integer keys.
+        Elements are kept in 65 buckets. Bucket 0 holds elements whose key
+        is equal to the key of the last minimum, bucket i holds elements whose
+        key differs from it in bit i - 1 and in no higher bit. When bucket 0
+        runs out the first non-empty bucket is redistributed into lower buckets,
+        so each element moves at most 64 times.
+
+        The key of an element is Compare::key(element) if Compare provides
+        such a static function, otherwise the element itself must be of an integral type.
+        Compare itself is not used for the ordering.
+
+        Keys passed to insert and decrease_key must not be smaller than the key
+        of the last element obtained by find_min. This holds for Dijkstra's algorithm
+        with non-negative edge costs. std::invalid_argument is thrown otherwise.
+
+        @tparam T           The type of the stored elements.
+        @tparam Compare     Type that may provide static key function.
+        @tparam Allocator   Allocator. See https://en.cppreference.com/w/cpp/named_req/Allocator
+     */
+    template<class T, class Compare, class Allocator>
+    class radix_heap
+    {
+    public:
+        using node_t            = radix_node<T>;
+        using handle_t          = radix_node_handle<T, Compare, Allocator>;
+        using value_type        = T;
+        using reference         = T&;
+        using const_reference   = T const&;
+        using size_type         = std::size_t;
+        using difference_type   = std::ptrdiff_t;
+        using iterator          = radix_heap_iterator<T, Compare, Allocator, false>;
+        using const_iterator    = radix_heap_iterator<T, Compare, Allocator, true>;
+        using type_alloc_traits = std::allocator_traits<Allocator>;
+        using node_alloc_traits = typename type_alloc_traits::template rebind_traits<node_t>;
+        using node_allocator    = typename type_alloc_traits::template rebind_alloc<node_t>;
+
+    public:
+        radix_heap  (Allocator const& alloc = Allocator());
+        radix_heap  (radix_heap const& other);
+        radix_heap  (radix_heap&& other) noexcept;
+        ~radix_heap ();
+
+        auto operator= (radix_heap other) noexcept -> radix_heap&;
+
+        template<class... Args>
+        auto emplace      (Args&&... args)           -> handle_t;
+        auto insert       (value_type const& value)  -> handle_t;
+        auto insert       (value_type&& value)       -> handle_t;
+        auto delete_min   ()                         -> void;
+        auto find_min     ()                         -> reference;
+        auto find_min     () const                   -> const_reference;
+        auto decrease_key (handle_t const handle)    -> void;
+        auto decrease_key (iterator pos)             -> void;
+        auto decrease_key (const_iterator pos)       -> void;
+        auto meld         (radix_heap rhs)           -> radix_heap&;
+        auto erase        (handle_t const handle)    -> void;
+        auto erase        (iterator pos)             -> void;
+        auto erase        (const_iterator pos)       -> void;
+        auto swap         (radix_heap& rhs) noexcept -> void;
+        auto empty        () const                   -> bool;
+        auto size         () const                   -> size_type;
+        auto max_size     () const                   -> size_type;
+        auto clear        ()                         -> void;
+        auto begin        ()                         -> iterator;
+        auto end          ()                         -> iterator;
+        auto begin        () const                   -> const_iterator;
+        auto end          () const                   -> const_iterator;
+        auto cbegin       () const                   -> const_iterator;
+        auto cend         () const                   -> const_iterator;
+
+    private:
+        using buckets_t = std::array<node_t*, RadixBucketCount>;
+
+    private:
+        template<class... Args>
+        auto new_node     (Args&&... args)         -> node_t*;
+        auto delete_node  (node_t* const node)     -> void;
+        auto insert_impl  (node_t* const node)     -> handle_t;
+        auto empty_check  () const                 -> void;
+        auto key_check    (radix_key_t const key) const -> void;
+        auto dec_key_impl (node_t* const node)     -> void;
+        auto erase_impl   (node_t* const node)     -> void;
+        auto bucket_of    (radix_key_t const key) const -> std::uint32_t;
+        auto link         (node_t* const node, std::uint32_t const bucket) const -> void;
+        auto unlink       (node_t* const node) const -> void;
+        auto pull         () const                 -> void;
+        auto take_all     ()                       -> node_t*;
+        auto first_bucket () const                 -> std::size_t;
+
+        template<class NodeOp>
+        auto for_each_node (NodeOp op) const -> void;
+
+        static auto key_of (T const& value) -> radix_key_t;
+
+    private:
+        node_allocator        alloc_;
+        mutable buckets_t     buckets_;
+        mutable std::uint64_t nonEmpty_;
+        mutable radix_key_t   last_;
+        size_type             size_;
+    };
+
+    template<class T, class Compare, class Allocator>
+    auto meld ( radix_heap<T, Compare, Allocator>
+              , radix_heap<T, Compare, Allocator> ) noexcept
+              -> radix_heap<T, Compare, Allocator>;
+
+    template<class T, class Compare, class Allocator>
+    auto swap ( radix_heap<T, Compare, Allocator>&
+              , radix_heap<T, Compare, Allocator>& ) noexcept -> void;
+
+    template<class T, class Compare, class Allocator>
+    auto operator== ( radix_heap<T, Compare, Allocator> const&
+                    , radix_heap<T, Compare, Allocator> const& ) -> bool;
+
+    template<class T, class Compare, class Allocator>
+    auto operator!= ( radix_heap<T, Compare, Allocator> const&
+                    , radix_heap<T, Compare, Allocator> const& ) -> bool;
+
+/// definitions:
+
+    namespace aux_impl
+    {
+        template<class Compare, class T, class = void>
+        struct has_radix_key : std::false_type
+        {
+        };
+
+        template<class Compare, class T>
+        struct has_radix_key<Compare, T, std::void_t<decltype(Compare::key(std::declval<T const&>()))>>
+            : std::true_type
+        {
+        };
+    }
+
+// radix_node definition:
+
+    template<class T>
+    template<class... Args>
+    radix_node<T>::radix_node(std::piecewise_construct_t, Args&&... args) :
+        data_   (std::forward<Args>(args)...),
+        key_    (0),
+        prev_   (nullptr),
+        next_   (nullptr),
+        bucket_ (0)
+    {
+    }
+
+    template<class T>
+    auto radix_node<T>::operator*
+        () -> T&
+    {
+        return data_;
+    }
+
+    template<class T>
+    auto radix_node<T>::operator*
+        () const -> T const&
+    {
+        return data_;
+    }
+
+// radix_node_handle definition:
+
+    template<class T, class Compare, class Allocator>
+    radix_node_handle<T, Compare, Allocator>::radix_node_handle(node_t* const node) :
+        node_ (node)
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_node_handle<T, Compare, Allocator>::operator*
+        () -> T&
+    {
+        return **node_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_node_handle<T, Compare, Allocator>::operator*
+        () const -> T const&
+    {
+        return **node_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_node_handle<T, Compare, Allocator>::operator->
+        () -> T*
+    {
+        return std::addressof(**this);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_node_handle<T, Compare, Allocator>::operator->
+        () const -> T const*
+    {
+        return std::addressof(**this);
+    }
+
+// radix_heap_iterator definition:
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    radix_heap_iterator<T, Compare, Allocator, IsConst>::radix_heap_iterator
+        (node_t* const* buckets, std::size_t const bucket, node_t* const node) :
+        buckets_ (buckets),
+        bucket_  (bucket),
+        node_    (node)
+    {
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto radix_heap_iterator<T, Compare, Allocator, IsConst>::operator++
+        () -> radix_heap_iterator&
+    {
+        node_ = node_->next_;
+
+        while (!node_ && bucket_ < RadixBucketCount - 1)
+        {
+            ++bucket_;
+            node_ = buckets_[bucket_];
+        }
+
+        return *this;
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto radix_heap_iterator<T, Compare, Allocator, IsConst>::operator++
+        (int) -> radix_heap_iterator
+    {
+        auto const ret = *this;
+        ++(*this);
+        return ret;
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto radix_heap_iterator<T, Compare, Allocator, IsConst>::operator*
+        () const -> reference
+    {
+        return **node_;
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto radix_heap_iterator<T, Compare, Allocator, IsConst>::operator->
+        () const -> pointer
+    {
+        return std::addressof(**this);
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto radix_heap_iterator<T, Compare, Allocator, IsConst>::operator==
+        (radix_heap_iterator const& rhs) const -> bool
+    {
+        return node_ == rhs.node_;
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto radix_heap_iterator<T, Compare, Allocator, IsConst>::operator!=
+        (radix_heap_iterator const& rhs) const -> bool
+    {
+        return !(*this == rhs);
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto radix_heap_iterator<T, Compare, Allocator, IsConst>::current
+        () const -> node_t*
+    {
+        return node_;
+    }
+
+// radix_heap definition:
+
+    template<class T, class Compare, class Allocator>
+    radix_heap<T, Compare, Allocator>::radix_heap
+        (Allocator const& alloc) :
+        alloc_    (alloc),
+        buckets_  {},
+        nonEmpty_ (0),
+        last_     (0),
+        size_     (0)
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    radix_heap<T, Compare, Allocator>::radix_heap
+        (radix_heap const& other) :
+        alloc_    (other.alloc_),
+        buckets_  {},
+        nonEmpty_ (other.nonEmpty_),
+        last_     (other.last_),
+        size_     (other.size_)
+    {
+        for (auto b = 0u; b < RadixBucketCount; ++b)
+        {
+            auto tail = static_cast<node_t*>(nullptr);
+            for (auto node = other.buckets_[b]; node; node = node->next_)
+            {
+                auto const copy = this->new_node(**node);
+                copy->key_    = node->key_;
+                copy->bucket_ = b;
+                copy->prev_   = tail;
+                (tail ? tail->next_ : buckets_[b]) = copy;
+                tail = copy;
+            }
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    radix_heap<T, Compare, Allocator>::radix_heap
+        (radix_heap&& other) noexcept :
+        alloc_    (std::move(other.alloc_)),
+        buckets_  (std::exchange(other.buckets_, buckets_t {})),
+        nonEmpty_ (std::exchange(other.nonEmpty_, 0)),
+        last_     (std::exchange(other.last_, 0)),
+        size_     (std::exchange(other.size_, 0))
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    radix_heap<T, Compare, Allocator>::~radix_heap()
+    {
+        this->clear();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::operator=
+        (radix_heap other) noexcept -> radix_heap&
+    {
+        this->swap(other);
+        return *this;
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    auto radix_heap<T, Compare, Allocator>::emplace
+        (Args&&... args) -> handle_t
+    {
+        return this->insert_impl(this->new_node(std::forward<Args>(args)...));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::insert
+        (value_type const& value) -> handle_t
+    {
+        return this->insert_impl(this->new_node(value));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::insert
+        (value_type&& value) -> handle_t
+    {
+        return this->insert_impl(this->new_node(std::move(value)));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::delete_min
+        () -> void
+    {
+        this->empty_check();
+
+        if (!buckets_[0])
+        {
+            this->pull();
+        }
+
+        this->erase_impl(buckets_[0]);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::find_min
+        () -> reference
+    {
+        this->empty_check();
+
+        if (!buckets_[0])
+        {
+            this->pull();
+        }
+
+        return **buckets_[0];
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::find_min
+        () const -> const_reference
+    {
+        this->empty_check();
+
+        if (!buckets_[0])
+        {
+            this->pull();
+        }
+
+        return **buckets_[0];
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::decrease_key
+        (handle_t const handle) -> void
+    {
+        this->dec_key_impl(handle.node_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::decrease_key
+        (iterator pos) -> void
+    {
+        this->dec_key_impl(pos.current());
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::decrease_key
+        (const_iterator pos) -> void
+    {
+        this->dec_key_impl(pos.current());
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::meld
+        (radix_heap rhs) -> radix_heap&
+    {
+        if (rhs.empty())
+        {
+            return *this;
+        }
+
+        // Buckets are relative to last_ so both heaps are redistributed
+        // with respect to the smaller one.
+        last_      = this->empty() ? rhs.last_ : std::min(last_, rhs.last_);
+        auto nodes = this->take_all();
+        auto other = rhs.take_all();
+
+        for (auto list : {nodes, other})
+        {
+            while (list)
+            {
+                auto const next = list->next_;
+                this->link(list, this->bucket_of(list->key_));
+                list = next;
+            }
+        }
+
+        size_ += std::exchange(rhs.size_, 0);
+        rhs.last_ = 0;
+        return *this;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::erase
+        (handle_t const handle) -> void
+    {
+        this->erase_impl(handle.node_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::erase
+        (iterator pos) -> void
+    {
+        this->erase_impl(pos.current());
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::erase
+        (const_iterator pos) -> void
+    {
+        this->erase_impl(pos.current());
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::swap
+        (radix_heap& rhs) noexcept -> void
+    {
+        using std::swap;
+        swap(buckets_, rhs.buckets_);
+        swap(nonEmpty_, rhs.nonEmpty_);
+        swap(last_, rhs.last_);
+        swap(size_, rhs.size_);
+
+        if constexpr (node_alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(alloc_, rhs.alloc_);
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::empty
+        () const -> bool
+    {
+        return 0 == this->size();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::size
+        () const -> size_type
+    {
+        return size_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::max_size
+        () const -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::clear
+        () -> void
+    {
+        this->for_each_node([this](auto const node)
+        {
+            this->delete_node(node);
+        });
+
+        buckets_.fill(nullptr);
+        nonEmpty_ = 0;
+        last_     = 0;
+        size_     = 0;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::begin
+        () -> iterator
+    {
+        auto const b = this->first_bucket();
+        return b < RadixBucketCount ? iterator(buckets_.data(), b, buckets_[b]) : iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::end
+        () -> iterator
+    {
+        return iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::begin
+        () const -> const_iterator
+    {
+        return this->cbegin();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::end
+        () const -> const_iterator
+    {
+        return this->cend();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::cbegin
+        () const -> const_iterator
+    {
+        auto const b = this->first_bucket();
+        return b < RadixBucketCount ? const_iterator(buckets_.data(), b, buckets_[b]) : const_iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::cend
+        () const -> const_iterator
+    {
+        return const_iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    auto radix_heap<T, Compare, Allocator>::new_node
+        (Args&&... args) -> node_t*
+    {
+        auto const p = node_alloc_traits::allocate(alloc_, 1);
+        node_alloc_traits::construct(alloc_, p, std::piecewise_construct, std::forward<Args>(args)...);
+        return p;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::delete_node
+        (node_t* const node) -> void
+    {
+        node_alloc_traits::destroy(alloc_, node);
+        node_alloc_traits::deallocate(alloc_, node, 1);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::insert_impl
+        (node_t* const node) -> handle_t
+    {
+        auto const key = radix_heap::key_of(**node);
+
+        if (key < last_)
+        {
+            this->delete_node(node);
+            this->key_check(key);
+        }
+
+        node->key_ = key;
+        this->link(node, this->bucket_of(key));
+        ++size_;
+        return handle_t(node);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::empty_check
+        () const -> void
+    {
+        if (this->empty())
+        {
+            throw std::out_of_range("Heap is empty!");
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::key_check
+        (radix_key_t const key) const -> void
+    {
+        if (key < last_)
+        {
+            throw std::invalid_argument("Key is smaller than the last minimum!");
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::dec_key_impl
+        (node_t* const node) -> void
+    {
+        auto const key = radix_heap::key_of(**node);
+        this->key_check(key);
+
+        node->key_ = key;
+        auto const bucket = this->bucket_of(key);
+
+        if (bucket != node->bucket_)
+        {
+            this->unlink(node);
+            this->link(node, bucket);
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::erase_impl
+        (node_t* const node) -> void
+    {
+        this->unlink(node);
+        this->delete_node(node);
+
+        if (0 == --size_)
+        {
+            // Empty heap accepts any key again.
+            last_ = 0;
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::bucket_of
+        (radix_key_t const key) const -> std::uint32_t
+    {
+        auto constexpr Bits = std::numeric_limits<radix_key_t>::digits;
+        return key == last_ ? 0 : static_cast<std::uint32_t>(Bits - __builtin_clzll(key ^ last_));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::link
+        (node_t* const node, std::uint32_t const bucket) const -> void
+    {
+        node->bucket_ = bucket;
+        node->prev_   = nullptr;
+        node->next_   = buckets_[bucket];
+
+        if (node->next_)
+        {
+            node->next_->prev_ = node;
+        }
+
+        buckets_[bucket] = node;
+
+        if (bucket)
+        {
+            nonEmpty_ |= std::uint64_t {1} << (bucket - 1);
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::unlink
+        (node_t* const node) const -> void
+    {
+        auto const bucket = node->bucket_;
+
+        if (node->prev_)
+        {
+            node->prev_->next_ = node->next_;
+        }
+        else
+        {
+            buckets_[bucket] = node->next_;
+        }
+
+        if (node->next_)
+        {
+            node->next_->prev_ = node->prev_;
+        }
+
+        if (bucket && !buckets_[bucket])
+        {
+            nonEmpty_ &= ~(std::uint64_t {1} << (bucket - 1));
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::pull
+        () const -> void
+    {
+        // Bucket 0 is empty, minimum is in the first non-empty bucket.
+        auto const bucket = static_cast<std::size_t>(__builtin_ctzll(nonEmpty_)) + 1;
+        auto list = std::exchange(buckets_[bucket], nullptr);
+        nonEmpty_ &= ~(std::uint64_t {1} << (bucket - 1));
+
+        last_ = list->key_;
+        for (auto node = list->next_; node; node = node->next_)
+        {
+            last_ = std::min(last_, node->key_);
+        }
+
+        while (list)
+        {
+            auto const next = list->next_;
+            this->link(list, this->bucket_of(list->key_));
+            list = next;
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::take_all
+        () -> node_t*
+    {
+        auto first = static_cast<node_t*>(nullptr);
+
+        for (auto& bucket : buckets_)
+        {
+            while (bucket)
+            {
+                auto const next = bucket->next_;
+                bucket->next_   = first;
+                first           = bucket;
+                bucket          = next;
+            }
+        }
+
+        nonEmpty_ = 0;
+        return first;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::first_bucket
+        () const -> std::size_t
+    {
+        if (buckets_[0])
+        {
+            return 0;
+        }
+
+        return nonEmpty_ ? static_cast<std::size_t>(__builtin_ctzll(nonEmpty_)) + 1 : RadixBucketCount;
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class NodeOp>
+    auto radix_heap<T, Compare, Allocator>::for_each_node
+        (NodeOp op) const -> void
+    {
+        for (auto const bucket : buckets_)
+        {
+            auto node = bucket;
+            while (node)
+            {
+                // Move past the node first so that op is free to delete it.
+                auto const next = node->next_;
+                op(node);
+                node = next;
+            }
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto radix_heap<T, Compare, Allocator>::key_of
+        (T const& value) -> radix_key_t
+    {
+        if constexpr (aux_impl::has_radix_key<Compare, T>::value)
+        {
+            return static_cast<radix_key_t>(Compare::key(value));
+        }
+        else
+        {
+            static_assert(std::is_integral_v<T>, "Compare must provide static key function for non-integral T.");
+            return static_cast<radix_key_t>(value);
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto meld ( radix_heap<T, Compare, Allocator> lhs
+              , radix_heap<T, Compare, Allocator> rhs ) noexcept
+              -> radix_heap<T, Compare, Allocator>
+    {
+        lhs.meld(std::move(rhs));
+        return radix_heap<T, Compare, Allocator>(std::move(lhs));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto swap ( radix_heap<T, Compare, Allocator>& lhs
+              , radix_heap<T, Compare, Allocator>& rhs ) noexcept -> void
+    {
+        lhs.swap(rhs);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto operator== ( radix_heap<T, Compare, Allocator> const& lhs
+                    , radix_heap<T, Compare, Allocator> const& rhs ) -> bool
+    {
+        return lhs.size() == rhs.size()
+            && std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto operator!= ( radix_heap<T, Compare, Allocator> const& lhs
+                    , radix_heap<T, Compare, Allocator> const& rhs ) -> bool
+    {
+        return ! (lhs == rhs);
+    }
+}
+
+#endif
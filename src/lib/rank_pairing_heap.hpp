@@ -0,0 +1,955 @@
+#ifndef MIX_DS_RANK_PAIRING_HEAP_HPP
+#define MIX_DS_RANK_PAIRING_HEAP_HPP
+
+#include "pairing_heap.hpp"
+
+#include <functional>
+#include <utility>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <queue>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+namespace mix::ds
+{
+    /**
+        Rules that restore ranks of non-root nodes after decrease_key.
+        Ranks of missing children are -1.
+     */
+    namespace rank_rules
+    {
+        /**
+            Every node is 1,1 or 0,i. Keeps ranks tight.
+         */
+        struct type_1
+        {
+            static auto rank (int const left, int const right) -> int
+            {
+                return left == right ? left + 1 : std::max(left, right);
+            }
+        };
+
+        /**
+            Also allows 1,2 nodes so the rank update stops sooner.
+         */
+        struct type_2
+        {
+            static auto rank (int const left, int const right) -> int
+            {
+                auto const diff = left > right ? left - right : right - left;
+                return diff > 1 ? std::max(left, right) : std::max(left, right) + 1;
+            }
+        };
+    }
+
+    /**
+        Node of a half tree.
+     */
+    template<class T>
+    class rank_pairing_node;
+
+    /**
+        Iterator of the rank pairing heap.
+     */
+    template<class T, class Compare, class RankRule, class Allocator, bool IsConst>
+    class rank_pairing_iterator;
+
+    /**
+        Rank pairing heap.
+     */
+    template< class T
+            , class Compare   = std::less<T>
+            , class RankRule  = rank_rules::type_1
+            , class Allocator = std::allocator<T> >
+    class rank_pairing_heap;
+
+    template<class T>
+    class rank_pairing_node
+    {
+    public:
+        using node_t = rank_pairing_node;
+        using rank_t = int;
+
+        template<class... Args>
+        rank_pairing_node (std::piecewise_construct_t, Args&&... args);
+
+        auto operator* ()       -> T&;
+        auto operator* () const -> T const&;
+
+        template<class, class, class, class>
+        friend class rank_pairing_heap;
+
+        template<class, class, class, class, bool>
+        friend class rank_pairing_iterator;
+
+    private:
+        T       data_;
+        node_t* parent_;
+        node_t* left_;
+        node_t* right_;
+        rank_t  rank_;
+    };
+
+    /**
+        Node handle that is returned after an insertion
+        and can be used for decrease_key and erase.
+     */
+    template<class T, class Compare, class RankRule, class Allocator>
+    class rank_pairing_handle
+    {
+    public:
+        auto operator*  ()       -> T&;
+        auto operator*  () const -> T const&;
+        auto operator-> ()       -> T*;
+        auto operator-> () const -> T const*;
+
+    private:
+        using node_t = rank_pairing_node<T>;
+        friend class rank_pairing_heap<T, Compare, RankRule, Allocator>;
+        rank_pairing_handle(node_t* const node);
+        node_t* node_;
+    };
+
+    template<class T, class Compare, class RankRule, class Allocator, bool IsConst>
+    class rank_pairing_iterator
+    {
+    public:
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::conditional_t<IsConst, T const, T>;
+        using pointer           = value_type*;
+        using reference         = value_type&;
+        using iterator_category = std::forward_iterator_tag;
+        using node_t            = rank_pairing_node<T>;
+
+    public:
+        rank_pairing_iterator () = default;
+        rank_pairing_iterator (node_t* const root);
+
+        auto operator++ ()       -> rank_pairing_iterator&;
+        auto operator++ (int)    -> rank_pairing_iterator;
+        auto operator*  () const -> reference;
+        auto operator-> () const -> pointer;
+        auto operator== (rank_pairing_iterator const&) const -> bool;
+        auto operator!= (rank_pairing_iterator const&) const -> bool;
+
+    private:
+        friend class rank_pairing_heap<T, Compare, RankRule, Allocator>;
+        auto current () const -> node_t*;
+
+    private:
+        node_t*             root_;
+        std::queue<node_t*> queue_;
+    };
+
+    /**
+        Rank pairing heap (Haeupler, Sen, Tarjan) with one-pass linking.
+        Heap is a circular list of half trees, minimum is the first root.
+        Half trees are stored as binary trees just like in pairing_heap,
+        right_ of a root points to the next root.
+        Unlike std::priority_queue in this heap an element "which is less"
+        has a higher priority.
+
+        @tparam T           The type of the stored elements.
+        @tparam Compare     Type providing a strict weak ordering.
+                            See https://en.cppreference.com/w/cpp/named_req/Compare
+        @tparam RankRule    See the rank_rules namespace above.
+        @tparam Allocator   Allocator. See https://en.cppreference.com/w/cpp/named_req/Allocator
+     */
+    template<class T, class Compare, class RankRule, class Allocator>
+    class rank_pairing_heap
+    {
+    public:
+        using node_t            = rank_pairing_node<T>;
+        using rank_t            = typename node_t::rank_t;
+        using handle_t          = rank_pairing_handle<T, Compare, RankRule, Allocator>;
+        using value_type        = T;
+        using reference         = T&;
+        using const_reference   = T const&;
+        using size_type         = std::size_t;
+        using difference_type   = std::ptrdiff_t;
+        using iterator          = rank_pairing_iterator<T, Compare, RankRule, Allocator, false>;
+        using const_iterator    = rank_pairing_iterator<T, Compare, RankRule, Allocator, true>;
+        using type_alloc_traits = std::allocator_traits<Allocator>;
+        using node_alloc_traits = typename type_alloc_traits::template rebind_traits<node_t>;
+        using node_allocator    = typename type_alloc_traits::template rebind_alloc<node_t>;
+        using node_map          = std::unordered_map<node_t const*, node_t*>;
+
+    public:
+        rank_pairing_heap  (Allocator const& alloc = Allocator());
+        rank_pairing_heap  (rank_pairing_heap const& other);
+        rank_pairing_heap  (rank_pairing_heap&& other) noexcept;
+        ~rank_pairing_heap ();
+
+        auto operator= (rank_pairing_heap other) noexcept -> rank_pairing_heap&;
+
+        template<class... Args>
+        auto emplace      (Args&&... args)                  -> handle_t;
+        auto insert       (value_type const& value)         -> handle_t;
+        auto insert       (value_type&& value)              -> handle_t;
+        auto delete_min   ()                                -> void;
+        auto find_min     ()                                -> reference;
+        auto find_min     () const                          -> const_reference;
+        auto decrease_key (handle_t const handle)           -> void;
+        auto decrease_key (iterator pos)                    -> void;
+        auto decrease_key (const_iterator pos)              -> void;
+        auto meld         (rank_pairing_heap rhs)           -> rank_pairing_heap&;
+        auto erase        (handle_t const handle)           -> void;
+        auto erase        (iterator pos)                    -> void;
+        auto erase        (const_iterator pos)              -> void;
+        auto swap         (rank_pairing_heap& rhs) noexcept -> void;
+        auto empty        () const                          -> bool;
+        auto size         () const                          -> size_type;
+        auto max_size     () const                          -> size_type;
+        auto clear        ()                                -> void;
+        auto begin        ()                                -> iterator;
+        auto end          ()                                -> iterator;
+        auto begin        () const                          -> const_iterator;
+        auto end          () const                          -> const_iterator;
+        auto cbegin       () const                          -> const_iterator;
+        auto cend         () const                          -> const_iterator;
+
+    private:
+        template<class... Args>
+        auto new_node    (Args&&... args)                 -> node_t*;
+        auto delete_node (node_t* const node)             -> void;
+        auto insert_impl (node_t* const node)             -> handle_t;
+        auto erase_impl  (node_t* const node)             -> void;
+        auto empty_check () const                         -> void;
+        auto deep_copy   (rank_pairing_heap const& other) -> node_t*;
+        auto add_bucket  (node_t* const node)             -> void;
+
+        template<class Cmp = Compare>
+        auto dec_key_impl (node_t* const node) -> void;
+
+        template<class NodeOp>
+        auto for_each_node (NodeOp op) const -> void;
+
+        static auto link      (node_t* const lhs, node_t* const rhs) -> node_t*;
+        static auto rank_of   (node_t const* const node)             -> rank_t;
+        static auto root_rank (node_t const* const node)             -> rank_t;
+
+        template<class Cmp = Compare>
+        static auto add_root (node_t*& root, node_t* const node) -> void;
+
+    private:
+        node_allocator       alloc_;
+        node_t*              root_;
+        size_type            size_;
+        std::vector<node_t*> buckets_;
+        rank_t               maxRank_;
+    };
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto meld ( rank_pairing_heap<T, Compare, RankRule, Allocator>
+              , rank_pairing_heap<T, Compare, RankRule, Allocator> ) noexcept
+              -> rank_pairing_heap<T, Compare, RankRule, Allocator>;
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto swap ( rank_pairing_heap<T, Compare, RankRule, Allocator>&
+              , rank_pairing_heap<T, Compare, RankRule, Allocator>& ) noexcept -> void;
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto operator== ( rank_pairing_heap<T, Compare, RankRule, Allocator> const&
+                    , rank_pairing_heap<T, Compare, RankRule, Allocator> const& ) -> bool;
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto operator!= ( rank_pairing_heap<T, Compare, RankRule, Allocator> const&
+                    , rank_pairing_heap<T, Compare, RankRule, Allocator> const& ) -> bool;
+
+/// definitions:
+
+// rank_pairing_node definition:
+
+    template<class T>
+    template<class... Args>
+    rank_pairing_node<T>::rank_pairing_node(std::piecewise_construct_t, Args&&... args) :
+        data_   (std::forward<Args>(args)...),
+        parent_ (nullptr),
+        left_   (nullptr),
+        right_  (nullptr),
+        rank_   (0)
+    {
+    }
+
+    template<class T>
+    auto rank_pairing_node<T>::operator*
+        () -> T&
+    {
+        return data_;
+    }
+
+    template<class T>
+    auto rank_pairing_node<T>::operator*
+        () const -> T const&
+    {
+        return data_;
+    }
+
+// rank_pairing_handle definition:
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    rank_pairing_handle<T, Compare, RankRule, Allocator>::rank_pairing_handle(node_t* const node) :
+        node_ (node)
+    {
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_handle<T, Compare, RankRule, Allocator>::operator*
+        () -> T&
+    {
+        return **node_;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_handle<T, Compare, RankRule, Allocator>::operator*
+        () const -> T const&
+    {
+        return **node_;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_handle<T, Compare, RankRule, Allocator>::operator->
+        () -> T*
+    {
+        return std::addressof(**this);
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_handle<T, Compare, RankRule, Allocator>::operator->
+        () const -> T const*
+    {
+        return std::addressof(**this);
+    }
+
+// rank_pairing_iterator definition:
+
+    template<class T, class Compare, class RankRule, class Allocator, bool IsConst>
+    rank_pairing_iterator<T, Compare, RankRule, Allocator, IsConst>::rank_pairing_iterator
+        (node_t* const root) :
+        root_  (root),
+        queue_ (std::deque {root})
+    {
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator, bool IsConst>
+    auto rank_pairing_iterator<T, Compare, RankRule, Allocator, IsConst>::operator++
+        () -> rank_pairing_iterator&
+    {
+        auto const node = queue_.front();
+
+        if (node->left_)
+        {
+            queue_.push(node->left_);
+        }
+
+        // Root list is circular so it ends where it started.
+        if (node->right_ && (node->parent_ || node->right_ != root_))
+        {
+            queue_.push(node->right_);
+        }
+
+        queue_.pop();
+        return *this;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator, bool IsConst>
+    auto rank_pairing_iterator<T, Compare, RankRule, Allocator, IsConst>::operator++
+        (int) -> rank_pairing_iterator
+    {
+        auto const ret = *this;
+        ++(*this);
+        return ret;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator, bool IsConst>
+    auto rank_pairing_iterator<T, Compare, RankRule, Allocator, IsConst>::operator*
+        () const -> reference
+    {
+        return **this->current();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator, bool IsConst>
+    auto rank_pairing_iterator<T, Compare, RankRule, Allocator, IsConst>::operator->
+        () const -> pointer
+    {
+        return std::addressof(**this);
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator, bool IsConst>
+    auto rank_pairing_iterator<T, Compare, RankRule, Allocator, IsConst>::operator==
+        (rank_pairing_iterator const& rhs) const -> bool
+    {
+        return (queue_.empty() && rhs.queue_.empty())
+            || (queue_.size()  == rhs.queue_.size()
+            &&  queue_.front() == rhs.queue_.front());
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator, bool IsConst>
+    auto rank_pairing_iterator<T, Compare, RankRule, Allocator, IsConst>::operator!=
+        (rank_pairing_iterator const& rhs) const -> bool
+    {
+        return !(*this == rhs);
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator, bool IsConst>
+    auto rank_pairing_iterator<T, Compare, RankRule, Allocator, IsConst>::current
+        () const -> node_t*
+    {
+        return queue_.front();
+    }
+
+// rank_pairing_heap definition:
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    rank_pairing_heap<T, Compare, RankRule, Allocator>::rank_pairing_heap
+        (Allocator const& alloc) :
+        alloc_   (alloc),
+        root_    (nullptr),
+        size_    (0),
+        buckets_ (),
+        maxRank_ (0)
+    {
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    rank_pairing_heap<T, Compare, RankRule, Allocator>::rank_pairing_heap
+        (rank_pairing_heap const& other) :
+        alloc_   (other.alloc_),
+        root_    (this->deep_copy(other)),
+        size_    (other.size_),
+        buckets_ (),
+        maxRank_ (0)
+    {
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    rank_pairing_heap<T, Compare, RankRule, Allocator>::rank_pairing_heap
+        (rank_pairing_heap&& other) noexcept :
+        alloc_   (std::move(other.alloc_)),
+        root_    (std::exchange(other.root_, nullptr)),
+        size_    (std::exchange(other.size_, 0)),
+        buckets_ (std::move(other.buckets_)),
+        maxRank_ (0)
+    {
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    rank_pairing_heap<T, Compare, RankRule, Allocator>::~rank_pairing_heap()
+    {
+        this->clear();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::operator=
+        (rank_pairing_heap other) noexcept -> rank_pairing_heap&
+    {
+        this->swap(other);
+        return *this;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    template<class... Args>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::emplace
+        (Args&&... args) -> handle_t
+    {
+        return this->insert_impl(this->new_node(std::forward<Args>(args)...));
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::insert
+        (value_type const& value) -> handle_t
+    {
+        return this->insert_impl(this->new_node(value));
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::insert
+        (value_type&& value) -> handle_t
+    {
+        return this->insert_impl(this->new_node(std::move(value)));
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::delete_min
+        () -> void
+    {
+        this->empty_check();
+        auto const oldRoot = root_;
+        root_ = nullptr;
+
+        // Right spine of the left subtree falls apart into half trees.
+        auto spine = oldRoot->left_;
+        while (spine)
+        {
+            auto const next = spine->right_;
+            spine->parent_  = nullptr;
+            spine->right_   = nullptr;
+            spine->rank_    = rank_pairing_heap::root_rank(spine);
+            this->add_bucket(spine);
+            spine = next;
+        }
+
+        auto other = oldRoot->right_;
+        while (other != oldRoot)
+        {
+            auto const next = other->right_;
+            this->add_bucket(other);
+            other = next;
+        }
+
+        // One pass, trees that were linked are not linked again.
+        for (auto rank = 0; rank < maxRank_; ++rank)
+        {
+            if (buckets_[rank])
+            {
+                rank_pairing_heap::add_root(root_, std::exchange(buckets_[rank], nullptr));
+            }
+        }
+        maxRank_ = 0;
+
+        --size_;
+        this->delete_node(oldRoot);
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::find_min
+        () -> reference
+    {
+        this->empty_check();
+        return **root_;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::find_min
+        () const -> const_reference
+    {
+        this->empty_check();
+        return **root_;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::decrease_key
+        (handle_t const handle) -> void
+    {
+        this->dec_key_impl(handle.node_);
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::decrease_key
+        (iterator pos) -> void
+    {
+        this->dec_key_impl(pos.current());
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::decrease_key
+        (const_iterator pos) -> void
+    {
+        this->dec_key_impl(pos.current());
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::meld
+        (rank_pairing_heap rhs) -> rank_pairing_heap&
+    {
+        auto const otherRoot = std::exchange(rhs.root_, nullptr);
+
+        if (root_ && otherRoot)
+        {
+            // Splice of two circular lists.
+            std::swap(root_->right_, otherRoot->right_);
+            if (Compare () (**otherRoot, **root_))
+            {
+                root_ = otherRoot;
+            }
+        }
+        else if (!root_)
+        {
+            root_ = otherRoot;
+        }
+
+        size_ += std::exchange(rhs.size_, 0);
+        return *this;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::erase
+        (handle_t const handle) -> void
+    {
+        this->erase_impl(handle.node_);
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::erase
+        (iterator pos) -> void
+    {
+        this->erase_impl(pos.current());
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::erase
+        (const_iterator pos) -> void
+    {
+        this->erase_impl(pos.current());
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::swap
+        (rank_pairing_heap& rhs) noexcept -> void
+    {
+        using std::swap;
+        swap(root_, rhs.root_);
+        swap(size_, rhs.size_);
+        swap(buckets_, rhs.buckets_);
+
+        if constexpr (node_alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(alloc_, rhs.alloc_);
+        }
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::empty
+        () const -> bool
+    {
+        return 0 == this->size();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::size
+        () const -> size_type
+    {
+        return size_;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::max_size
+        () const -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::clear
+        () -> void
+    {
+        this->for_each_node([this](auto const node)
+        {
+            this->delete_node(node);
+        });
+
+        root_    = nullptr;
+        size_    = 0;
+        maxRank_ = 0;
+        buckets_.clear();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::begin
+        () -> iterator
+    {
+        return root_ ? iterator(root_) : iterator();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::end
+        () -> iterator
+    {
+        return iterator();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::begin
+        () const -> const_iterator
+    {
+        return this->cbegin();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::end
+        () const -> const_iterator
+    {
+        return this->cend();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::cbegin
+        () const -> const_iterator
+    {
+        return root_ ? const_iterator(root_) : const_iterator();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::cend
+        () const -> const_iterator
+    {
+        return const_iterator();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    template<class... Args>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::new_node
+        (Args&&... args) -> node_t*
+    {
+        auto const p = node_alloc_traits::allocate(alloc_, 1);
+        node_alloc_traits::construct(alloc_, p, std::piecewise_construct, std::forward<Args>(args)...);
+        return p;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::delete_node
+        (node_t* const node) -> void
+    {
+        node_alloc_traits::destroy(alloc_, node);
+        node_alloc_traits::deallocate(alloc_, node, 1);
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::insert_impl
+        (node_t* const node) -> handle_t
+    {
+        rank_pairing_heap::add_root(root_, node);
+        ++size_;
+        return handle_t(node);
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::erase_impl
+        (node_t* const node) -> void
+    {
+        this->dec_key_impl<aux_impl::always_true_cmp>(node);
+        this->delete_min();
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::empty_check
+        () const -> void
+    {
+        if (this->empty())
+        {
+            throw std::out_of_range("Heap is empty!");
+        }
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::deep_copy
+        (rank_pairing_heap const& other) -> node_t*
+    {
+        if (other.empty())
+        {
+            return nullptr;
+        }
+
+        auto map = node_map();
+        map.reserve(other.size() + 1);
+        other.for_each_node([&map, this](auto const node)
+        {
+            auto const copy = node_alloc_traits::allocate(alloc_, 1);
+            node_alloc_traits::construct(alloc_, copy, *node);
+            map.emplace(node, copy);
+        });
+        map.emplace(nullptr, nullptr);
+
+        for (auto [original, copy] : map)
+        {
+            if (original)
+            {
+                copy->parent_ = map.at(original->parent_);
+                copy->left_   = map.at(original->left_);
+                copy->right_  = map.at(original->right_);
+            }
+        }
+
+        return map.at(other.root_);
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::add_bucket
+        (node_t* const node) -> void
+    {
+        auto const rank = node->rank_;
+        if (rank >= static_cast<rank_t>(buckets_.size()))
+        {
+            buckets_.resize(rank + 1, nullptr);
+        }
+
+        if (buckets_[rank])
+        {
+            rank_pairing_heap::add_root(root_, rank_pairing_heap::link(node, std::exchange(buckets_[rank], nullptr)));
+        }
+        else
+        {
+            buckets_[rank] = node;
+            maxRank_       = std::max(maxRank_, rank + 1);
+        }
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    template<class Cmp>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::dec_key_impl
+        (node_t* const node) -> void
+    {
+        if (node == root_)
+        {
+            return;
+        }
+
+        if (!node->parent_)
+        {
+            if (Cmp () (**node, **root_))
+            {
+                root_ = node;
+            }
+            return;
+        }
+
+        // Node leaves with its left subtree, right subtree takes its place.
+        auto parent = node->parent_;
+        auto const right = node->right_;
+
+        if (parent->left_ == node)
+        {
+            parent->left_ = right;
+        }
+        else
+        {
+            parent->right_ = right;
+        }
+
+        if (right)
+        {
+            right->parent_ = parent;
+        }
+
+        node->parent_ = nullptr;
+        node->right_  = nullptr;
+        node->rank_   = rank_pairing_heap::root_rank(node);
+        rank_pairing_heap::add_root<Cmp>(root_, node);
+
+        // Ranks on the path to the root can only decrease.
+        while (parent)
+        {
+            auto const rank = parent->parent_
+                ? RankRule::rank(rank_pairing_heap::rank_of(parent->left_), rank_pairing_heap::rank_of(parent->right_))
+                : rank_pairing_heap::root_rank(parent);
+
+            if (rank >= parent->rank_)
+            {
+                break;
+            }
+
+            parent->rank_ = rank;
+            parent        = parent->parent_;
+        }
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    template<class NodeOp>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::for_each_node
+        (NodeOp op) const -> void
+    {
+        auto it  = this->begin();
+        auto end = this->end();
+
+        while (it != end)
+        {
+            // Move past the node first so that op is free to delete it.
+            auto const node = it.current();
+            ++it;
+            op(node);
+        }
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::link
+        (node_t* const lhs, node_t* const rhs) -> node_t*
+    {
+        auto const areOrdered = Compare () (**lhs, **rhs);
+        auto const winner     = areOrdered ? lhs : rhs;
+        auto const loser      = areOrdered ? rhs : lhs;
+        auto const oldLeftSon = winner->left_;
+
+        loser->parent_ = winner;
+        loser->right_  = oldLeftSon;
+        winner->left_  = loser;
+        winner->rank_  = loser->rank_ + 1;
+
+        if (oldLeftSon)
+        {
+            oldLeftSon->parent_ = loser;
+        }
+
+        return winner;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::rank_of
+        (node_t const* const node) -> rank_t
+    {
+        return node ? node->rank_ : -1;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::root_rank
+        (node_t const* const node) -> rank_t
+    {
+        return rank_pairing_heap::rank_of(node->left_) + 1;
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    template<class Cmp>
+    auto rank_pairing_heap<T, Compare, RankRule, Allocator>::add_root
+        (node_t*& root, node_t* const node) -> void
+    {
+        if (!root)
+        {
+            node->right_ = node;
+            root         = node;
+            return;
+        }
+
+        node->right_ = root->right_;
+        root->right_ = node;
+
+        if (Cmp () (**node, **root))
+        {
+            root = node;
+        }
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto meld ( rank_pairing_heap<T, Compare, RankRule, Allocator> lhs
+              , rank_pairing_heap<T, Compare, RankRule, Allocator> rhs ) noexcept
+              -> rank_pairing_heap<T, Compare, RankRule, Allocator>
+    {
+        lhs.meld(std::move(rhs));
+        return rank_pairing_heap<T, Compare, RankRule, Allocator>(std::move(lhs));
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto swap ( rank_pairing_heap<T, Compare, RankRule, Allocator>& lhs
+              , rank_pairing_heap<T, Compare, RankRule, Allocator>& rhs ) noexcept -> void
+    {
+        lhs.swap(rhs);
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto operator== ( rank_pairing_heap<T, Compare, RankRule, Allocator> const& lhs
+                    , rank_pairing_heap<T, Compare, RankRule, Allocator> const& rhs ) -> bool
+    {
+        return lhs.size() == rhs.size()
+            && std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs));
+    }
+
+    template<class T, class Compare, class RankRule, class Allocator>
+    auto operator!= ( rank_pairing_heap<T, Compare, RankRule, Allocator> const& lhs
+                    , rank_pairing_heap<T, Compare, RankRule, Allocator> const& rhs ) -> bool
+    {
+        return ! (lhs == rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,546 @@
+#ifndef MIX_DS_SEQUENCE_HEAP_HPP
+#define MIX_DS_SEQUENCE_HEAP_HPP
+
+#include <functional>
+#include <utility>
+#include <memory>
+#include <stdexcept>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace mix::ds
+{
+    /**
+        Tournament tree of losers over k sources. Less(i, j) tells whether
+        the head of source i is less than the head of source j, an exhausted
+        source must not be less than any other. After the winner source
+        advances replay restores the tree in log k comparisons.
+     */
+    template<class Less>
+    class loser_tree
+    {
+    public:
+        using size_type = std::size_t;
+
+    public:
+        loser_tree (size_type const k, Less less);
+
+        auto winner () const -> size_type;
+        auto replay ()       -> void;
+
+    private:
+        auto beats (size_type const lhs, size_type const rhs) const -> bool;
+
+        static auto leaf_count (size_type const k) -> size_type;
+
+    private:
+        Less                   less_;
+        size_type              k_;
+        size_type              leafCount_;
+        std::vector<size_type> tree_;
+    };
+
+    /**
+        Sequence heap (Sanders). Not addressable priority queue for very
+        large numbers of elements. New elements go to a small insertion
+        heap. When it is full it is sorted into a run that is added to the
+        first group. Group i keeps at most Arity sorted runs and when it is
+        full they are merged by a loser tree into a single run of group i + 1.
+        Deletion buffer holds the smallest elements of all runs and it is
+        refilled by a single k-way merge, so that delete_min mostly touches
+        only the two small buffers and the runs are read sequentially.
+        Unlike std::priority_queue in this heap an element "which is less"
+        has a higher priority.
+
+        @tparam T           The type of the stored elements.
+        @tparam Compare     Type providing a strict weak ordering.
+                            See https://en.cppreference.com/w/cpp/named_req/Compare
+        @tparam Allocator   Allocator. See https://en.cppreference.com/w/cpp/named_req/Allocator
+     */
+    template< class T
+            , class Compare   = std::less<T>
+            , class Allocator = std::allocator<T> >
+    class sequence_heap
+    {
+    public:
+        using value_type      = T;
+        using reference       = T&;
+        using const_reference = T const&;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using buffer_t        = std::vector<T, Allocator>;
+
+        /**
+            Capacity of the insertion heap. Its sorting is what
+            dominates insert so it should fit into the L2 cache.
+         */
+        static constexpr size_type InsertCapacity = 1 << 14;
+
+        /**
+            Capacity of the deletion buffer.
+         */
+        static constexpr size_type DeleteCapacity = 1 << 12;
+
+        /**
+            Maximal number of runs in a group.
+         */
+        static constexpr size_type Arity = 64;
+
+    public:
+        sequence_heap (Allocator const& alloc = Allocator());
+
+        template<class... Args>
+        auto emplace    (Args&&... args)              -> void;
+        auto insert     (value_type const& value)     -> void;
+        auto insert     (value_type&& value)          -> void;
+        auto delete_min ()                            -> void;
+        auto find_min   () const                      -> const_reference;
+        auto swap       (sequence_heap& rhs) noexcept -> void;
+        auto empty      () const                      -> bool;
+        auto size       () const                      -> size_type;
+        auto clear      ()                            -> void;
+
+    private:
+        /**
+            Sorted sequence of which the elements before first_ were consumed.
+         */
+        struct run
+        {
+            buffer_t  data_;
+            size_type first_;
+
+            auto empty () const -> bool;
+            auto head  () const -> T const&;
+        };
+
+        using group_t = std::vector<run>;
+
+    private:
+        auto flush_insert_heap ()                                          -> void;
+        auto add_run           (buffer_t data, size_type const group)      -> void;
+        auto merge_runs        (std::vector<run*> const& runs, size_type const limit, buffer_t& out) -> void;
+        auto refill            ()                                          -> void;
+        auto insert_min_first  () const                                    -> bool;
+        auto empty_check       () const                                    -> void;
+
+        /**
+            std heap algorithms keep the maximum on top.
+         */
+        struct heap_compare
+        {
+            auto operator() (T const& lhs, T const& rhs) const -> bool;
+        };
+
+    private:
+        Allocator            alloc_;
+        buffer_t             insertHeap_;
+        buffer_t             deleteBuffer_;
+        size_type            deleteFirst_;
+        std::vector<group_t> groups_;
+        size_type            size_;
+    };
+
+    template<class T, class Compare, class Allocator>
+    auto swap ( sequence_heap<T, Compare, Allocator>&
+              , sequence_heap<T, Compare, Allocator>& ) noexcept -> void;
+
+/// definitions:
+
+// loser_tree definition:
+
+    template<class Less>
+    loser_tree<Less>::loser_tree
+        (size_type const k, Less less) :
+        less_      (std::move(less)),
+        k_         (k),
+        leafCount_ (loser_tree::leaf_count(k)),
+        tree_      (leafCount_)
+    {
+        // Winners of subtrees are computed bottom-up, losers stay in the nodes.
+        auto winners = std::vector<size_type>(2 * leafCount_);
+        for (auto i = size_type {0}; i < leafCount_; ++i)
+        {
+            winners[leafCount_ + i] = i;
+        }
+
+        for (auto node = leafCount_ - 1; node > 0; --node)
+        {
+            auto const lhs = winners[2 * node];
+            auto const rhs = winners[2 * node + 1];
+            auto const lhsWins = this->beats(lhs, rhs);
+            winners[node] = lhsWins ? lhs : rhs;
+            tree_[node]   = lhsWins ? rhs : lhs;
+        }
+
+        tree_[0] = winners[1];
+    }
+
+    template<class Less>
+    auto loser_tree<Less>::winner
+        () const -> size_type
+    {
+        return tree_[0];
+    }
+
+    template<class Less>
+    auto loser_tree<Less>::replay
+        () -> void
+    {
+        auto winner = tree_[0];
+        for (auto node = (leafCount_ + winner) / 2; node > 0; node /= 2)
+        {
+            if (this->beats(tree_[node], winner))
+            {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = winner;
+    }
+
+    template<class Less>
+    auto loser_tree<Less>::beats
+        (size_type const lhs, size_type const rhs) const -> bool
+    {
+        // Leaves past k are padding and never win.
+        if (rhs >= k_)
+        {
+            return lhs < k_;
+        }
+
+        return lhs < k_ && less_(lhs, rhs);
+    }
+
+    template<class Less>
+    auto loser_tree<Less>::leaf_count
+        (size_type const k) -> size_type
+    {
+        auto count = size_type {1};
+        while (count < k)
+        {
+            count *= 2;
+        }
+        return count;
+    }
+
+// sequence_heap::run definition:
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::run::empty
+        () const -> bool
+    {
+        return first_ == data_.size();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::run::head
+        () const -> T const&
+    {
+        return data_[first_];
+    }
+
+// sequence_heap definition:
+
+    template<class T, class Compare, class Allocator>
+    sequence_heap<T, Compare, Allocator>::sequence_heap
+        (Allocator const& alloc) :
+        alloc_        (alloc),
+        insertHeap_   (alloc),
+        deleteBuffer_ (alloc),
+        deleteFirst_  (0),
+        groups_       (),
+        size_         (0)
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    auto sequence_heap<T, Compare, Allocator>::emplace
+        (Args&&... args) -> void
+    {
+        if (insertHeap_.size() == InsertCapacity)
+        {
+            this->flush_insert_heap();
+        }
+
+        insertHeap_.emplace_back(std::forward<Args>(args)...);
+        std::push_heap(std::begin(insertHeap_), std::end(insertHeap_), heap_compare ());
+        ++size_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::insert
+        (value_type const& value) -> void
+    {
+        this->emplace(value);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::insert
+        (value_type&& value) -> void
+    {
+        this->emplace(std::move(value));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::delete_min
+        () -> void
+    {
+        this->empty_check();
+
+        if (this->insert_min_first())
+        {
+            std::pop_heap(std::begin(insertHeap_), std::end(insertHeap_), heap_compare ());
+            insertHeap_.pop_back();
+        }
+        else if (++deleteFirst_ == deleteBuffer_.size())
+        {
+            this->refill();
+        }
+
+        --size_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::find_min
+        () const -> const_reference
+    {
+        this->empty_check();
+        return this->insert_min_first() ? insertHeap_.front()
+                                        : deleteBuffer_[deleteFirst_];
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::swap
+        (sequence_heap& rhs) noexcept -> void
+    {
+        using std::swap;
+        swap(insertHeap_, rhs.insertHeap_);
+        swap(deleteBuffer_, rhs.deleteBuffer_);
+        swap(deleteFirst_, rhs.deleteFirst_);
+        swap(groups_, rhs.groups_);
+        swap(size_, rhs.size_);
+
+        if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value)
+        {
+            swap(alloc_, rhs.alloc_);
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::empty
+        () const -> bool
+    {
+        return 0 == this->size();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::size
+        () const -> size_type
+    {
+        return size_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::clear
+        () -> void
+    {
+        insertHeap_.clear();
+        deleteBuffer_.clear();
+        deleteFirst_ = 0;
+        groups_.clear();
+        size_ = 0;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::flush_insert_heap
+        () -> void
+    {
+        auto runData = buffer_t(alloc_);
+        runData.swap(insertHeap_);
+        insertHeap_.reserve(InsertCapacity);
+        std::sort(std::begin(runData), std::end(runData), Compare ());
+
+        // Deletion buffer must stay below all runs. It keeps as many
+        // of the smallest elements of both as it has now, the rest
+        // goes to the new run.
+        auto const keep = deleteBuffer_.size() - deleteFirst_;
+        if (keep > 0)
+        {
+            auto merged = buffer_t(alloc_);
+            merged.reserve(keep + runData.size());
+            std::merge( std::make_move_iterator(std::begin(deleteBuffer_) + deleteFirst_)
+                      , std::make_move_iterator(std::end(deleteBuffer_))
+                      , std::make_move_iterator(std::begin(runData))
+                      , std::make_move_iterator(std::end(runData))
+                      , std::back_inserter(merged)
+                      , Compare () );
+
+            deleteBuffer_.clear();
+            deleteFirst_ = 0;
+            std::move( std::begin(merged), std::begin(merged) + keep
+                     , std::back_inserter(deleteBuffer_) );
+            runData.clear();
+            std::move( std::begin(merged) + keep, std::end(merged)
+                     , std::back_inserter(runData) );
+        }
+
+        this->add_run(std::move(runData), 0);
+
+        if (deleteFirst_ == deleteBuffer_.size())
+        {
+            this->refill();
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::add_run
+        (buffer_t data, size_type const group) -> void
+    {
+        if (group == groups_.size())
+        {
+            groups_.emplace_back();
+        }
+
+        if (groups_[group].size() == Arity)
+        {
+            auto runs = std::vector<run*>();
+            auto size = size_type {0};
+            for (auto& r : groups_[group])
+            {
+                runs.emplace_back(&r);
+                size += r.data_.size() - r.first_;
+            }
+
+            auto merged = buffer_t(alloc_);
+            merged.reserve(size);
+            this->merge_runs(runs, size, merged);
+            groups_[group].clear();
+            this->add_run(std::move(merged), group + 1);
+        }
+
+        groups_[group].push_back(run {std::move(data), 0});
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::merge_runs
+        (std::vector<run*> const& runs, size_type const limit, buffer_t& out) -> void
+    {
+        // Bounds of the runs are kept in two flat arrays for the hot loop.
+        auto heads = std::vector<T*>(runs.size());
+        auto ends  = std::vector<T*>(runs.size());
+        for (auto i = size_type {0}; i < runs.size(); ++i)
+        {
+            heads[i] = runs[i]->data_.data() + runs[i]->first_;
+            ends[i]  = runs[i]->data_.data() + runs[i]->data_.size();
+        }
+
+        auto const less = [&heads, &ends](auto const lhs, auto const rhs)
+        {
+            return heads[lhs] != ends[lhs]
+                && (heads[rhs] == ends[rhs] || Compare () (*heads[lhs], *heads[rhs]));
+        };
+
+        auto tree = loser_tree<decltype(less)>(runs.size(), less);
+        for (auto i = size_type {0}; i < limit; ++i)
+        {
+            auto const source = tree.winner();
+            if (heads[source] == ends[source])
+            {
+                break;
+            }
+
+            out.emplace_back(std::move(*heads[source]));
+            ++heads[source];
+            tree.replay();
+        }
+
+        for (auto i = size_type {0}; i < runs.size(); ++i)
+        {
+            runs[i]->first_ = static_cast<size_type>(heads[i] - runs[i]->data_.data());
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::refill
+        () -> void
+    {
+        deleteBuffer_.clear();
+        deleteFirst_ = 0;
+
+        auto runs = std::vector<run*>();
+        for (auto& group : groups_)
+        {
+            for (auto& r : group)
+            {
+                runs.emplace_back(&r);
+            }
+        }
+
+        if (runs.empty())
+        {
+            return;
+        }
+
+        this->merge_runs(runs, DeleteCapacity, deleteBuffer_);
+
+        for (auto& group : groups_)
+        {
+            group.erase( std::remove_if( std::begin(group), std::end(group)
+                                       , [](auto const& r) { return r.empty(); } )
+                       , std::end(group) );
+
+            // Consumed part of a run is released once it is the bigger half.
+            for (auto& r : group)
+            {
+                if (r.first_ > r.data_.size() / 2)
+                {
+                    r.data_.erase(std::begin(r.data_), std::begin(r.data_) + r.first_);
+                    r.data_.shrink_to_fit();
+                    r.first_ = 0;
+                }
+            }
+        }
+
+        while (!groups_.empty() && groups_.back().empty())
+        {
+            groups_.pop_back();
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::insert_min_first
+        () const -> bool
+    {
+        // Deletion buffer is empty only if there are no runs.
+        return deleteFirst_ == deleteBuffer_.size()
+            || (!insertHeap_.empty() && Compare () (insertHeap_.front(), deleteBuffer_[deleteFirst_]));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::empty_check
+        () const -> void
+    {
+        if (this->empty())
+        {
+            throw std::out_of_range("Heap is empty!");
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto sequence_heap<T, Compare, Allocator>::heap_compare::operator()
+        (T const& lhs, T const& rhs) const -> bool
+    {
+        return Compare () (rhs, lhs);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto swap ( sequence_heap<T, Compare, Allocator>& lhs
+              , sequence_heap<T, Compare, Allocator>& rhs ) noexcept -> void
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,1626 @@
+#ifndef MIX_DS_STRICT_FIBONACCI_HEAP_HPP
+#define MIX_DS_STRICT_FIBONACCI_HEAP_HPP
+
+#include "pairing_heap.hpp"
+
+#include <functional>
+#include <utility>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <queue>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+
+namespace mix::ds
+{
+    /**
+        Node of a strict Fibonacci heap.
+     */
+    template<class T>
+    class strict_fib_node;
+
+    /**
+        Element of a strict Fibonacci heap. Items of two nodes are swapped
+        in decrease_key so handles point to items rather than to nodes.
+        Sequence number is unique among all items and breaks ties of keys.
+     */
+    template<class T>
+    class strict_fib_item
+    {
+    public:
+        template<class... Args>
+        strict_fib_item (std::piecewise_construct_t, Args&&... args);
+
+        T                   data_;
+        strict_fib_node<T>* node_;
+        std::uint64_t       seq_;
+    };
+
+    /**
+        Record of the heap a node belongs to. Meld makes all nodes
+        of the smaller heap passive at once by clearing its flag.
+     */
+    struct strict_fib_record
+    {
+        bool        active_;
+        std::size_t refs_;
+    };
+
+    template<class T>
+    class strict_fib_node
+    {
+    public:
+        using rank_t = unsigned int;
+
+        /**
+            Part of the fix-list the node is in.
+         */
+        enum class fix_t : unsigned char
+        {
+            none, root, loss_one, loss_many
+        };
+
+    public:
+        strict_fib_node (strict_fib_item<T>* const item);
+
+        auto is_active   () const -> bool;
+        auto active_sons () const -> rank_t;
+
+        strict_fib_item<T>* item_;
+        strict_fib_node*    parent_;
+        strict_fib_node*    left_;
+        strict_fib_node*    right_;
+        strict_fib_node*    child_;
+        strict_fib_node*    qPrev_;
+        strict_fib_node*    qNext_;
+        strict_fib_node*    fixPrev_;
+        strict_fib_node*    fixNext_;
+        strict_fib_record*  record_;
+        rank_t              rank_;
+        rank_t              loss_;
+        fix_t               fix_;
+        bool                active_;
+    };
+
+    /**
+        Iterator of the strict Fibonacci heap.
+     */
+    template<class T, class Compare, class Allocator, bool IsConst>
+    class strict_fibonacci_iterator;
+
+    /**
+        Strict Fibonacci heap.
+     */
+    template< class T
+            , class Compare   = std::less<T>
+            , class Allocator = std::allocator<T> >
+    class strict_fibonacci_heap;
+
+    /**
+        Item handle that is returned after an insertion
+        and can be used for decrease_key and erase.
+     */
+    template<class T, class Compare, class Allocator>
+    class strict_fibonacci_handle
+    {
+    public:
+        auto operator*  ()       -> T&;
+        auto operator*  () const -> T const&;
+        auto operator-> ()       -> T*;
+        auto operator-> () const -> T const*;
+
+    private:
+        using item_t = strict_fib_item<T>;
+        friend class strict_fibonacci_heap<T, Compare, Allocator>;
+        strict_fibonacci_handle(item_t* const item);
+        item_t* item_;
+    };
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    class strict_fibonacci_iterator
+    {
+    public:
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::conditional_t<IsConst, T const, T>;
+        using pointer           = value_type*;
+        using reference         = value_type&;
+        using iterator_category = std::forward_iterator_tag;
+        using node_t            = strict_fib_node<T>;
+
+    public:
+        strict_fibonacci_iterator () = default;
+        strict_fibonacci_iterator (node_t* const root);
+
+        auto operator++ ()       -> strict_fibonacci_iterator&;
+        auto operator++ (int)    -> strict_fibonacci_iterator;
+        auto operator*  () const -> reference;
+        auto operator-> () const -> pointer;
+        auto operator== (strict_fibonacci_iterator const&) const -> bool;
+        auto operator!= (strict_fibonacci_iterator const&) const -> bool;
+
+    private:
+        std::queue<node_t*> queue_;
+    };
+
+    /**
+        Strict Fibonacci heap (Brodal, Lagogiannis, Tarjan).
+        Single tree of active and passive nodes. Every operation ends with
+        a constant number of active root, root degree and loss reductions
+        (delete_min with as many as possible) which keep the root degree,
+        the number of active roots and the total loss logarithmic
+        without any amortization.
+        Unlike std::priority_queue in this heap an element "which is less"
+        has a higher priority.
+
+        @tparam T           The type of the stored elements.
+        @tparam Compare     Type providing a strict weak ordering.
+                            See https://en.cppreference.com/w/cpp/named_req/Compare
+        @tparam Allocator   Allocator. See https://en.cppreference.com/w/cpp/named_req/Allocator
+     */
+    template<class T, class Compare, class Allocator>
+    class strict_fibonacci_heap
+    {
+    public:
+        using node_t              = strict_fib_node<T>;
+        using item_t              = strict_fib_item<T>;
+        using record_t            = strict_fib_record;
+        using rank_t              = typename node_t::rank_t;
+        using fix_t               = typename node_t::fix_t;
+        using handle_t            = strict_fibonacci_handle<T, Compare, Allocator>;
+        using value_type          = T;
+        using reference           = T&;
+        using const_reference     = T const&;
+        using size_type           = std::size_t;
+        using difference_type     = std::ptrdiff_t;
+        using iterator            = strict_fibonacci_iterator<T, Compare, Allocator, false>;
+        using const_iterator      = strict_fibonacci_iterator<T, Compare, Allocator, true>;
+        using type_alloc_traits   = std::allocator_traits<Allocator>;
+        using node_alloc_traits   = typename type_alloc_traits::template rebind_traits<node_t>;
+        using node_allocator      = typename type_alloc_traits::template rebind_alloc<node_t>;
+        using item_alloc_traits   = typename type_alloc_traits::template rebind_traits<item_t>;
+        using item_allocator      = typename type_alloc_traits::template rebind_alloc<item_t>;
+        using record_alloc_traits = typename type_alloc_traits::template rebind_traits<record_t>;
+        using record_allocator    = typename type_alloc_traits::template rebind_alloc<record_t>;
+        using node_map            = std::unordered_map<node_t const*, node_t*>;
+
+    public:
+        strict_fibonacci_heap  (Allocator const& alloc = Allocator());
+        strict_fibonacci_heap  (strict_fibonacci_heap const& other);
+        strict_fibonacci_heap  (strict_fibonacci_heap&& other) noexcept;
+        ~strict_fibonacci_heap ();
+
+        auto operator= (strict_fibonacci_heap other) noexcept -> strict_fibonacci_heap&;
+
+        template<class... Args>
+        auto emplace      (Args&&... args)                      -> handle_t;
+        auto insert       (value_type const& value)             -> handle_t;
+        auto insert       (value_type&& value)                  -> handle_t;
+        auto delete_min   ()                                    -> void;
+        auto find_min     ()                                    -> reference;
+        auto find_min     () const                              -> const_reference;
+        auto decrease_key (handle_t const handle)               -> void;
+        auto meld         (strict_fibonacci_heap rhs)           -> strict_fibonacci_heap&;
+        auto erase        (handle_t const handle)               -> void;
+        auto swap         (strict_fibonacci_heap& rhs) noexcept -> void;
+        auto empty        () const                              -> bool;
+        auto size         () const                              -> size_type;
+        auto max_size     () const                              -> size_type;
+        auto clear        ()                                    -> void;
+        auto begin        ()                                    -> iterator;
+        auto end          ()                                    -> iterator;
+        auto begin        () const                              -> const_iterator;
+        auto end          () const                              -> const_iterator;
+        auto cbegin       () const                              -> const_iterator;
+        auto cend         () const                              -> const_iterator;
+
+    private:
+        /**
+            Active roots or nodes with loss one of the same rank.
+         */
+        struct fix_list
+        {
+            node_t*   first_   {nullptr};
+            size_type count_   {0};
+            bool      pending_ {false};
+        };
+
+        using node_pair = std::pair<node_t*, node_t*>;
+
+    private:
+        template<class... Args>
+        auto new_item       (Args&&... args)                     -> item_t*;
+        auto new_node       (item_t* const item)                 -> node_t*;
+        auto delete_item    (item_t* const item)                 -> void;
+        auto delete_node    (node_t* const node)                 -> void;
+        auto release        (record_t* const record)             -> void;
+        auto adopt          (node_t* const node)                 -> void;
+        auto activate       (node_t* const node)                 -> void;
+        auto passivate_all  ()                                   -> void;
+        auto insert_impl    (item_t* const item)                 -> handle_t;
+        auto erase_impl     (item_t* const item)                 -> void;
+        auto empty_check    () const                             -> void;
+        auto deep_copy      (strict_fibonacci_heap const& other) -> node_t*;
+        auto fix_insert     (node_t* const node)                 -> void;
+        auto fix_remove     (node_t* const node)                 -> void;
+        auto q_push_back    (node_t* const node)                 -> void;
+        auto q_remove       (node_t* const node)                 -> void;
+        auto q_append       (node_t* const first)                -> void;
+        auto add_child      (node_t* const child, node_t* const parent) -> void;
+        auto remove_child   (node_t* const child)                -> void;
+        auto active_root_reduction () -> bool;
+        auto root_degree_reduction () -> bool;
+        auto loss_reduction        () -> bool;
+
+        template<class Cmp = Compare>
+        auto dec_key_impl (item_t* const item) -> void;
+
+        template<class Cmp = Compare>
+        static auto item_less (item_t const* const lhs, item_t const* const rhs) -> bool;
+
+        template<class NodeOp>
+        auto for_each_node (NodeOp op) const -> void;
+
+        static auto is_active_root (node_t const* const node)                  -> bool;
+        static auto is_linkable    (node_t const* const node)                  -> bool;
+        static auto order          (node_t* const lhs, node_t* const rhs)      -> node_pair;
+        static auto list_push      ( std::vector<fix_list>& lists
+                                   , std::vector<rank_t>& pending
+                                   , node_t* const node ) -> void;
+        static auto list_remove    (std::vector<fix_list>& lists, node_t* const node) -> void;
+        static auto find_pair      ( std::vector<fix_list>& lists
+                                   , std::vector<rank_t>& pending ) -> node_pair;
+        static auto link_fix       (node_t*& first, node_t* const node)        -> void;
+        static auto unlink_fix     (node_t*& first, node_t* const node)        -> void;
+
+    private:
+        node_allocator        nodeAlloc_;
+        item_allocator        itemAlloc_;
+        record_allocator      recordAlloc_;
+        node_t*               root_;
+        size_type             size_;
+        node_t*               qHead_;
+        record_t*             record_;
+        std::vector<fix_list> roots_;
+        std::vector<fix_list> losses_;
+        std::vector<rank_t>   rootPairs_;
+        std::vector<rank_t>   lossPairs_;
+        node_t*               bigLosses_;
+    };
+
+    template<class T, class Compare, class Allocator>
+    auto meld ( strict_fibonacci_heap<T, Compare, Allocator>
+              , strict_fibonacci_heap<T, Compare, Allocator> ) noexcept
+              -> strict_fibonacci_heap<T, Compare, Allocator>;
+
+    template<class T, class Compare, class Allocator>
+    auto swap ( strict_fibonacci_heap<T, Compare, Allocator>&
+              , strict_fibonacci_heap<T, Compare, Allocator>& ) noexcept -> void;
+
+    template<class T, class Compare, class Allocator>
+    auto operator== ( strict_fibonacci_heap<T, Compare, Allocator> const&
+                    , strict_fibonacci_heap<T, Compare, Allocator> const& ) -> bool;
+
+    template<class T, class Compare, class Allocator>
+    auto operator!= ( strict_fibonacci_heap<T, Compare, Allocator> const&
+                    , strict_fibonacci_heap<T, Compare, Allocator> const& ) -> bool;
+
+/// definitions:
+
+    namespace strict_fib_impl
+    {
+        /**
+            Source of sequence numbers of items. Shared by all heaps
+            so that items of melded heaps never have the same number.
+         */
+        inline std::atomic<std::uint64_t> nextSeq {0};
+
+        /**
+            Calls f for each son of node. Sons form a circular list.
+         */
+        template<class T, class UnaryFunction>
+        auto for_each_son (strict_fib_node<T>* const node, UnaryFunction f) -> void
+        {
+            auto const first = node->child_;
+            if (!first)
+            {
+                return;
+            }
+
+            auto son = first;
+            do
+            {
+                auto const next = son->right_;
+                f(son);
+                son = next;
+            }
+            while (son != first);
+        }
+    }
+
+// strict_fib_item definition:
+
+    template<class T>
+    template<class... Args>
+    strict_fib_item<T>::strict_fib_item(std::piecewise_construct_t, Args&&... args) :
+        data_ (std::forward<Args>(args)...),
+        node_ (nullptr),
+        seq_  (strict_fib_impl::nextSeq.fetch_add(1, std::memory_order_relaxed))
+    {
+    }
+
+// strict_fib_node definition:
+
+    template<class T>
+    strict_fib_node<T>::strict_fib_node(strict_fib_item<T>* const item) :
+        item_    (item),
+        parent_  (nullptr),
+        left_    (this),
+        right_   (this),
+        child_   (nullptr),
+        qPrev_   (nullptr),
+        qNext_   (nullptr),
+        fixPrev_ (nullptr),
+        fixNext_ (nullptr),
+        record_  (nullptr),
+        rank_    (0),
+        loss_    (0),
+        fix_     (fix_t::none),
+        active_  (false)
+    {
+    }
+
+    template<class T>
+    auto strict_fib_node<T>::is_active
+        () const -> bool
+    {
+        return active_ && record_ && record_->active_;
+    }
+
+    template<class T>
+    auto strict_fib_node<T>::active_sons
+        () const -> rank_t
+    {
+        // Count is kept for passive nodes too but it expires with the record.
+        return record_ && record_->active_ ? rank_ : 0;
+    }
+
+// strict_fibonacci_handle definition:
+
+    template<class T, class Compare, class Allocator>
+    strict_fibonacci_handle<T, Compare, Allocator>::strict_fibonacci_handle(item_t* const item) :
+        item_ (item)
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_handle<T, Compare, Allocator>::operator*
+        () -> T&
+    {
+        return item_->data_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_handle<T, Compare, Allocator>::operator*
+        () const -> T const&
+    {
+        return item_->data_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_handle<T, Compare, Allocator>::operator->
+        () -> T*
+    {
+        return std::addressof(**this);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_handle<T, Compare, Allocator>::operator->
+        () const -> T const*
+    {
+        return std::addressof(**this);
+    }
+
+// strict_fibonacci_iterator definition:
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    strict_fibonacci_iterator<T, Compare, Allocator, IsConst>::strict_fibonacci_iterator
+        (node_t* const root) :
+        queue_ (std::deque {root})
+    {
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto strict_fibonacci_iterator<T, Compare, Allocator, IsConst>::operator++
+        () -> strict_fibonacci_iterator&
+    {
+        strict_fib_impl::for_each_son(queue_.front(), [this](auto const son)
+        {
+            queue_.push(son);
+        });
+        queue_.pop();
+        return *this;
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto strict_fibonacci_iterator<T, Compare, Allocator, IsConst>::operator++
+        (int) -> strict_fibonacci_iterator
+    {
+        auto const ret = *this;
+        ++(*this);
+        return ret;
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto strict_fibonacci_iterator<T, Compare, Allocator, IsConst>::operator*
+        () const -> reference
+    {
+        return queue_.front()->item_->data_;
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto strict_fibonacci_iterator<T, Compare, Allocator, IsConst>::operator->
+        () const -> pointer
+    {
+        return std::addressof(**this);
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto strict_fibonacci_iterator<T, Compare, Allocator, IsConst>::operator==
+        (strict_fibonacci_iterator const& rhs) const -> bool
+    {
+        return (queue_.empty() && rhs.queue_.empty())
+            || (queue_.size()  == rhs.queue_.size()
+            &&  queue_.front() == rhs.queue_.front());
+    }
+
+    template<class T, class Compare, class Allocator, bool IsConst>
+    auto strict_fibonacci_iterator<T, Compare, Allocator, IsConst>::operator!=
+        (strict_fibonacci_iterator const& rhs) const -> bool
+    {
+        return !(*this == rhs);
+    }
+
+// strict_fibonacci_heap definition:
+
+    template<class T, class Compare, class Allocator>
+    strict_fibonacci_heap<T, Compare, Allocator>::strict_fibonacci_heap
+        (Allocator const& alloc) :
+        nodeAlloc_   (alloc),
+        itemAlloc_   (alloc),
+        recordAlloc_ (alloc),
+        root_        (nullptr),
+        size_        (0),
+        qHead_       (nullptr),
+        record_      (nullptr),
+        roots_       (),
+        losses_      (),
+        rootPairs_   (),
+        lossPairs_   (),
+        bigLosses_   (nullptr)
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    strict_fibonacci_heap<T, Compare, Allocator>::strict_fibonacci_heap
+        (strict_fibonacci_heap const& other) :
+        nodeAlloc_   (other.nodeAlloc_),
+        itemAlloc_   (other.itemAlloc_),
+        recordAlloc_ (other.recordAlloc_),
+        root_        (nullptr),
+        size_        (other.size_),
+        qHead_       (nullptr),
+        record_      (nullptr),
+        roots_       (),
+        losses_      (),
+        rootPairs_   (),
+        lossPairs_   (),
+        bigLosses_   (nullptr)
+    {
+        // Q and the fix-list are rebuilt by deep_copy so the members must exist first.
+        root_ = this->deep_copy(other);
+    }
+
+    template<class T, class Compare, class Allocator>
+    strict_fibonacci_heap<T, Compare, Allocator>::strict_fibonacci_heap
+        (strict_fibonacci_heap&& other) noexcept :
+        nodeAlloc_   (std::move(other.nodeAlloc_)),
+        itemAlloc_   (std::move(other.itemAlloc_)),
+        recordAlloc_ (std::move(other.recordAlloc_)),
+        root_        (std::exchange(other.root_, nullptr)),
+        size_        (std::exchange(other.size_, 0)),
+        qHead_       (std::exchange(other.qHead_, nullptr)),
+        record_      (std::exchange(other.record_, nullptr)),
+        roots_       (std::move(other.roots_)),
+        losses_      (std::move(other.losses_)),
+        rootPairs_   (std::move(other.rootPairs_)),
+        lossPairs_   (std::move(other.lossPairs_)),
+        bigLosses_   (std::exchange(other.bigLosses_, nullptr))
+    {
+    }
+
+    template<class T, class Compare, class Allocator>
+    strict_fibonacci_heap<T, Compare, Allocator>::~strict_fibonacci_heap()
+    {
+        this->clear();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::operator=
+        (strict_fibonacci_heap other) noexcept -> strict_fibonacci_heap&
+    {
+        this->swap(other);
+        return *this;
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::emplace
+        (Args&&... args) -> handle_t
+    {
+        return this->insert_impl(this->new_item(std::forward<Args>(args)...));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::insert
+        (value_type const& value) -> handle_t
+    {
+        return this->insert_impl(this->new_item(value));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::insert
+        (value_type&& value) -> handle_t
+    {
+        return this->insert_impl(this->new_item(std::move(value)));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::delete_min
+        () -> void
+    {
+        this->empty_check();
+        auto const oldRoot = root_;
+        this->delete_item(oldRoot->item_);
+        --size_;
+
+        if (!oldRoot->child_)
+        {
+            root_ = nullptr;
+            this->delete_node(oldRoot);
+            return;
+        }
+
+        // Son with the minimal key becomes the new root.
+        auto newRoot = oldRoot->child_;
+        strict_fib_impl::for_each_son(oldRoot, [&newRoot](auto const son)
+        {
+            if (strict_fibonacci_heap::item_less(son->item_, newRoot->item_))
+            {
+                newRoot = son;
+            }
+        });
+
+        this->remove_child(newRoot);
+        this->q_remove(newRoot);
+
+        // Root is passive so active sons of the new root become active roots.
+        if (newRoot->is_active())
+        {
+            this->fix_remove(newRoot);
+            newRoot->active_ = false;
+            newRoot->loss_   = 0;
+
+            strict_fib_impl::for_each_son(newRoot, [this](auto const son)
+            {
+                if (son->is_active())
+                {
+                    this->fix_remove(son);
+                    son->loss_ = 0;
+                    this->fix_insert(son);
+                }
+            });
+        }
+
+        while (oldRoot->child_)
+        {
+            auto const son = oldRoot->child_;
+            this->remove_child(son);
+            this->add_child(son, newRoot);
+        }
+
+        root_ = newRoot;
+        this->delete_node(oldRoot);
+
+        // First two nodes of Q move to its end and give up to two passive sons to the root.
+        for (auto i = 0; i < 2 && qHead_; ++i)
+        {
+            auto const node = qHead_;
+            qHead_ = qHead_->qNext_;
+
+            for (auto j = 0; j < 2 && node->child_; ++j)
+            {
+                auto const son = node->child_->left_;
+                if (son->is_active())
+                {
+                    break;
+                }
+
+                this->remove_child(son);
+                this->add_child(son, root_);
+            }
+        }
+
+        while (this->loss_reduction())
+        {
+        }
+
+        while (this->active_root_reduction() || this->root_degree_reduction())
+        {
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::find_min
+        () -> reference
+    {
+        this->empty_check();
+        return root_->item_->data_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::find_min
+        () const -> const_reference
+    {
+        this->empty_check();
+        return root_->item_->data_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::decrease_key
+        (handle_t const handle) -> void
+    {
+        this->dec_key_impl(handle.item_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::meld
+        (strict_fibonacci_heap rhs) -> strict_fibonacci_heap&
+    {
+        if (!rhs.root_)
+        {
+            return *this;
+        }
+
+        if (size_ < rhs.size_)
+        {
+            this->swap(rhs);
+        }
+
+        if (!rhs.root_)
+        {
+            return *this;
+        }
+
+        // Nodes of the smaller heap become passive at once.
+        rhs.passivate_all();
+
+        auto const otherRoot = std::exchange(rhs.root_, nullptr);
+        auto const otherQ    = std::exchange(rhs.qHead_, nullptr);
+
+        if (strict_fibonacci_heap::item_less(otherRoot->item_, root_->item_))
+        {
+            this->add_child(root_, otherRoot);
+            this->q_push_back(root_);
+            root_ = otherRoot;
+        }
+        else
+        {
+            this->add_child(otherRoot, root_);
+            this->q_push_back(otherRoot);
+        }
+
+        this->q_append(otherQ);
+        size_ += std::exchange(rhs.size_, 0);
+
+        this->active_root_reduction();
+        this->root_degree_reduction();
+        return *this;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::erase
+        (handle_t const handle) -> void
+    {
+        this->erase_impl(handle.item_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::swap
+        (strict_fibonacci_heap& rhs) noexcept -> void
+    {
+        using std::swap;
+        swap(root_, rhs.root_);
+        swap(size_, rhs.size_);
+        swap(qHead_, rhs.qHead_);
+        swap(record_, rhs.record_);
+        swap(roots_, rhs.roots_);
+        swap(losses_, rhs.losses_);
+        swap(rootPairs_, rhs.rootPairs_);
+        swap(lossPairs_, rhs.lossPairs_);
+        swap(bigLosses_, rhs.bigLosses_);
+
+        if constexpr (node_alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(nodeAlloc_, rhs.nodeAlloc_);
+        }
+
+        if constexpr (item_alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(itemAlloc_, rhs.itemAlloc_);
+        }
+
+        if constexpr (record_alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(recordAlloc_, rhs.recordAlloc_);
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::empty
+        () const -> bool
+    {
+        return 0 == this->size();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::size
+        () const -> size_type
+    {
+        return size_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::max_size
+        () const -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::clear
+        () -> void
+    {
+        this->for_each_node([this](auto const node)
+        {
+            this->delete_item(node->item_);
+            this->delete_node(node);
+        });
+        this->release(record_);
+
+        root_      = nullptr;
+        size_      = 0;
+        qHead_     = nullptr;
+        record_    = nullptr;
+        bigLosses_ = nullptr;
+        roots_.clear();
+        losses_.clear();
+        rootPairs_.clear();
+        lossPairs_.clear();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::begin
+        () -> iterator
+    {
+        return root_ ? iterator(root_) : iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::end
+        () -> iterator
+    {
+        return iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::begin
+        () const -> const_iterator
+    {
+        return this->cbegin();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::end
+        () const -> const_iterator
+    {
+        return this->cend();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::cbegin
+        () const -> const_iterator
+    {
+        return root_ ? const_iterator(root_) : const_iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::cend
+        () const -> const_iterator
+    {
+        return const_iterator();
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class... Args>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::new_item
+        (Args&&... args) -> item_t*
+    {
+        auto const p = item_alloc_traits::allocate(itemAlloc_, 1);
+        item_alloc_traits::construct(itemAlloc_, p, std::piecewise_construct, std::forward<Args>(args)...);
+        return p;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::new_node
+        (item_t* const item) -> node_t*
+    {
+        auto const p = node_alloc_traits::allocate(nodeAlloc_, 1);
+        node_alloc_traits::construct(nodeAlloc_, p, item);
+        item->node_ = p;
+        return p;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::delete_item
+        (item_t* const item) -> void
+    {
+        item_alloc_traits::destroy(itemAlloc_, item);
+        item_alloc_traits::deallocate(itemAlloc_, item, 1);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::delete_node
+        (node_t* const node) -> void
+    {
+        this->release(node->record_);
+        node_alloc_traits::destroy(nodeAlloc_, node);
+        node_alloc_traits::deallocate(nodeAlloc_, node, 1);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::release
+        (record_t* const record) -> void
+    {
+        if (record && 0 == --record->refs_)
+        {
+            record_alloc_traits::destroy(recordAlloc_, record);
+            record_alloc_traits::deallocate(recordAlloc_, record, 1);
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::adopt
+        (node_t* const node) -> void
+    {
+        if (node->record_ && node->record_ == record_)
+        {
+            return;
+        }
+
+        if (!record_)
+        {
+            // The heap holds one reference itself.
+            record_ = record_alloc_traits::allocate(recordAlloc_, 1);
+            record_alloc_traits::construct(recordAlloc_, record_, record_t {true, 1});
+        }
+
+        // Node from a heap that was made passive starts from scratch.
+        node->active_ = false;
+        node->rank_   = 0;
+        node->loss_   = 0;
+        this->release(node->record_);
+        node->record_ = record_;
+        ++record_->refs_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::activate
+        (node_t* const node) -> void
+    {
+        this->adopt(node);
+        node->active_ = true;
+        node->loss_   = 0;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::passivate_all
+        () -> void
+    {
+        if (record_)
+        {
+            record_->active_ = false;
+            this->release(std::exchange(record_, nullptr));
+        }
+
+        roots_.clear();
+        losses_.clear();
+        rootPairs_.clear();
+        lossPairs_.clear();
+        bigLosses_ = nullptr;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::insert_impl
+        (item_t* const item) -> handle_t
+    {
+        auto const node = this->new_node(item);
+        ++size_;
+
+        if (!root_)
+        {
+            root_ = node;
+        }
+        else if (strict_fibonacci_heap::item_less(item, root_->item_))
+        {
+            this->add_child(root_, node);
+            this->q_push_back(root_);
+            root_ = node;
+        }
+        else
+        {
+            this->add_child(node, root_);
+            this->q_push_back(node);
+        }
+
+        this->active_root_reduction();
+        this->root_degree_reduction();
+        return handle_t(item);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::erase_impl
+        (item_t* const item) -> void
+    {
+        this->dec_key_impl<aux_impl::always_true_cmp>(item);
+        this->delete_min();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::empty_check
+        () const -> void
+    {
+        if (this->empty())
+        {
+            throw std::out_of_range("Heap is empty!");
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::deep_copy
+        (strict_fibonacci_heap const& other) -> node_t*
+    {
+        if (!other.root_)
+        {
+            return nullptr;
+        }
+
+        // Nodes are visited parents first, see item_less.
+        auto map = node_map();
+        map.reserve(other.size() + 1);
+        other.for_each_node([&map, this](auto const node)
+        {
+            auto const copy = this->new_node(this->new_item(node->item_->data_));
+            this->adopt(copy);
+            copy->active_ = node->is_active();
+            copy->rank_   = node->active_sons();
+            copy->loss_   = node->loss_;
+            map.emplace(node, copy);
+        });
+        map.emplace(nullptr, nullptr);
+
+        for (auto [original, copy] : map)
+        {
+            if (original)
+            {
+                copy->parent_ = map.at(original->parent_);
+                copy->left_   = map.at(original->left_);
+                copy->right_  = map.at(original->right_);
+                copy->child_  = map.at(original->child_);
+            }
+        }
+
+        // Q keeps its order, the fix-list does not need to.
+        if (auto q = other.qHead_)
+        {
+            do
+            {
+                this->q_push_back(map.at(q));
+                q = q->qNext_;
+            }
+            while (q != other.qHead_);
+        }
+
+        for (auto [original, copy] : map)
+        {
+            if (original && copy->is_active())
+            {
+                this->fix_insert(copy);
+            }
+        }
+
+        return map.at(other.root_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::fix_insert
+        (node_t* const node) -> void
+    {
+        if (strict_fibonacci_heap::is_active_root(node))
+        {
+            node->fix_ = fix_t::root;
+            strict_fibonacci_heap::list_push(roots_, rootPairs_, node);
+        }
+        else if (1 == node->loss_)
+        {
+            node->fix_ = fix_t::loss_one;
+            strict_fibonacci_heap::list_push(losses_, lossPairs_, node);
+        }
+        else if (node->loss_ > 1)
+        {
+            node->fix_ = fix_t::loss_many;
+            strict_fibonacci_heap::link_fix(bigLosses_, node);
+        }
+        else
+        {
+            node->fix_ = fix_t::none;
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::fix_remove
+        (node_t* const node) -> void
+    {
+        switch (node->fix_)
+        {
+            case fix_t::root:
+                strict_fibonacci_heap::list_remove(roots_, node);
+                break;
+
+            case fix_t::loss_one:
+                strict_fibonacci_heap::list_remove(losses_, node);
+                break;
+
+            case fix_t::loss_many:
+                strict_fibonacci_heap::unlink_fix(bigLosses_, node);
+                break;
+
+            case fix_t::none:
+                break;
+        }
+
+        node->fix_ = fix_t::none;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::q_push_back
+        (node_t* const node) -> void
+    {
+        if (!qHead_)
+        {
+            node->qPrev_ = node;
+            node->qNext_ = node;
+            qHead_       = node;
+        }
+        else
+        {
+            auto const last = qHead_->qPrev_;
+            node->qPrev_    = last;
+            node->qNext_    = qHead_;
+            last->qNext_    = node;
+            qHead_->qPrev_  = node;
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::q_remove
+        (node_t* const node) -> void
+    {
+        if (node->qNext_ == node)
+        {
+            qHead_ = nullptr;
+        }
+        else
+        {
+            node->qPrev_->qNext_ = node->qNext_;
+            node->qNext_->qPrev_ = node->qPrev_;
+            if (qHead_ == node)
+            {
+                qHead_ = node->qNext_;
+            }
+        }
+
+        node->qPrev_ = nullptr;
+        node->qNext_ = nullptr;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::q_append
+        (node_t* const first) -> void
+    {
+        if (!first)
+        {
+            return;
+        }
+
+        if (!qHead_)
+        {
+            qHead_ = first;
+            return;
+        }
+
+        auto const lastThis  = qHead_->qPrev_;
+        auto const lastOther = first->qPrev_;
+        lastThis->qNext_  = first;
+        first->qPrev_     = lastThis;
+        lastOther->qNext_ = qHead_;
+        qHead_->qPrev_    = lastOther;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::active_root_reduction
+        () -> bool
+    {
+        auto const [lhs, rhs] = strict_fibonacci_heap::find_pair(roots_, rootPairs_);
+        if (!lhs)
+        {
+            return false;
+        }
+
+        auto const [parent, son] = strict_fibonacci_heap::order(lhs, rhs);
+        this->fix_remove(parent);
+        this->fix_remove(son);
+        this->remove_child(son);
+        this->add_child(son, parent);
+        this->fix_insert(parent);
+
+        auto const last = parent->child_->left_;
+        if (!last->is_active())
+        {
+            this->remove_child(last);
+            this->add_child(last, root_);
+        }
+
+        return true;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::root_degree_reduction
+        () -> bool
+    {
+        if (!root_->child_)
+        {
+            return false;
+        }
+
+        auto x = root_->child_->left_;
+        auto y = x->left_;
+        auto z = y->left_;
+
+        if (y == x || z == x)
+        {
+            return false;
+        }
+
+        if ( !strict_fibonacci_heap::is_linkable(x)
+          || !strict_fibonacci_heap::is_linkable(y)
+          || !strict_fibonacci_heap::is_linkable(z) )
+        {
+            return false;
+        }
+
+        this->remove_child(x);
+        this->remove_child(y);
+        this->remove_child(z);
+
+        auto const less = [](auto const lhs, auto const rhs)
+        {
+            return strict_fibonacci_heap::item_less(lhs->item_, rhs->item_);
+        };
+
+        if (less(y, x)) std::swap(x, y);
+        if (less(z, y)) std::swap(y, z);
+        if (less(y, x)) std::swap(x, y);
+
+        // x becomes an active root of rank one with y as its active son.
+        this->activate(x);
+        this->activate(y);
+        this->add_child(z, y);
+        this->add_child(y, x);
+        this->add_child(x, root_);
+        this->fix_insert(x);
+        this->fix_insert(y);
+
+        return true;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::loss_reduction
+        () -> bool
+    {
+        if (bigLosses_)
+        {
+            // One node with loss at least two is moved to the root.
+            auto const node   = bigLosses_;
+            auto const parent = node->parent_;
+            this->fix_remove(node);
+            this->fix_remove(parent);
+            this->remove_child(node);
+            this->add_child(node, root_);
+            node->loss_ = 0;
+            this->fix_insert(node);
+
+            if (!strict_fibonacci_heap::is_active_root(parent))
+            {
+                ++parent->loss_;
+            }
+            this->fix_insert(parent);
+            return true;
+        }
+
+        auto const [lhs, rhs] = strict_fibonacci_heap::find_pair(losses_, lossPairs_);
+        if (!lhs)
+        {
+            return false;
+        }
+
+        // Two nodes with loss one and the same rank are linked.
+        auto const [parent, son] = strict_fibonacci_heap::order(lhs, rhs);
+        auto const oldParent     = son->parent_;
+        this->fix_remove(parent);
+        this->fix_remove(son);
+        if (oldParent != parent)
+        {
+            this->fix_remove(oldParent);
+        }
+
+        this->remove_child(son);
+        this->add_child(son, parent);
+        parent->loss_ = 0;
+        son->loss_    = 0;
+
+        if (oldParent != parent)
+        {
+            if (!strict_fibonacci_heap::is_active_root(oldParent))
+            {
+                ++oldParent->loss_;
+            }
+            this->fix_insert(oldParent);
+        }
+
+        this->fix_insert(parent);
+        this->fix_insert(son);
+        return true;
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class Cmp>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::dec_key_impl
+        (item_t* const item) -> void
+    {
+        auto const node = item->node_;
+        if (node == root_)
+        {
+            return;
+        }
+
+        // New minimum goes to the root node, the node keeps the old one
+        // and is moved under the root below just as any other.
+        if (strict_fibonacci_heap::item_less<Cmp>(item, root_->item_))
+        {
+            auto const rootItem = root_->item_;
+            root_->item_    = item;
+            node->item_     = rootItem;
+            item->node_     = root_;
+            rootItem->node_ = node;
+        }
+
+        auto const parent = node->parent_;
+        if (parent == root_)
+        {
+            this->loss_reduction();
+            return;
+        }
+
+        auto const isActive       = node->is_active();
+        auto const isParentActive = parent->is_active();
+
+        if (isActive)
+        {
+            this->fix_remove(node);
+            if (isParentActive)
+            {
+                this->fix_remove(parent);
+            }
+        }
+
+        this->remove_child(node);
+        this->add_child(node, root_);
+
+        if (isActive)
+        {
+            node->loss_ = 0;
+            this->fix_insert(node);
+
+            if (isParentActive)
+            {
+                if (!strict_fibonacci_heap::is_active_root(parent))
+                {
+                    ++parent->loss_;
+                }
+                this->fix_insert(parent);
+            }
+        }
+
+        this->loss_reduction();
+
+        for (auto i = 0; i < 6; ++i)
+        {
+            this->active_root_reduction();
+        }
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            this->root_degree_reduction();
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    template<class NodeOp>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::for_each_node
+        (NodeOp op) const -> void
+    {
+        if (!root_)
+        {
+            return;
+        }
+
+        // Sons are collected first so that op is free to delete the node.
+        auto stack = std::vector<node_t*> {root_};
+        while (!stack.empty())
+        {
+            auto const node = stack.back();
+            stack.pop_back();
+            strict_fib_impl::for_each_son(node, [&stack](auto const son)
+            {
+                stack.emplace_back(son);
+            });
+            op(node);
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::add_child
+        (node_t* const child, node_t* const parent) -> void
+    {
+        child->parent_ = parent;
+
+        if (child->is_active())
+        {
+            this->adopt(parent);
+            ++parent->rank_;
+        }
+
+        if (!parent->child_)
+        {
+            child->left_   = child;
+            child->right_  = child;
+            parent->child_ = child;
+            return;
+        }
+
+        auto const first = parent->child_;
+        auto const last  = first->left_;
+        child->left_  = last;
+        child->right_ = first;
+        last->right_  = child;
+        first->left_  = child;
+
+        // Linkable passive sons are kept on the right end, others on the left.
+        if (!strict_fibonacci_heap::is_linkable(child))
+        {
+            parent->child_ = child;
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::remove_child
+        (node_t* const child) -> void
+    {
+        auto const parent = child->parent_;
+
+        if (child->is_active())
+        {
+            --parent->rank_;
+        }
+
+        if (child->right_ == child)
+        {
+            parent->child_ = nullptr;
+        }
+        else
+        {
+            child->left_->right_ = child->right_;
+            child->right_->left_ = child->left_;
+            if (parent->child_ == child)
+            {
+                parent->child_ = child->right_;
+            }
+        }
+
+        child->parent_ = nullptr;
+        child->left_   = child;
+        child->right_  = child;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::is_active_root
+        (node_t const* const node) -> bool
+    {
+        return node->is_active() && !node->parent_->is_active();
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::is_linkable
+        (node_t const* const node) -> bool
+    {
+        return !node->is_active() && 0 == node->active_sons();
+    }
+
+    /**
+        Strict total order of items used for all links. Equal keys are
+        ordered by sequence number of the item so the heap is ordered by
+        (key, sequence number) and a descendant is never less than its
+        ancestor. Links thus stay O(1) and can not create a cycle even
+        if many keys are equal. Copy creates items parents first so their
+        new numbers keep the order.
+     */
+    template<class T, class Compare, class Allocator>
+    template<class Cmp>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::item_less
+        (item_t const* const lhs, item_t const* const rhs) -> bool
+    {
+        return Cmp () (lhs->data_, rhs->data_)
+            || (!Cmp () (rhs->data_, lhs->data_) && lhs->seq_ < rhs->seq_);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::order
+        (node_t* const lhs, node_t* const rhs) -> node_pair
+    {
+        return strict_fibonacci_heap::item_less(rhs->item_, lhs->item_)
+            ? node_pair {rhs, lhs}
+            : node_pair {lhs, rhs};
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::list_push
+        (std::vector<fix_list>& lists, std::vector<rank_t>& pending, node_t* const node) -> void
+    {
+        auto const rank = node->rank_;
+        if (rank >= lists.size())
+        {
+            lists.resize(rank + 1);
+        }
+
+        auto& list = lists[rank];
+        strict_fibonacci_heap::link_fix(list.first_, node);
+        ++list.count_;
+
+        if (list.count_ > 1 && !list.pending_)
+        {
+            list.pending_ = true;
+            pending.emplace_back(rank);
+        }
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::list_remove
+        (std::vector<fix_list>& lists, node_t* const node) -> void
+    {
+        auto& list = lists[node->rank_];
+        strict_fibonacci_heap::unlink_fix(list.first_, node);
+        --list.count_;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::find_pair
+        (std::vector<fix_list>& lists, std::vector<rank_t>& pending) -> node_pair
+    {
+        // Ranks are pushed when a list gets a second node and dropped lazily.
+        while (!pending.empty())
+        {
+            auto& list = lists[pending.back()];
+            if (list.count_ > 1)
+            {
+                return node_pair {list.first_, list.first_->fixNext_};
+            }
+
+            list.pending_ = false;
+            pending.pop_back();
+        }
+
+        return node_pair {nullptr, nullptr};
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::link_fix
+        (node_t*& first, node_t* const node) -> void
+    {
+        node->fixPrev_ = nullptr;
+        node->fixNext_ = first;
+        if (first)
+        {
+            first->fixPrev_ = node;
+        }
+        first = node;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto strict_fibonacci_heap<T, Compare, Allocator>::unlink_fix
+        (node_t*& first, node_t* const node) -> void
+    {
+        if (node->fixPrev_)
+        {
+            node->fixPrev_->fixNext_ = node->fixNext_;
+        }
+        else
+        {
+            first = node->fixNext_;
+        }
+
+        if (node->fixNext_)
+        {
+            node->fixNext_->fixPrev_ = node->fixPrev_;
+        }
+
+        node->fixPrev_ = nullptr;
+        node->fixNext_ = nullptr;
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto meld ( strict_fibonacci_heap<T, Compare, Allocator> lhs
+              , strict_fibonacci_heap<T, Compare, Allocator> rhs ) noexcept
+              -> strict_fibonacci_heap<T, Compare, Allocator>
+    {
+        lhs.meld(std::move(rhs));
+        return strict_fibonacci_heap<T, Compare, Allocator>(std::move(lhs));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto swap ( strict_fibonacci_heap<T, Compare, Allocator>& lhs
+              , strict_fibonacci_heap<T, Compare, Allocator>& rhs ) noexcept -> void
+    {
+        lhs.swap(rhs);
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto operator== ( strict_fibonacci_heap<T, Compare, Allocator> const& lhs
+                    , strict_fibonacci_heap<T, Compare, Allocator> const& rhs ) -> bool
+    {
+        return lhs.size() == rhs.size()
+            && std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs));
+    }
+
+    template<class T, class Compare, class Allocator>
+    auto operator!= ( strict_fibonacci_heap<T, Compare, Allocator> const& lhs
+                    , strict_fibonacci_heap<T, Compare, Allocator> const& rhs ) -> bool
+    {
+        return ! (lhs == rhs);
+    }
+}
+
+#endif
@@ -2,12 +2,25 @@
 #include "lib/simple_map.hpp"
 #include "lib/brodal_queue.hpp"
 #include "lib/fibonacci_heap.hpp"
+#include "lib/radix_heap.hpp"
+#include "lib/intrusive_pairing_heap.hpp"
+#include "lib/cached_key_heap.hpp"
+#include "lib/hollow_heap.hpp"
+#include "lib/rank_pairing_heap.hpp"
+#include "lib/strict_fibonacci_heap.hpp"
+#include "lib/d_ary_heap.hpp"
+#include "lib/sequence_heap.hpp"
+#include "lib/multi_queue.hpp"
+#include "lib/mpsc_heap.hpp"
 #include "test/queue_test.hpp"
 #include "test/map_test.hpp"
 #include "test/brodal_test.hpp"
+#include "test/routing_test.hpp"
 #include "utils/stopwatch.hpp"
 #include "compare/boost_heap.hpp"
 #include "compare/dijkstra.hpp"
+#include "compare/plain_heap.hpp"
+#include "compare/locked_heap.hpp"
 
 #include <map>
 #include <iomanip>
@@ -23,6 +36,8 @@ auto test_pairing_heap()
     // queue_test_random_all <pairing_heap, merge_modes::fifo_queue> (n, seed);
     // queue_test_other <pairing_heap, merge_modes::two_pass>   (n, seed);    
     // queue_test_other <pairing_heap, merge_modes::fifo_queue> (n, seed);
+    // queue_test_bulk_build <pairing_heap, merge_modes::two_pass> (n, 8, seed);
+    // queue_test_bulk_build_time <pairing_heap, merge_modes::two_pass> (100'000'000, 64, seed);
 }
 
 auto test_simple_map()
@@ -43,9 +58,10 @@ auto test_brodal_queue()
     // real_test_brodal_queue();
 
     // auto constexpr seed = 1212121;
-    // test_dijkstra_to_point<pairing_heap>(2000, seed);
-    // test_dijkstra_to_point<boost_pairing_heap>(2000, seed);
-    // test_dijkstra_to_point<brodal_queue>(2000, seed);
+    // auto graph = make_grid_graph(300, 300, 1'000, seed);
+    // test_dijkstra_to_point<pairing_heap>(graph, 2000, seed);
+    // test_dijkstra_to_point<boost_pairing_heap>(graph, 2000, seed);
+    // test_dijkstra_to_point<brodal_queue>(graph, 2000, seed);
 }
 
 auto test_fibonacci_heap()
@@ -57,15 +73,258 @@ auto test_fibonacci_heap()
     queue_test_other <fibonacci_heap> (n, seed);;
 }
 
+auto test_intrusive_pairing_heap()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 3216541;
+    auto constexpr n    = 1'000'000;
+    queue_test_intrusive <merge_modes::two_pass>   (n, seed);
+    queue_test_intrusive <merge_modes::fifo_queue> (n, seed);
+}
+
+// Cached key heaps require Compare::key so the tests' std::less is replaced.
+template<class T, class Compare>
+using cached_pairing_test_heap = mix::ds::cached_pairing_heap<T, mix::ds::test_key_compare>;
+
+template<class T, class Compare>
+using cached_fibonacci_test_heap = mix::ds::cached_fibonacci_heap<T, mix::ds::test_key_compare>;
+
+auto test_cached_key_heap()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 9843215;
+    auto constexpr n    = 1'000'000;
+    queue_test_random_all <cached_pairing_test_heap>   (n, seed);
+    queue_test_random_all <cached_fibonacci_test_heap> (n, seed);
+    queue_test_monotone   <cached_pairing_test_heap>   (n, seed);
+    queue_test_decrease   <cached_pairing_test_heap>   (n, seed);
+    queue_test_erase      <cached_pairing_test_heap>   (n, seed);
+    queue_test_meld       <cached_pairing_test_heap>   (n, seed);
+    queue_test_other      <cached_pairing_test_heap>   (n, seed);
+}
+
+auto test_hollow_heap()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 7784512;
+    auto constexpr n    = 1'000'000;
+    queue_test_random_all <hollow_heap> (n, seed);
+    queue_test_monotone   <hollow_heap> (n, seed);
+    queue_test_decrease   <hollow_heap> (n, seed);
+    queue_test_erase      <hollow_heap> (n, seed);
+    queue_test_copy       <hollow_heap> (n, seed);
+    queue_test_meld       <hollow_heap> (n, seed);
+    queue_test_other      <hollow_heap> (n, seed);
+}
+
+auto test_rank_pairing_heap()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 4512365;
+    auto constexpr n    = 1'000'000;
+    queue_test_random_all <rank_pairing_heap, rank_rules::type_1> (n, seed);
+    queue_test_random_all <rank_pairing_heap, rank_rules::type_2> (n, seed);
+    queue_test_monotone   <rank_pairing_heap> (n, seed);
+    queue_test_decrease   <rank_pairing_heap> (n, seed);
+    queue_test_erase      <rank_pairing_heap> (n, seed);
+    queue_test_copy       <rank_pairing_heap> (n, seed);
+    queue_test_meld       <rank_pairing_heap> (n, seed);
+    queue_test_other      <rank_pairing_heap> (n, seed);
+}
+
+auto test_strict_fibonacci_heap()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 6321458;
+    auto constexpr n    = 1'000'000;
+    queue_test_random_all <strict_fibonacci_heap> (n, seed);
+    queue_test_monotone   <strict_fibonacci_heap> (n, seed);
+    queue_test_decrease   <strict_fibonacci_heap> (n, seed);
+    queue_test_erase      <strict_fibonacci_heap> (n, seed);
+    queue_test_copy       <strict_fibonacci_heap> (n, seed);
+    queue_test_meld       <strict_fibonacci_heap> (n, seed);
+    queue_test_other      <strict_fibonacci_heap> (n, seed);
+}
+
+auto test_d_ary_heap()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 8451326;
+    auto constexpr n    = 1'000'000;
+    queue_test_insert     <d_ary_heap> (n, seed);
+    queue_test_delete     <d_ary_heap> (n, seed);
+    queue_test_random_all <d_ary_heap, heap_arity<2>> (n, seed);
+    queue_test_random_all <d_ary_heap, heap_arity<4>> (n, seed);
+    queue_test_random_all <d_ary_heap, heap_arity<8>> (n, seed);
+    queue_test_monotone   <d_ary_heap> (n, seed);
+    queue_test_decrease   <d_ary_heap> (n, seed);
+    queue_test_erase      <d_ary_heap> (n, seed);
+    queue_test_copy       <d_ary_heap> (n, seed);
+    queue_test_meld       <d_ary_heap> (n, seed);
+    queue_test_other      <d_ary_heap> (n, seed);
+    queue_test_test       <d_ary_heap> (seed);
+}
+
+auto test_sequence_heap()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 3548712;
+    auto constexpr n    = 3'000'000;
+    queue_test_plain <sequence_heap> (n, seed);
+    queue_test_plain <sequence_heap> (1'000, seed);
+}
+
+auto test_external_heap()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 2315487;
+    queue_test_external      (1'000'000, 1 << 20, seed);
+    queue_test_external_bulk (10'000'000, 1 << 24, seed);
+    // 1B elements take 16 GB of disk.
+    // queue_test_external_bulk (1'000'000'000, 1 << 28, seed);
+}
+
+auto test_multi_queue()
+{
+    using namespace mix::ds;
+    auto constexpr seed        = 9632145;
+    auto constexpr n           = 1'000'000;
+    auto constexpr threadCount = 4;
+    auto constexpr relaxation  = 2;
+
+    auto const make_multi = [&](auto const threads)
+    {
+        return std::make_unique<multi_queue<test_t>>(threads, relaxation);
+    };
+
+    auto const make_locked = [](auto)
+    {
+        return std::make_unique<locked_heap<test_t>>();
+    };
+
+    queue_test_concurrent(make_multi, threadCount, n);
+    queue_test_concurrent(make_locked, threadCount, n);
+    queue_test_scaling(make_multi, threadCount, n, 100'000, seed);
+    queue_test_scaling(make_locked, threadCount, n, 100'000, seed);
+    // queue_test_scaling(make_multi, 64, n, 1'000'000, seed);
+    // queue_test_scaling(make_locked, 64, n, 1'000'000, seed);
+}
+
+auto test_mpsc_heap()
+{
+    using namespace mix::ds;
+    auto constexpr n             = 1'000'000;
+    auto constexpr producerCount = 3;
+
+    auto const make_mpsc = []()
+    {
+        return std::make_unique<mpsc_heap<test_t>>();
+    };
+
+    auto const make_locked = []()
+    {
+        return std::make_unique<locked_heap<test_t>>();
+    };
+
+    auto const make_mpsc_timers = []()
+    {
+        return std::make_unique<mpsc_heap<timer_test_data>>();
+    };
+
+    auto const make_locked_timers = []()
+    {
+        return std::make_unique<locked_heap<timer_test_data>>();
+    };
+
+    queue_test_mpsc(make_mpsc, producerCount, n);
+    queue_test_mpsc(make_locked, producerCount, n);
+    queue_test_mpsc_latency(make_mpsc_timers, producerCount, n);
+    queue_test_mpsc_latency(make_locked_timers, producerCount, n);
+}
+
+auto test_trace()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 7412589;
+    auto constexpr n    = 1'000'000;
+    queue_test_trace <pairing_heap, merge_modes::two_pass>   (n, seed);
+    queue_test_trace <pairing_heap, merge_modes::fifo_queue> (n, seed);
+    queue_test_trace <fibonacci_heap>        (n, seed);
+    queue_test_trace <brodal_queue>          (n, seed);
+    queue_test_trace <hollow_heap>           (n, seed);
+    queue_test_trace <rank_pairing_heap>     (n, seed);
+    queue_test_trace <strict_fibonacci_heap> (n, seed);
+    queue_test_trace <d_ary_heap>            (n, seed);
+    queue_test_trace <boost_pairing_heap>    (n, seed);
+}
+
+auto test_counting_allocator()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 3698521;
+    auto constexpr n    = 1'000'000;
+    queue_test_allocator <pairing_heap, merge_modes::two_pass>   (n, seed);
+    queue_test_allocator <pairing_heap, merge_modes::fifo_queue> (n, seed);
+    queue_test_allocator <fibonacci_heap> (n, seed);
+    queue_test_allocator <brodal_queue>   (n, seed);
+    queue_test_allocator <hollow_heap>    (n, seed);
+    queue_test_allocator <rank_pairing_heap, rank_rules::type_1> (n, seed);
+    queue_test_allocator <strict_fibonacci_heap> (n, seed);
+}
+
+auto test_radix_heap()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 6546123;
+    auto constexpr n    = 1'000'000;
+    queue_test_monotone <radix_heap>   (n, seed);
+    queue_test_monotone <pairing_heap> (n, seed);
+    queue_test_delete   <radix_heap>   (n, seed);
+    queue_test_decrease <radix_heap>   (n, seed);
+    queue_test_copy     <radix_heap>   (n, seed);
+    queue_test_meld     <radix_heap>   (n, seed);
+    queue_test_other    <radix_heap>   (n, seed);
+}
+
 auto test_dijkstra()
 {
     using namespace mix::ds;
     auto constexpr seed = 1321545132;
     auto constexpr n    = 3000;
-    test_dijkstra_to_point <pairing_heap>       (n, seed);
-    test_dijkstra_to_point <boost_pairing_heap> (n, seed);
-    // test_dijkstra_to_point <brodal_queue>       (n, seed);
-    // test_dijkstra_to_point <fibonacci_heap>     (n, seed);
+    auto graph = make_grid_graph(300, 300, 1'000, seed);
+    // auto graph = load_road_graph(RoadGraphPath);
+    test_dijkstra_to_point <pairing_heap>       (graph, n, seed);
+    test_dijkstra_to_point <boost_pairing_heap> (graph, n, seed);
+    test_dijkstra_to_point_intrusive <merge_modes::two_pass> (graph, n, seed);
+    test_dijkstra_to_point <cached_pairing_heap> (graph, n, seed);
+    test_dijkstra_to_point <hollow_heap> (graph, n, seed);
+    test_dijkstra_to_point <rank_pairing_heap, rank_rules::type_1> (graph, n, seed);
+    test_dijkstra_to_point <rank_pairing_heap, rank_rules::type_2> (graph, n, seed);
+    // test_dijkstra_to_point <brodal_queue>       (graph, n, seed);
+    test_dijkstra_to_point <strict_fibonacci_heap> (graph, n, seed);
+    test_dijkstra_to_point <d_ary_heap, heap_arity<4>> (graph, n, seed);
+    test_dijkstra_to_point <d_ary_heap, heap_arity<8>> (graph, n, seed);
+    // test_dijkstra_to_point <fibonacci_heap>     (graph, n, seed);
+}
+
+auto test_routing()
+{
+    using namespace mix::ds;
+    auto constexpr seed = 8741354;
+    auto constexpr n    = 1'000;
+    auto constexpr side = 300;
+    auto graph  = make_grid_graph(side, side, 1'000, seed);
+    auto coords = grid_coordinates(side, side);
+    // auto graph  = load_road_graph(RoadGraphPath);
+    // auto coords = load_road_coordinates(RoadCoordsPath);
+    test_graph_generator(seed);
+    test_alt_dead_end   <pairing_heap> ();
+    test_alt_to_point   <pairing_heap> (graph, 16, n, seed);
+    test_ch_to_point    <pairing_heap> (graph, n, seed);
+    test_delta_stepping <pairing_heap> (graph, 1'000, mix::utils::default_thread_count(), 10, seed);
+    test_distance_table <pairing_heap> (graph, 20, 100, seed);
+    test_graph_order    <pairing_heap> (graph, coords, n, seed);
+    test_path_extraction<pairing_heap> (graph, 30, seed);
 }
 
 auto example_priority_queue()
@@ -95,33 +354,50 @@ auto example_priority_queue()
     }
 }
 
-auto compare_queues_ops()
+auto compare_queues_dijkstra()
 {
     using namespace mix::ds;
-    auto constexpr seed = 78945651; 
-    auto constexpr n    = 5'000'000;
+    auto constexpr seed = 54654564321; 
+    auto constexpr n    = 100;
 
-    // queue_test_random_all <pairing_heap> (n, seed);
-    // queue_test_random_all <boost_pairing_heap> (n, seed);
+    // Roughly 1K, 100K and 10M vertices. 100M vertices (side 10'000)
+    // need about 15 GB for the grid graph alone so that point is off by default.
+    for (auto const side : {32ul, 316ul, 3'162ul /*, 10'000ul */})
+    {
+        auto graph = make_grid_graph(side, side, 1'000, seed);
+        // auto graph = make_geometric_graph(make_random_points(side * side, seed), 6.0);
+        // auto graph = make_power_law_graph(side * side, 3, 1'000, seed);
+        // auto graph = load_road_graph(RoadGraphPath);
+        std::cout << graph.vertices.size() << " vertices" << '\n';
 
-    queue_test_random_all <fibonacci_heap> (n, seed);
-    // queue_test_random_all <boost_fibonacci_heap> (n, seed);
+        // test_dijkstra_to_point <pairing_heap>       (graph, n, seed);
+        // test_dijkstra_to_point <boost_pairing_heap> (graph, n, seed);
+        // test_dijkstra_to_point_intrusive <merge_modes::two_pass> (graph, n, seed);
+        // test_dijkstra_to_point <cached_pairing_heap>              (graph, n, seed);
 
-    // queue_test_delete <fibonacci_heap> (n, seed);
-    // queue_test_delete <boost_fibonacci_heap> (n, seed);
-}
+        // test_dijkstra_to_point <fibonacci_heap>       (graph, n, seed);
+        test_dijkstra_to_point <boost_fibonacci_heap> (graph, n, seed);
+        // test_dijkstra_to_point <cached_fibonacci_heap> (graph, n, seed);
+        // test_dijkstra_to_point <strict_fibonacci_heap> (graph, n, seed);
 
-auto compare_queues_dijkstra()
-{
-    using namespace mix::ds;
-    auto constexpr seed = 54654564321; 
-    auto constexpr n    = 3'000;
+        // test_dijkstra_to_point <rank_pairing_heap, rank_rules::type_1> (graph, n, seed);
+        // test_dijkstra_to_point <rank_pairing_heap, rank_rules::type_2> (graph, n, seed);
+
+        // test_dijkstra_to_point <boost_d_ary_heap> (graph, n, seed);
+        // test_dijkstra_to_point <d_ary_heap, heap_arity<4>> (graph, n, seed);
+        // test_dijkstra_to_point <d_ary_heap, heap_arity<8>> (graph, n, seed);
 
-    // test_dijkstra_to_point <pairing_heap>       (n, seed);
-    // test_dijkstra_to_point <boost_pairing_heap> (n, seed);
+        // test_dijkstra_to_point <hollow_heap> (graph, n, seed);
 
-    // test_dijkstra_to_point <fibonacci_heap>       (n, seed);
-    test_dijkstra_to_point <boost_fibonacci_heap> (n, seed);
+        // test_dijkstra_to_point <radix_heap> (graph, n, seed);
+
+        // Without decrease_key, outdated entries are skipped.
+        // test_dijkstra_to_point_lazy <std_priority_queue>     (graph, n, seed);
+        // test_dijkstra_to_point_lazy <boost_plain_d_ary_heap> (graph, n, seed);
+        // test_dijkstra_to_point_lazy <pairing_heap>           (graph, n, seed);
+        // test_dijkstra_to_point_lazy <d_ary_heap>             (graph, n, seed);
+        // test_dijkstra_to_point_lazy <radix_heap>             (graph, n, seed);
+    }
 }
 
 int main()
@@ -131,11 +407,24 @@ int main()
 
     // test_fibonacci_heap();
     test_pairing_heap();
+    // test_radix_heap();
+    // test_intrusive_pairing_heap();
+    // test_cached_key_heap();
+    // test_hollow_heap();
+    // test_rank_pairing_heap();
+    // test_strict_fibonacci_heap();
+    // test_d_ary_heap();
+    // test_sequence_heap();
+    // test_external_heap();
+    // test_multi_queue();
+    // test_mpsc_heap();
+    // test_trace();
+    // test_counting_allocator();
     // test_brodal_queue();
     // test_baseline_map();
     // test_dijkstra();
+    // test_routing();
 
-    // compare_queues_ops();
     // compare_queues_dijkstra();
 
     auto const elapsed = watch.elapsed_time().count();
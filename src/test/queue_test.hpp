@@ -4,6 +4,13 @@
 #include "test_commons.hpp"
 #include "../utils/random_wrap.hpp"
 #include "../compare/dijkstra.hpp"
+#include "../compare/intrusive_dijkstra.hpp"
+#include "../lib/external_heap.hpp"
+#include "../lib/pairing_heap.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../utils/parallel.hpp"
+#include "../utils/counting_allocator.hpp"
+#include "../bench/trace.hpp"
 
 #include <vector>
 #include <iterator>
@@ -11,6 +18,15 @@
 #include <algorithm>
 #include <string_view>
 #include <limits>
+#include <set>
+#include <queue>
+#include <cstdint>
+#include <filesystem>
+#include <atomic>
+#include <chrono>
+#include <tuple>
+#include <sstream>
+#include <optional>
 
 namespace mix::ds
 {
@@ -46,8 +62,13 @@ namespace mix::ds
     auto erase_handle(Handles& handles, std::size_t const index)
     {
         std::swap(handles.at(index), handles.back());
-        (*handles.at(index)).index = index;
         handles.pop_back();
+
+        // Erased element is already gone if it was the last one.
+        if (index < handles.size())
+        {
+            (*handles.at(index)).index = index;
+        }
     }
 
     template<class Queue>
@@ -326,13 +347,734 @@ namespace mix::ds
         ASSERT(queue_test_delete(queueCopy), "Test all [internal test delete]");
     }
 
+    struct test_data_key_compare
+    {
+        auto operator() (test_data const& lhs, test_data const& rhs) const
+        {
+            return lhs < rhs;
+        }
+
+        static auto key (test_data const& d)
+        {
+            return d.data;
+        }
+    };
+
+    /**
+        Orders both test_t and test_data by their keys.
+        For queues that require Compare::key.
+     */
+    struct test_key_compare
+    {
+        template<class T>
+        auto operator() (T const& lhs, T const& rhs) const
+        {
+            return key(lhs) < key(rhs);
+        }
+
+        static auto key (test_t const value)
+        {
+            return value;
+        }
+
+        static auto key (test_data const& d)
+        {
+            return d.data;
+        }
+    };
+
+    /**
+        Random operations where no key is ever smaller than the last minimum,
+        just like in Dijkstra's algorithm. Suitable for monotone queues.
+     */
+    template<template<class, class...> class TestedQueue, class... Options>
+    auto queue_test_monotone(std::size_t const n, unsigned long const seed)
+    {
+        auto constexpr OpInsert      = 0u;
+        auto constexpr OpDeleteMin   = 1u;
+        auto constexpr OpDecreaseKey = 2u;
+        auto constexpr OpErase       = 3u;
+
+        using queue_t = TestedQueue<test_data, test_data_key_compare, Options...>;
+        auto queue    = queue_t();
+        auto rngSeed  = make_seeder(seed);
+        auto rngStep  = make_rng<test_t>(0u, 10'000u, rngSeed.next_int());
+        auto rngNew   = make_rng<test_t>(rngSeed.next_int());
+        auto rngOp    = make_rng<decltype(OpInsert)>(0u, 3, rngSeed.next_int());
+        auto rngIndex = make_rng<std::size_t>(rngSeed.next_int());
+        auto handles  = std::vector<typename queue_t::handle_t>();
+        auto lastMin  = test_t {0};
+        auto ordered  = true;
+
+        auto const insert = [&]()
+        {
+            handles.emplace_back(queue.insert(test_data {lastMin + rngStep.next_int(), handles.size()}));
+        };
+
+        auto const delete_min = [&]()
+        {
+            auto const min = queue.find_min();
+            ordered = ordered && min.data >= lastMin;
+            lastMin = min.data;
+            erase_handle(handles, min.index);
+            queue.delete_min();
+        };
+
+        auto const decrease_key = [&]()
+        {
+            auto handle    = handles[rngIndex.next_int() % handles.size()];
+            (*handle).data = lastMin + rngNew.next_int() % ((*handle).data - lastMin + 1);
+            queue.decrease_key(handle);
+        };
+
+        auto const erase = [&]()
+        {
+            auto const index  = rngIndex.next_int() % handles.size();
+            auto const handle = handles.at(index);
+            erase_handle(handles, index);
+            queue.erase(handle);
+        };
+
+        for (auto i = 0u; i < n; ++i)
+        {
+            insert();
+        }
+
+        for (auto i = 0u; i < n; ++i)
+        {
+            if (queue.empty())
+            {
+                insert();
+                continue;
+            }
+
+            switch (rngOp.next_int())
+            {
+                case OpInsert:      insert();       break;
+                case OpDeleteMin:   delete_min();   break;
+                case OpDecreaseKey: decrease_key(); break;
+                case OpErase:       erase();        break;
+                default: throw "This should not have happened.";
+            }
+        }
+
+        ASSERT(queue_test_size(queue), "Test monotone [internal test size]");
+
+        while (!queue.empty())
+        {
+            delete_min();
+        }
+
+        ASSERT(ordered, "Test monotone");
+    }
+
+    /**
+        Random inserts and delete_mins compared with std::priority_queue.
+        Suitable for queues without handles.
+     */
+    template<template<class, class...> class TestedQueue, class... Options>
+    auto queue_test_plain(std::size_t const n, unsigned long const seed)
+    {
+        using queue_t = TestedQueue<test_t, std::less<test_t>, Options...>;
+        auto queue    = queue_t();
+        auto expected = std::priority_queue<test_t, std::vector<test_t>, std::greater<test_t>>();
+        auto rngSeed  = make_seeder(seed);
+        auto rngData  = make_rng<test_t>(0u, n, rngSeed.next_int());
+        auto rngOp    = make_rng<unsigned>(0u, 2u, rngSeed.next_int());
+        auto same     = true;
+
+        auto const delete_min = [&]()
+        {
+            same = same && queue.find_min() == expected.top();
+            queue.delete_min();
+            expected.pop();
+        };
+
+        // Slightly more inserts so that the queue grows.
+        for (auto i = 0u; i < 2 * n; ++i)
+        {
+            if (expected.empty() || rngOp.next_int() > 0)
+            {
+                auto const data = rngData.next_int();
+                queue.insert(data);
+                expected.push(data);
+            }
+            else
+            {
+                delete_min();
+            }
+        }
+
+        same = same && queue.size() == expected.size();
+        while (!expected.empty())
+        {
+            delete_min();
+        }
+
+        ASSERT(same && queue.empty(), "Test plain");
+    }
+
+    /**
+        Inserts n random elements and then deletes all of them.
+     */
+    template<template<class, class...> class TestedQueue, class... Options>
+    auto queue_test_throughput(std::size_t const n, unsigned long const seed)
+    {
+        using queue_t = TestedQueue<test_t, std::less<test_t>, Options...>;
+        auto queue    = queue_t();
+        auto rng      = make_rng<test_t>(seed);
+        auto sum      = 0ul;
+
+        auto const insertTime = utils::run_time([&]()
+        {
+            for (auto i = 0ul; i < n; ++i)
+            {
+                queue.insert(rng.next_int());
+            }
+        });
+
+        auto const deleteTime = utils::run_time([&]()
+        {
+            while (!queue.empty())
+            {
+                sum += queue.find_min();
+                queue.delete_min();
+            }
+        });
+
+        std::cout << n << " elements: insert " << insertTime << " ms"
+                  << ", delete_min " << deleteTime << " ms"
+                  << " (" << sum << ")" << '\n';
+    }
+
+    /**
+        Builds queue from random data using from_range_parallel and meld_all
+        and checks that delete_min returns the data in sorted order.
+     */
+    template<template<class, class...> class TestedQueue, class... Options>
+    auto queue_test_bulk_build(std::size_t const n, std::size_t const threadCount, unsigned long const seed)
+    {
+        using queue_t   = TestedQueue<test_t, std::less<test_t>, Options...>;
+        auto rng        = make_rng<test_t>(seed);
+        auto data       = std::vector<test_t>(n);
+        auto partitions = std::vector<queue_t>(64);
+
+        std::generate(std::begin(data), std::end(data), [&rng](){ return rng.next_int(); });
+        for (auto i = 0ul; i < n; ++i)
+        {
+            partitions[i % partitions.size()].insert(data[i]);
+        }
+
+        auto built  = queue_t::from_range_parallel(std::begin(data), std::end(data), threadCount);
+        auto melded = queue_t::meld_all(partitions);
+
+        std::sort(std::begin(data), std::end(data));
+
+        auto const drains_sorted = [&data](queue_t& queue)
+        {
+            if (queue.size() != data.size())
+            {
+                return false;
+            }
+
+            for (auto const expected : data)
+            {
+                if (queue.find_min() != expected)
+                {
+                    return false;
+                }
+                queue.delete_min();
+            }
+
+            return queue.empty();
+        };
+
+        auto const partitionsEmpty = std::all_of(std::begin(partitions), std::end(partitions), [](auto const& q)
+        {
+            return q.empty();
+        });
+
+        ASSERT(drains_sorted(built), "Test bulk build");
+        ASSERT(partitionsEmpty && drains_sorted(melded), "Test meld_all");
+    }
+
+    /**
+        Prints time of building the queue from n random elements using repeated
+        insert, from_range and from_range_parallel with 1, 2, 4, ... maxThreads threads.
+     */
+    template<template<class, class...> class TestedQueue, class... Options>
+    auto queue_test_bulk_build_time(std::size_t const n, std::size_t const maxThreads, unsigned long const seed)
+    {
+        using queue_t = TestedQueue<test_t, std::less<test_t>, Options...>;
+        auto rng      = make_rng<test_t>(seed);
+        auto data     = std::vector<test_t>(n);
+
+        std::generate(std::begin(data), std::end(data), [&rng](){ return rng.next_int(); });
+
+        // Queues are destroyed outside of the measured part.
+        auto queue = queue_t();
+        auto const insertTime = utils::run_time([&]()
+        {
+            for (auto const key : data)
+            {
+                queue.insert(key);
+            }
+        });
+        std::cout << n << " elements: insert " << insertTime << " ms" << '\n';
+        queue.clear();
+
+        auto const rangeTime = utils::run_time([&]()
+        {
+            queue = queue_t::from_range(std::begin(data), std::end(data));
+        });
+        std::cout << n << " elements: from_range " << rangeTime << " ms" << '\n';
+        queue.clear();
+
+        for (auto threadCount = 1ul; threadCount <= maxThreads; threadCount *= 2)
+        {
+            auto const parallelTime = utils::run_time([&]()
+            {
+                queue = queue_t::from_range_parallel(std::begin(data), std::end(data), threadCount);
+            });
+            std::cout << n << " elements: from_range_parallel " << threadCount
+                      << " threads " << parallelTime << " ms" << '\n';
+            queue.clear();
+        }
+    }
+
+    /**
+        16 byte element of the external heap tests.
+     */
+    struct external_test_data
+    {
+        std::uint64_t key;
+        std::uint64_t payload;
+    };
+
+    inline auto operator< (external_test_data const& lhs, external_test_data const& rhs)
+    {
+        return lhs.key < rhs.key;
+    }
+
+    /**
+        Random inserts and delete_mins on external_heap with a small memory
+        budget so that it spills often, compared with std::priority_queue.
+     */
+    inline auto queue_test_external(std::size_t const n, std::size_t const budget, unsigned long const seed)
+    {
+        auto queue    = external_heap<external_test_data>(std::filesystem::temp_directory_path(), budget);
+        auto expected = std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<std::uint64_t>>();
+        auto rngSeed  = make_seeder(seed);
+        auto rngData  = make_rng<std::uint64_t>(0u, n, rngSeed.next_int());
+        auto rngOp    = make_rng<unsigned>(0u, 2u, rngSeed.next_int());
+        auto same     = true;
+        auto maxRuns  = std::size_t {0};
+
+        auto const delete_min = [&]()
+        {
+            same = same && queue.find_min().key == expected.top();
+            queue.delete_min();
+            expected.pop();
+        };
+
+        for (auto i = 0u; i < 2 * n; ++i)
+        {
+            if (expected.empty() || rngOp.next_int() > 0)
+            {
+                auto const key = rngData.next_int();
+                queue.insert(external_test_data {key, i});
+                expected.push(key);
+                maxRuns = std::max(maxRuns, queue.run_count());
+            }
+            else
+            {
+                delete_min();
+            }
+        }
+
+        same = same && queue.size() == expected.size();
+        while (!expected.empty())
+        {
+            delete_min();
+        }
+
+        ASSERT(maxRuns > 1, "Test external [internal test spill]");
+        ASSERT(same && queue.empty(), "Test external");
+    }
+
+    /**
+        Inserts n random elements into external_heap and deletes all of them.
+        Checks the order and the sum of payloads, memory used by the test
+        itself does not depend on n.
+     */
+    inline auto queue_test_external_bulk(std::size_t const n, std::size_t const budget, unsigned long const seed)
+    {
+        auto queue      = external_heap<external_test_data>(std::filesystem::temp_directory_path(), budget);
+        auto rng        = make_rng<std::uint64_t>(seed);
+        auto insertSum  = std::uint64_t {0};
+        auto deleteSum  = std::uint64_t {0};
+        auto ordered    = true;
+
+        auto const insertTime = utils::run_time([&]()
+        {
+            for (auto i = std::uint64_t {0}; i < n; ++i)
+            {
+                auto const payload = rng.next_int();
+                insertSum += payload;
+                queue.insert(external_test_data {rng.next_int(), payload});
+            }
+        });
+
+        auto const deleteTime = utils::run_time([&]()
+        {
+            auto prev = std::uint64_t {0};
+            while (!queue.empty())
+            {
+                auto const min = queue.find_min();
+                ordered    = ordered && prev <= min.key;
+                prev       = min.key;
+                deleteSum += min.payload;
+                queue.delete_min();
+            }
+        });
+
+        std::cout << n << " elements: insert " << insertTime << " ms"
+                  << ", delete_min " << deleteTime << " ms" << '\n';
+        ASSERT(ordered && insertSum == deleteSum, "Test external bulk");
+    }
+
+    /**
+        Threads insert disjoint sets of keys and then delete until the queue
+        is empty. Every key must be deleted exactly once.
+        make_queue(threadCount) returns a pointer to a concurrent queue.
+     */
+    template<class MakeQueue>
+    auto queue_test_concurrent(MakeQueue make_queue, std::size_t const threadCount, std::size_t const n)
+    {
+        auto queue   = make_queue(threadCount);
+        auto counts  = std::vector<std::atomic<unsigned>>(n);
+        auto barrier = utils::spin_barrier(threadCount);
+
+        utils::run_on_threads(threadCount, [&](auto const t)
+        {
+            for (auto key = t; key < n; key += threadCount)
+            {
+                queue->insert(static_cast<test_t>(key));
+            }
+
+            barrier.wait();
+
+            auto key = test_t {0};
+            while (queue->try_delete_min(key))
+            {
+                counts[key].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        auto const once = std::all_of(std::begin(counts), std::end(counts), [](auto const& c)
+        {
+            return 1 == c.load();
+        });
+
+        ASSERT(once && queue->empty(), "Test concurrent");
+    }
+
+    /**
+        Every thread alternates insert and delete_min on a queue prefilled
+        with n elements. Prints throughput for 1, 2, 4, ... maxThreads threads.
+        make_queue(threadCount) returns a pointer to a concurrent queue.
+     */
+    template<class MakeQueue>
+    auto queue_test_scaling( MakeQueue make_queue
+                           , std::size_t const maxThreads
+                           , std::size_t const n
+                           , std::size_t const opsPerThread
+                           , unsigned long const seed )
+    {
+        for (auto threadCount = 1ul; threadCount <= maxThreads; threadCount *= 2)
+        {
+            auto queue   = make_queue(threadCount);
+            auto rng     = make_rng<test_t>(seed);
+            auto barrier = utils::spin_barrier(threadCount);
+            auto time    = 0.0;
+
+            for (auto i = 0ul; i < n; ++i)
+            {
+                queue->insert(rng.next_int());
+            }
+
+            utils::run_on_threads(threadCount, [&](auto const t)
+            {
+                auto rngLocal = make_rng<test_t>(seed + t);
+                auto key      = test_t {0};
+
+                barrier.wait();
+                auto const watch = utils::stopwatch();
+                for (auto i = 0ul; i < opsPerThread; ++i)
+                {
+                    if (i & 1)
+                    {
+                        queue->try_delete_min(key);
+                    }
+                    else
+                    {
+                        queue->insert(rngLocal.next_int());
+                    }
+                }
+                barrier.wait();
+
+                if (0 == t)
+                {
+                    time = static_cast<double>(watch.elapsed_time().count());
+                }
+            });
+
+            auto const mops = static_cast<double>(threadCount * opsPerThread) / (1'000.0 * std::max(1.0, time));
+            std::cout << threadCount << " threads: " << mops << " Mops/s" << '\n';
+        }
+    }
+
+    /**
+        Thread 0 is the single consumer, threads 1 ... producerCount insert
+        disjoint sets of keys while it deletes. Every key must be deleted
+        exactly once. make_queue() returns a pointer to the queue.
+     */
+    template<class MakeQueue>
+    auto queue_test_mpsc(MakeQueue make_queue, std::size_t const producerCount, std::size_t const n)
+    {
+        auto queue  = make_queue();
+        auto counts = std::vector<unsigned>(producerCount * n, 0);
+
+        utils::run_on_threads(producerCount + 1, [&](auto const t)
+        {
+            if (0 == t)
+            {
+                auto key    = test_t {0};
+                auto popped = 0ul;
+                while (popped < counts.size())
+                {
+                    if (queue->try_delete_min(key))
+                    {
+                        ++counts[key];
+                        ++popped;
+                    }
+                }
+            }
+            else
+            {
+                for (auto i = 0ul; i < n; ++i)
+                {
+                    queue->insert(static_cast<test_t>(i * producerCount + t - 1));
+                }
+            }
+        });
+
+        auto const once = std::all_of(std::begin(counts), std::end(counts), [](auto const c)
+        {
+            return 1 == c;
+        });
+
+        ASSERT(once && queue->empty(), "Test mpsc");
+    }
+
+    /**
+        Element of the latency benchmark, remembers when it was inserted.
+     */
+    struct timer_test_data
+    {
+        std::uint64_t                         deadline;
+        std::chrono::steady_clock::time_point pushed;
+    };
+
+    inline auto operator< (timer_test_data const& lhs, timer_test_data const& rhs)
+    {
+        return lhs.deadline < rhs.deadline;
+    }
+
+    /**
+        Producers insert timers with increasing deadlines and the single
+        consumer deletes them. Prints percentiles of the time producers spend
+        in insert and of the time from insert until the consumer gets the timer.
+        make_queue() returns a pointer to a queue of timer_test_data.
+     */
+    template<class MakeQueue>
+    auto queue_test_mpsc_latency(MakeQueue make_queue, std::size_t const producerCount, std::size_t const n)
+    {
+        using clock_t = std::chrono::steady_clock;
+        using nanos_t = std::chrono::nanoseconds;
+
+        auto queue     = make_queue();
+        auto latencies = std::vector<std::vector<std::int64_t>>(producerCount + 1);
+
+        utils::run_on_threads(producerCount + 1, [&](auto const t)
+        {
+            auto& local = latencies[t];
+            local.reserve(0 == t ? producerCount * n : n);
+
+            if (0 == t)
+            {
+                auto timer = timer_test_data {};
+                while (local.size() < producerCount * n)
+                {
+                    if (queue->try_delete_min(timer))
+                    {
+                        local.push_back(std::chrono::duration_cast<nanos_t>(clock_t::now() - timer.pushed).count());
+                    }
+                }
+            }
+            else
+            {
+                for (auto i = 0ul; i < n; ++i)
+                {
+                    auto const start = clock_t::now();
+                    queue->insert(timer_test_data {i, start});
+                    local.push_back(std::chrono::duration_cast<nanos_t>(clock_t::now() - start).count());
+                }
+            }
+        });
+
+        auto const percentiles = [](std::vector<std::int64_t>& ns)
+        {
+            std::sort(std::begin(ns), std::end(ns));
+            return std::make_tuple(ns[ns.size() / 2], ns[ns.size() * 99 / 100], ns.back());
+        };
+
+        auto inserts = std::vector<std::int64_t>();
+        for (auto t = 1ul; t <= producerCount; ++t)
+        {
+            inserts.insert(std::end(inserts), std::begin(latencies[t]), std::end(latencies[t]));
+        }
+
+        auto const [insertMedian, insertP99, insertMax]    = percentiles(inserts);
+        auto const [deliverMedian, deliverP99, deliverMax] = percentiles(latencies[0]);
+
+        std::cout << producerCount << " producers: insert p50 " << insertMedian << " ns"
+                  << ", p99 " << insertP99 << " ns, max " << insertMax << " ns"
+                  << "; delivery p50 " << deliverMedian << " ns"
+                  << ", p99 " << deliverP99 << " ns, max " << deliverMax << " ns" << '\n';
+    }
+
+    struct intrusive_test_data : public pairing_hook<>
+    {
+        test_data value;
+    };
+
+    struct intrusive_test_data_compare
+    {
+        auto operator() (intrusive_test_data const& lhs, intrusive_test_data const& rhs) const
+        {
+            return lhs.value < rhs.value;
+        }
+    };
+
+    /**
+        Random operations on intrusive_pairing_heap compared with std::multiset.
+        Every insert links a new element of a vector that never reallocates.
+     */
+    template<class MergeMode>
+    auto queue_test_intrusive(std::size_t const n, unsigned long const seed)
+    {
+        auto constexpr OpInsert      = 0u;
+        auto constexpr OpDeleteMin   = 1u;
+        auto constexpr OpDecreaseKey = 2u;
+        auto constexpr OpErase       = 3u;
+
+        using queue_t = intrusive_pairing_heap<intrusive_test_data, intrusive_test_data_compare, MergeMode>;
+        auto queue    = queue_t();
+        auto expected = std::multiset<test_data>();
+        auto rngSeed  = make_seeder(seed);
+        auto rngData  = make_rng<test_t>(3u, n, rngSeed.next_int());
+        auto rngOp    = make_rng<decltype(OpInsert)>(0u, 3, rngSeed.next_int());
+        auto rngIndex = make_rng<std::size_t>(rngSeed.next_int());
+        auto elements = std::vector<intrusive_test_data>(2 * n);
+        auto linked   = std::vector<intrusive_test_data*>();
+        auto unused   = std::begin(elements);
+        auto allMatch = true;
+
+        // Index of an element in linked is kept in its value.
+        auto const unlink = [&](std::size_t const index)
+        {
+            expected.erase(expected.find(linked[index]->value));
+            linked[index] = linked.back();
+            linked[index]->value.index = index;
+            linked.pop_back();
+        };
+
+        auto const insert = [&](queue_t& q)
+        {
+            auto& element = *unused++;
+            element.value = test_data {rngData.next_int(), linked.size()};
+            linked.emplace_back(&element);
+            expected.insert(element.value);
+            q.insert(element);
+        };
+
+        auto const delete_min = [&]()
+        {
+            auto const min = queue.find_min().value;
+            allMatch = allMatch && min.data == expected.begin()->data;
+            queue.delete_min();
+            unlink(min.index);
+        };
+
+        auto const decrease_key = [&]()
+        {
+            auto& element = *linked[rngIndex.next_int() % linked.size()];
+            expected.erase(expected.find(element.value));
+            element.value.data = rngData.next_int() % (element.value.data + 1);
+            expected.insert(element.value);
+            queue.decrease_key(element);
+        };
+
+        auto const erase = [&]()
+        {
+            auto const index = rngIndex.next_int() % linked.size();
+            queue.erase(*linked[index]);
+            unlink(index);
+        };
+
+        // Half of the initial elements come from a melded heap.
+        auto other = queue_t();
+        for (auto i = 0u; i < n / 2; ++i)
+        {
+            insert(queue);
+            insert(other);
+        }
+        queue.meld(std::move(other));
+        allMatch = allMatch && other.empty() && queue.size() == expected.size();
+
+        for (auto i = 0u; i < n; ++i)
+        {
+            if (queue.empty())
+            {
+                insert(queue);
+                continue;
+            }
+
+            switch (rngOp.next_int())
+            {
+                case OpInsert:      insert(queue);  break;
+                case OpDeleteMin:   delete_min();   break;
+                case OpDecreaseKey: decrease_key(); break;
+                case OpErase:       erase();        break;
+                default: throw "This should not have happened.";
+            }
+        }
+
+        allMatch = allMatch && queue.size() == expected.size();
+        while (!queue.empty())
+        {
+            delete_min();
+        }
+
+        ASSERT(allMatch && expected.empty(), "Test intrusive");
+    }
+
     template<template<class, class, class...> class Queue>
-    auto test_dijkstra_to_all(std::size_t const n, unsigned long const seed)
+    auto test_dijkstra_to_all(graph_t& vs, std::size_t const n, unsigned long const seed)
     {
         using namespace mix::ds;
-        auto vs = load_road_graph("/mnt/c/Users/mrena/Downloads/USA-road-d.NY.gr");
-
-        auto rngSrc = make_rng<std::size_t>(0ul, vs.vertices.size(), seed);
+        auto rngSrc = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, seed);
 
         auto totalDist = 0.0;
         for (auto i = 0ul; i < n; ++i)
@@ -350,34 +1092,237 @@ namespace mix::ds
         std::cout << std::fixed << totalDist << '\n';
     }
 
-    template<template<class, class, class...> class Queue>
-    auto test_dijkstra_to_point(std::size_t const n, unsigned long const seed)
+    template<class FindPath>
+    auto test_dijkstra_to_point_impl(graph_t& vs, std::size_t const n, unsigned long const seed, FindPath find_path)
     {
-        using namespace mix::ds;
-        auto vs = load_road_graph("/mnt/c/Users/mrena/Downloads/USA-road-d.NY.gr");
-
         auto rngSeed = make_seeder(seed);
-        auto rngSrc  = make_rng<std::size_t>(0ul, vs.vertices.size(), rngSeed.next_int());
-        auto rngDst  = make_rng<std::size_t>(0ul, vs.vertices.size(), rngSeed.next_int());
+        auto rngSrc  = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, rngSeed.next_int());
+        auto rngDst  = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, rngSeed.next_int());
 
         auto totalDist = 0.0;
+        auto const time = utils::run_time([&]()
+        {
+            for (auto i = 0ul; i < n; ++i)
+            {
+                auto const path = find_path(vs, rngSrc.next_int(), rngDst.next_int());
+                if (dijkstra_max_dist() != path.cost)
+                {
+                    totalDist += path.cost;
+                }
+            }
+        });
+
+        std::cout << std::fixed << totalDist << " in " << time << " ms" << '\n';
+    }
+
+    template<template<class, class, class...> class Queue, class... Options>
+    auto test_dijkstra_to_point(graph_t& vs, std::size_t const n, unsigned long const seed)
+    {
+        test_dijkstra_to_point_impl(vs, n, seed, [](auto& g, auto const from, auto const to)
+        {
+            return find_point_to_point<Queue, Options...>(g, from, to);
+        });
+    }
+
+    template<class MergeMode>
+    auto test_dijkstra_to_point_intrusive(graph_t& vs, std::size_t const n, unsigned long const seed)
+    {
+        test_dijkstra_to_point_impl(vs, n, seed, [](auto& g, auto const from, auto const to)
+        {
+            return find_point_to_point_intrusive<MergeMode>(g, from, to);
+        });
+    }
+
+    template<template<class, class, class...> class Queue>
+    auto test_dijkstra_to_point_lazy(graph_t& vs, std::size_t const n, unsigned long const seed)
+    {
+        test_dijkstra_to_point_impl(vs, n, seed, [](auto& g, auto const from, auto const to)
+        {
+            return find_point_to_point_lazy<Queue>(g, from, to);
+        });
+    }
+
+    /**
+        Records random operations with many equal keys on a pairing_heap,
+        writes the trace into the binary format, reads it back and replays
+        it on the tested queue. Replay must delete the same elements as the
+        recorded run even if the tested queue breaks ties differently.
+     */
+    template<template<class, class...> class TestedQueue, class... Options>
+    auto queue_test_trace(std::size_t const n, unsigned long const seed)
+    {
+        struct key_of
+        {
+            auto operator() (test_data const& d) const
+            {
+                return d.data;
+            }
+        };
+
+        using queue_t  = TestedQueue<bench::trace_data, std::less<bench::trace_data>, Options...>;
+        auto recorder  = bench::trace_recorder<pairing_heap<test_data>, key_of>();
+        auto rngSeed   = make_seeder(seed);
+        auto rngData   = make_rng<test_t>(1u, 16u, rngSeed.next_int());
+        auto rngOp     = make_rng<unsigned>(0u, 3u, rngSeed.next_int());
+        auto rngIndex  = make_rng<std::size_t>(rngSeed.next_int());
+        auto handles   = std::vector<typename decltype(recorder)::handle_t>();
+        auto expected  = bench::checksum_t {0};
+
+        auto const insert = [&]()
+        {
+            handles.emplace_back(recorder.insert(test_data {rngData.next_int(), handles.size()}));
+        };
+
+        auto const delete_min = [&]()
+        {
+            expected += recorder.find_min().data;
+            erase_handle(handles, recorder.find_min().index);
+            recorder.delete_min();
+        };
+
         for (auto i = 0ul; i < n; ++i)
         {
-            auto const path = find_point_to_point<Queue>(vs, rngSrc.next_int(), rngDst.next_int());
-            if (dijkstra_max_dist() != path.cost)
+            insert();
+        }
+
+        for (auto i = 0ul; i < n && !handles.empty(); ++i)
+        {
+            auto const index = rngIndex.next_int() % handles.size();
+            switch (rngOp.next_int())
             {
-                totalDist += path.cost;
+                case 0:
+                    insert();
+                    break;
+
+                case 1:
+                {
+                    auto handle    = handles[index];
+                    (*handle).data = (*handle).data / 2;
+                    recorder.decrease_key(handle);
+                    break;
+                }
+
+                case 2:
+                {
+                    auto const handle = handles[index];
+                    erase_handle(handles, index);
+                    recorder.erase(handle);
+                    break;
+                }
+
+                default:
+                    delete_min();
+                    break;
             }
         }
 
-        std::cout << std::fixed << totalDist << '\n';
+        while (!recorder.empty())
+        {
+            delete_min();
+        }
+
+        auto const replay = [](bench::trace const& t)
+        {
+            try
+            {
+                return std::optional(bench::replay_trace<queue_t>(t));
+            }
+            catch (std::exception const& e)
+            {
+                std::cout << e.what() << '\n';
+                return std::optional<bench::checksum_t>();
+            }
+        };
+
+        auto stream = std::stringstream();
+        recorder.recorded().write(stream);
+        auto const read = bench::trace::read(stream);
+
+        ASSERT(recorder.recorded().records() == read.records(), "Test trace read");
+        ASSERT(expected == replay(read), "Test trace replay");
+
+        // Recorded queue deleted the middle one of three equal keys.
+        auto ties = bench::trace();
+        ties.insert(5);
+        ties.insert(5);
+        ties.insert(5);
+        ties.delete_min(1);
+        ties.erase(0);
+        ties.delete_min(2);
+        ASSERT(10 == replay(ties), "Test trace ties");
+
+        auto rejected = false;
+        try
+        {
+            ties.erase(1);
+        }
+        catch (std::runtime_error const&)
+        {
+            rejected = true;
+        }
+        ASSERT(rejected, "Test trace removed id");
+    }
+
+    /**
+        Runs random inserts, decrease_keys, erases and delete_mins on a queue
+        with counting_allocator and checks that all memory is returned.
+     */
+    template<template<class, class...> class TestedQueue, class... Options>
+    auto queue_test_allocator(std::size_t const n, unsigned long const seed)
+    {
+        using alloc_t = utils::counting_allocator<test_data>;
+        using queue_t = TestedQueue<test_data, std::less<test_data>, Options..., alloc_t>;
+        auto stats    = utils::allocation_stats();
+        auto rngSeed  = make_seeder(seed);
+        auto rngData  = make_rng<test_t>(1u, n, rngSeed.next_int());
+        auto rngIndex = make_rng<std::size_t>(rngSeed.next_int());
+        auto liveMax  = std::size_t {0};
+        auto cleared  = false;
+
+        {
+            auto queue   = queue_t(alloc_t(stats));
+            auto handles = std::vector<typename queue_t::handle_t>();
+
+            for (auto i = 0ul; i < n; ++i)
+            {
+                handles.emplace_back(queue.insert(test_data {rngData.next_int(), i}));
+            }
+            liveMax = stats.live_bytes();
+
+            for (auto i = 0ul; i < n / 2; ++i)
+            {
+                auto handle     = handles[rngIndex.next_int() % handles.size()];
+                (*handle).data /= 2;
+                queue.decrease_key(handle);
+            }
+
+            for (auto i = 0ul; i < n / 4; ++i)
+            {
+                auto const index = rngIndex.next_int() % handles.size();
+                queue.erase(handles[index]);
+                erase_handle(handles, index);
+            }
+
+            for (auto i = 0ul; i < n / 4; ++i)
+            {
+                erase_handle(handles, queue.find_min().index);
+                queue.delete_min();
+            }
+
+            queue.clear();
+            cleared = queue.empty() && 0 == stats.live_bytes();
+            queue.insert(test_data {rngData.next_int(), n});
+        }
+
+        ASSERT(liveMax >= n * sizeof(test_data), "Test allocator count");
+        ASSERT(cleared, "Test allocator clear");
+        ASSERT(0 == stats.live_bytes() && stats.allocations() == stats.deallocations(), "Test allocator release");
     }
 
     template<template<class, class...> class TestedQueue, class... Options>
     auto queue_test_test(unsigned long const seed)
     {
         using queue_t  = TestedQueue<test_t, std::less<test_t>, Options...>;
-        auto constexpr n = 20u;
 
         auto rngSeed    = make_seeder(seed);
         auto rngLow     = make_rng<test_t>(0, 19'000, rngSeed.next_int());
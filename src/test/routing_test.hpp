@@ -0,0 +1,419 @@
+#ifndef MIX_DS_ROUTING_TEST_HPP
+#define MIX_DS_ROUTING_TEST_HPP
+
+#include "test_commons.hpp"
+#include "../compare/dijkstra.hpp"
+#include "../compare/alt.hpp"
+#include "../compare/contraction_hierarchy.hpp"
+#include "../compare/delta_stepping.hpp"
+#include "../compare/distance_table.hpp"
+#include "../compare/graph_order.hpp"
+#include "../compare/graph_generator.hpp"
+#include "../utils/stopwatch.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+
+namespace mix::ds
+{
+    inline auto const RoadGraphPath  = std::string("/mnt/c/Users/mrena/Downloads/USA-road-d.NY.gr");
+    inline auto const RoadCoordsPath = std::string("/mnt/c/Users/mrena/Downloads/USA-road-d.NY.co");
+
+    template<template<class, class, class...> class Queue>
+    auto test_alt_to_point(graph_t& vs, std::size_t const landmarkCount, std::size_t const n, unsigned long const seed)
+    {
+        auto rngSeed = make_seeder(seed);
+        auto tables  = make_landmark_tables<Queue>(vs, landmarkCount, rngSeed.next_int());
+
+        auto const tablesPath = (std::filesystem::temp_directory_path() / "mix_ds_landmarks.bin").string();
+        save_landmark_tables(tables, tablesPath);
+        auto const loaded = load_landmark_tables(tablesPath);
+        std::filesystem::remove(tablesPath);
+
+        ASSERT( loaded.landmarks == tables.landmarks && loaded.dists == tables.dists
+              , "Test ALT save/load" );
+
+        auto rngSrc = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, rngSeed.next_int());
+        auto rngDst = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, rngSeed.next_int());
+        auto pairs  = std::vector<std::pair<id_t, id_t>>();
+        for (auto i = 0ul; i < n; ++i)
+        {
+            pairs.emplace_back(rngSrc.next_int(), rngDst.next_int());
+        }
+
+        auto plainCosts = std::vector<dist_t>();
+        auto altCosts   = std::vector<dist_t>();
+
+        auto const plainTime = utils::run_time([&]()
+        {
+            for (auto [from, to] : pairs)
+            {
+                plainCosts.emplace_back(find_point_to_point<Queue>(vs, from, to).cost);
+            }
+        });
+
+        auto const altTime = utils::run_time([&]()
+        {
+            for (auto [from, to] : pairs)
+            {
+                altCosts.emplace_back(find_point_to_point_alt<Queue>(vs, loaded, from, to).cost);
+            }
+        });
+
+        std::cout << "Dijkstra " << plainTime << " ms, ALT " << altTime << " ms" << '\n';
+        ASSERT(plainCosts == altCosts, "Test ALT to point");
+    }
+
+    /**
+        Directed graph where the potential of the dead end b drops the term of
+        landmark L while its predecessor c keeps it, so b is improved after it
+        was popped: a->b(10), a->c(1), c->b(1), c->L(1000), a->t(2000), t->L(1).
+     */
+    template<template<class, class, class...> class Queue>
+    auto test_alt_dead_end()
+    {
+        enum : id_t { A, B, C, L, T };
+        auto const make_vertex = [](id_t const id, edges_t forward)
+        {
+            return vertex {id, 0, std::move(forward), std::any(), false};
+        };
+
+        auto g = graph_t { { make_vertex(A, {{10, B}, {1, C}, {2'000, T}})
+                           , make_vertex(B, {})
+                           , make_vertex(C, {{1, B}, {1'000, L}})
+                           , make_vertex(L, {})
+                           , make_vertex(T, {{1, L}}) } };
+
+        auto reversed = reverse_graph(g);
+        auto tables   = landmark_tables {g.vertices.size(), {L}, {}};
+        find_point_to_all<Queue>(g, L);
+        find_point_to_all<Queue>(reversed, L);
+        for (auto v = 0ul; v < g.vertices.size(); ++v)
+        {
+            tables.dists.emplace_back(alt_impl::to_landmark_dist(g.vertices[v].distAprox));
+            tables.dists.emplace_back(alt_impl::to_landmark_dist(reversed.vertices[v].distAprox));
+        }
+
+        auto const path = find_point_to_point_alt<Queue>(g, tables, A, T);
+        ASSERT( path.cost == 2'000 && find_point_to_point<Queue>(g, A, B).cost == 2
+              , "Test ALT dead end" );
+    }
+
+    template<template<class, class, class...> class Queue>
+    auto test_ch_to_point(graph_t& vs, std::size_t const n, unsigned long const seed)
+    {
+        auto rngSrc = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, seed);
+        auto rngDst = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, seed + 1);
+        auto pairs  = std::vector<std::pair<id_t, id_t>>();
+        for (auto i = 0ul; i < n; ++i)
+        {
+            pairs.emplace_back(rngSrc.next_int(), rngDst.next_int());
+        }
+
+        auto ch = contraction_hierarchy {};
+        auto const prepTime = utils::run_time([&]()
+        {
+            ch = make_contraction_hierarchy<Queue>(vs);
+        });
+
+        auto plainCosts = std::vector<dist_t>();
+        auto chCosts    = std::vector<dist_t>();
+
+        auto const plainTime = utils::run_time([&]()
+        {
+            for (auto [from, to] : pairs)
+            {
+                plainCosts.emplace_back(find_point_to_point<Queue>(vs, from, to).cost);
+            }
+        });
+
+        auto query = ch_query<Queue>(ch);
+        auto const chTime = utils::run_time([&]()
+        {
+            for (auto [from, to] : pairs)
+            {
+                chCosts.emplace_back(query.find_point_to_point(from, to).cost);
+            }
+        });
+
+        std::cout << "CH preprocessing " << prepTime << " ms, "
+                  << "Dijkstra " << plainTime << " ms, CH " << chTime << " ms" << '\n';
+        ASSERT(plainCosts == chCosts, "Test CH to point");
+    }
+
+    template<template<class, class, class...> class Queue>
+    auto test_delta_stepping( graph_t& vs, dist_t const delta, std::size_t const threadCount
+                            , std::size_t const n, unsigned long const seed )
+    {
+        auto rngSrc   = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, seed);
+        auto allMatch = true;
+        auto seqTime  = 0.0;
+        auto parTime  = 0.0;
+
+        for (auto i = 0ul; i < n; ++i)
+        {
+            auto const from = rngSrc.next_int();
+            auto dists      = std::vector<dist_t>();
+
+            seqTime += utils::run_time([&]()
+            {
+                find_point_to_all<Queue>(vs, from);
+            });
+
+            parTime += utils::run_time([&]()
+            {
+                dists = find_point_to_all_delta(vs, from, delta, threadCount);
+            });
+
+            for (auto const& v : vs.vertices)
+            {
+                allMatch = allMatch && v.distAprox == dists[v.id];
+            }
+        }
+
+        std::cout << "Dijkstra " << seqTime << " ms, delta-stepping " << parTime << " ms "
+                  << "(delta " << delta << ", " << threadCount << " threads)" << '\n';
+        ASSERT(allMatch, "Test delta-stepping to all");
+    }
+
+    template<template<class, class, class...> class Queue>
+    auto test_distance_table( graph_t& vs, std::size_t const sourceCount, std::size_t const targetCount
+                            , unsigned long const seed )
+    {
+        auto rng     = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, seed);
+        auto sources = std::vector<id_t>(sourceCount);
+        auto targets = std::vector<id_t>(targetCount);
+        std::generate(std::begin(sources), std::end(sources), [&rng]() { return rng.next_int(); });
+        std::generate(std::begin(targets), std::end(targets), [&rng]() { return rng.next_int(); });
+
+        auto plainCosts = std::vector<dist_t>();
+        auto tableCosts = std::vector<dist_t>();
+
+        auto const plainTime = utils::run_time([&]()
+        {
+            for (auto const from : sources)
+            {
+                for (auto const to : targets)
+                {
+                    plainCosts.emplace_back(find_point_to_point<Queue>(vs, from, to).cost);
+                }
+            }
+        });
+
+        auto const tableTime = utils::run_time([&]()
+        {
+            tableCosts = distance_table<Queue>(vs, sources, targets);
+        });
+
+        std::cout << "Dijkstra " << plainTime << " ms, distance table " << tableTime << " ms" << '\n';
+        ASSERT(plainCosts == tableCosts, "Test distance table");
+    }
+
+    template<template<class, class, class...> class Queue>
+    auto test_graph_order( graph_t& vs, std::vector<coordinate> const& coords
+                         , std::size_t const n, unsigned long const seed )
+    {
+        auto rngSrc   = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, seed);
+        auto rngDst   = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, seed + 1);
+        auto pairs    = std::vector<std::pair<id_t, id_t>>();
+        for (auto i = 0ul; i < n; ++i)
+        {
+            pairs.emplace_back(rngSrc.next_int(), rngDst.next_int());
+        }
+
+        auto const run = [&pairs](graph_t& g, vertex_order const* order)
+        {
+            auto costs = std::vector<dist_t>();
+            auto const time = utils::run_time([&]()
+            {
+                for (auto [from, to] : pairs)
+                {
+                    auto const s = order ? order->oldToNew[from] : from;
+                    auto const t = order ? order->oldToNew[to]   : to;
+                    costs.emplace_back(find_point_to_point<Queue>(g, s, t).cost);
+                }
+            });
+            return std::make_pair(time, costs);
+        };
+
+        auto const cmOrder      = cuthill_mckee_order(vs);
+        auto const hilbertOrder = hilbert_order(coords);
+        auto cmGraph            = permute_graph(vs, cmOrder);
+        auto hilbertGraph       = permute_graph(vs, hilbertOrder);
+
+        auto const [plainTime, plainCosts]     = run(vs, nullptr);
+        auto const [cmTime, cmCosts]           = run(cmGraph, &cmOrder);
+        auto const [hilbertTime, hilbertCosts] = run(hilbertGraph, &hilbertOrder);
+
+        std::cout << "Original " << plainTime << " ms, Cuthill-McKee " << cmTime
+                  << " ms, Hilbert " << hilbertTime << " ms" << '\n';
+        ASSERT(plainCosts == cmCosts && plainCosts == hilbertCosts, "Test graph order");
+    }
+
+    inline auto is_valid_route(graph_t const& g, route_t const& route, id_t const from, id_t const to)
+    {
+        if (route.vertices.empty() || route.vertices.front() != from || route.vertices.back() != to)
+        {
+            return false;
+        }
+
+        if (route.edges.size() + 1 != route.vertices.size())
+        {
+            return false;
+        }
+
+        auto cost = dist_t {0};
+        for (auto i = 0ul; i < route.edges.size(); ++i)
+        {
+            auto const& forward = g.vertices[route.vertices[i]].forward;
+            auto const e        = route.edges[i];
+            auto const exists   = std::any_of(std::begin(forward), std::end(forward), [e](auto const& f)
+            {
+                return f.target == e.target && f.cost == e.cost;
+            });
+
+            if (!exists || e.target != route.vertices[i + 1])
+            {
+                return false;
+            }
+            cost += e.cost;
+        }
+
+        return cost == route.cost;
+    }
+
+    template<template<class, class, class...> class Queue>
+    auto test_path_extraction(graph_t& vs, std::size_t const n, unsigned long const seed)
+    {
+        auto rngSrc    = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, seed);
+        auto rngDst    = make_rng<std::size_t>(0ul, vs.vertices.size() - 1, seed + 1);
+        auto treeValid = true;
+        auto allValid  = true;
+
+        for (auto i = 0ul; i < n; ++i)
+        {
+            auto const from = rngSrc.next_int();
+            find_point_to_all<Queue>(vs, from);
+
+            auto const& parents = shortest_path_tree(vs);
+            for (auto const& v : vs.vertices)
+            {
+                auto const p = parents[v.id];
+                if (no_parent() == p)
+                {
+                    treeValid = treeValid && (v.id == from || dijkstra_max_dist() == v.distAprox);
+                    continue;
+                }
+
+                auto const& forward = vs.vertices[p].forward;
+                treeValid = treeValid && std::any_of(std::begin(forward), std::end(forward), [&](auto const& e)
+                {
+                    return e.target == v.id && vs.vertices[p].distAprox + e.cost == v.distAprox;
+                });
+            }
+
+            auto const to = rngDst.next_int();
+            for (auto j = 0ul; j < n; ++j)
+            {
+                auto const t     = (to + j) % vs.vertices.size();
+                auto const route = extract_path(vs, t);
+                allValid = allValid && route.cost == vs.vertices[t].distAprox
+                                    && is_valid_route(vs, route, from, t);
+            }
+
+            auto const cost  = find_point_to_point<Queue>(vs, from, to).cost;
+            auto const route = extract_path(vs, to);
+            allValid = allValid && route.cost == cost && is_valid_route(vs, route, from, to);
+        }
+
+        auto hopCount       = 0ul;
+        auto const walkTime = utils::run_time([&]()
+        {
+            find_point_to_all<Queue>(vs, rngSrc.next_int());
+            for (auto const& v : vs.vertices)
+            {
+                hopCount += extract_path(vs, v.id).edges.size();
+            }
+        });
+
+        std::cout << "Search and " << vs.vertices.size() << " paths with " << hopCount
+                  << " edges in " << walkTime << " ms" << '\n';
+        ASSERT(treeValid, "Test shortest path tree");
+        ASSERT(allValid, "Test path extraction");
+    }
+
+    inline auto edge_count(graph_t const& g)
+    {
+        auto count = 0ul;
+        for (auto const& v : g.vertices)
+        {
+            count += v.forward.size();
+        }
+        return count;
+    }
+
+    inline auto is_symmetric(graph_t const& g)
+    {
+        auto const reversed = reverse_graph(g);
+        auto const sorted   = [](edges_t es)
+        {
+            std::sort(std::begin(es), std::end(es), [](auto const& l, auto const& r)
+            {
+                return std::make_pair(l.target, l.cost) < std::make_pair(r.target, r.cost);
+            });
+            return es;
+        };
+
+        for (auto v = 0ul; v < g.vertices.size(); ++v)
+        {
+            auto const out = sorted(g.vertices[v].forward);
+            auto const in  = sorted(reversed.vertices[v].forward);
+            auto const equal = out.size() == in.size() && std::equal( std::begin(out), std::end(out), std::begin(in)
+                                                                    , [](auto const& l, auto const& r)
+            {
+                return l.target == r.target && l.cost == r.cost;
+            });
+
+            if (!equal)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline auto test_graph_generator(unsigned long const seed)
+    {
+        auto const grid     = make_grid_graph(100, 200, 1'000, seed);
+        auto const gridCopy = make_grid_graph(100, 200, 1'000, seed);
+        auto const points   = make_random_points(20'000, seed);
+        auto const geo      = make_geometric_graph(points, 6.0);
+        auto const power    = make_power_law_graph(20'000, 3, 1'000, seed);
+
+        auto sameGrid = edge_count(grid) == edge_count(gridCopy);
+        for (auto v = 0ul; v < grid.vertices.size() && sameGrid; ++v)
+        {
+            auto const& lhs = grid.vertices[v].forward;
+            auto const& rhs = gridCopy.vertices[v].forward;
+            sameGrid = std::equal( std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs)
+                                 , [](auto const& l, auto const& r)
+            {
+                return l.target == r.target && l.cost == r.cost;
+            });
+        }
+
+        auto const geoDegree = static_cast<double>(edge_count(geo)) / geo.vertices.size();
+
+        ASSERT(sameGrid, "Test grid graph seed");
+        ASSERT(edge_count(grid) == 2 * (2 * 100 * 200 - 100 - 200), "Test grid graph edges");
+        ASSERT(is_symmetric(grid) && is_symmetric(geo) && is_symmetric(power), "Test generated graphs symmetric");
+        ASSERT(geoDegree > 5.0 && geoDegree < 7.0, "Test geometric graph degree");
+        ASSERT(edge_count(power) == 2 * (3 * (20'000 - 4) + 6), "Test power-law graph edges");
+    }
+}
+
+#endif
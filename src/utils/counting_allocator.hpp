@@ -0,0 +1,201 @@
+#ifndef MIX_UTILS_COUNTING_ALLOCATOR_HPP
+#define MIX_UTILS_COUNTING_ALLOCATOR_HPP
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+namespace mix::utils
+{
+    /**
+        Live bytes, peak of live bytes and number of allocations
+        and deallocations made through counting_allocators that share it.
+        Counters are atomic so it can be shared by several threads.
+     */
+    class allocation_stats
+    {
+    public:
+        allocation_stats ();
+
+        auto on_allocate   (std::size_t const bytes) -> void;
+        auto on_deallocate (std::size_t const bytes) -> void;
+
+        auto live_bytes    () const -> std::size_t;
+        auto peak_bytes    () const -> std::size_t;
+        auto allocations   () const -> std::size_t;
+        auto deallocations () const -> std::size_t;
+
+        /**
+            Sets peak to current live bytes and clears allocation counts.
+            Live bytes are kept since the memory is still allocated.
+         */
+        auto reset () -> void;
+
+        /**
+            Stats used by default constructed counting_allocators.
+         */
+        static auto global () -> allocation_stats&;
+
+    private:
+        std::atomic<std::size_t> liveBytes_;
+        std::atomic<std::size_t> peakBytes_;
+        std::atomic<std::size_t> allocations_;
+        std::atomic<std::size_t> deallocations_;
+    };
+
+    /**
+        Allocator that allocates using std::allocator and records every
+        allocation into allocation_stats. Copies and rebound copies share
+        the stats so all nodes of a container are counted together.
+     */
+    template<class T>
+    class counting_allocator
+    {
+    public:
+        using value_type = T;
+
+    public:
+        counting_allocator () noexcept;
+        explicit counting_allocator (allocation_stats& stats) noexcept;
+
+        template<class U>
+        counting_allocator (counting_allocator<U> const& other) noexcept;
+
+        auto allocate   (std::size_t const n)             -> T*;
+        auto deallocate (T* const p, std::size_t const n) -> void;
+        auto stats      () const                          -> allocation_stats&;
+
+    private:
+        allocation_stats* stats_;
+    };
+
+    template<class T, class U>
+    auto operator== (counting_allocator<T> const& lhs, counting_allocator<U> const& rhs) -> bool
+    {
+        return &lhs.stats() == &rhs.stats();
+    }
+
+    template<class T, class U>
+    auto operator!= (counting_allocator<T> const& lhs, counting_allocator<U> const& rhs) -> bool
+    {
+        return ! (lhs == rhs);
+    }
+
+// allocation_stats definition:
+
+    inline allocation_stats::allocation_stats
+        () :
+        liveBytes_     (0),
+        peakBytes_     (0),
+        allocations_   (0),
+        deallocations_ (0)
+    {
+    }
+
+    inline auto allocation_stats::on_allocate
+        (std::size_t const bytes) -> void
+    {
+        auto const live = liveBytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        auto peak       = peakBytes_.load(std::memory_order_relaxed);
+        while (peak < live && !peakBytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline auto allocation_stats::on_deallocate
+        (std::size_t const bytes) -> void
+    {
+        liveBytes_.fetch_sub(bytes, std::memory_order_relaxed);
+        deallocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline auto allocation_stats::live_bytes
+        () const -> std::size_t
+    {
+        return liveBytes_.load(std::memory_order_relaxed);
+    }
+
+    inline auto allocation_stats::peak_bytes
+        () const -> std::size_t
+    {
+        return peakBytes_.load(std::memory_order_relaxed);
+    }
+
+    inline auto allocation_stats::allocations
+        () const -> std::size_t
+    {
+        return allocations_.load(std::memory_order_relaxed);
+    }
+
+    inline auto allocation_stats::deallocations
+        () const -> std::size_t
+    {
+        return deallocations_.load(std::memory_order_relaxed);
+    }
+
+    inline auto allocation_stats::reset
+        () -> void
+    {
+        peakBytes_.store(liveBytes_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        allocations_.store(0, std::memory_order_relaxed);
+        deallocations_.store(0, std::memory_order_relaxed);
+    }
+
+    inline auto allocation_stats::global
+        () -> allocation_stats&
+    {
+        static auto stats = allocation_stats();
+        return stats;
+    }
+
+// counting_allocator definition:
+
+    template<class T>
+    counting_allocator<T>::counting_allocator
+        () noexcept :
+        stats_ (&allocation_stats::global())
+    {
+    }
+
+    template<class T>
+    counting_allocator<T>::counting_allocator
+        (allocation_stats& stats) noexcept :
+        stats_ (&stats)
+    {
+    }
+
+    template<class T>
+    template<class U>
+    counting_allocator<T>::counting_allocator
+        (counting_allocator<U> const& other) noexcept :
+        stats_ (&other.stats())
+    {
+    }
+
+    template<class T>
+    auto counting_allocator<T>::allocate
+        (std::size_t const n) -> T*
+    {
+        auto const p = std::allocator<T>().allocate(n);
+        stats_->on_allocate(n * sizeof(T));
+        return p;
+    }
+
+    template<class T>
+    auto counting_allocator<T>::deallocate
+        (T* const p, std::size_t const n) -> void
+    {
+        stats_->on_deallocate(n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<class T>
+    auto counting_allocator<T>::stats
+        () const -> allocation_stats&
+    {
+        return *stats_;
+    }
+}
+
+#endif
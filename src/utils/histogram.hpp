@@ -0,0 +1,199 @@
+#ifndef MIX_UTILS_HISTOGRAM_HPP
+#define MIX_UTILS_HISTOGRAM_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+
+namespace mix::utils
+{
+    /**
+        Histogram of non-negative integer values (e.g. latencies in ticks)
+        in the style of HdrHistogram. Every power of two range is split into
+        2^SubBucketBits equally wide buckets so the relative error of
+        a reported value is at most 2^-SubBucketBits while the whole 64 bit
+        range takes only a few thousand counters. Recording is O(1).
+     */
+    class histogram
+    {
+    public:
+        using value_type = std::uint64_t;
+        using count_type = std::uint64_t;
+
+        /**
+            32 buckets per power of two, error at most ~3%.
+         */
+        static constexpr auto SubBucketBits = 5u;
+
+    public:
+        histogram ();
+
+        auto record     (value_type const value)        -> void;
+        auto merge      (histogram const& other)        -> void;
+        auto reset      ()                              -> void;
+        auto count      () const                        -> count_type;
+        auto min        () const                        -> value_type;
+        auto max        () const                        -> value_type;
+        auto mean       () const                        -> double;
+        auto percentile (double const p) const          -> value_type;
+
+    private:
+        static constexpr auto SubBucketCount = value_type {1} << SubBucketBits;
+
+        static auto bucket_index (value_type const value) -> std::size_t;
+        static auto bucket_value (std::size_t const index) -> value_type;
+        static auto highest_bit  (value_type const value) -> unsigned;
+
+    private:
+        std::vector<count_type> counts_;
+        count_type              total_;
+        value_type              min_;
+        value_type              max_;
+        double                  sum_;
+    };
+
+    inline histogram::histogram
+        () :
+        counts_ (bucket_index(std::numeric_limits<value_type>::max()) + 1, 0),
+        total_  (0),
+        min_    (std::numeric_limits<value_type>::max()),
+        max_    (0),
+        sum_    (0)
+    {
+    }
+
+    inline auto histogram::record
+        (value_type const value) -> void
+    {
+        ++counts_[bucket_index(value)];
+        ++total_;
+        min_  = std::min(min_, value);
+        max_  = std::max(max_, value);
+        sum_ += static_cast<double>(value);
+    }
+
+    inline auto histogram::merge
+        (histogram const& other) -> void
+    {
+        for (auto i = 0ul; i < counts_.size(); ++i)
+        {
+            counts_[i] += other.counts_[i];
+        }
+
+        total_ += other.total_;
+        min_    = std::min(min_, other.min_);
+        max_    = std::max(max_, other.max_);
+        sum_   += other.sum_;
+    }
+
+    inline auto histogram::reset
+        () -> void
+    {
+        std::fill(std::begin(counts_), std::end(counts_), 0);
+        total_ = 0;
+        min_   = std::numeric_limits<value_type>::max();
+        max_   = 0;
+        sum_   = 0;
+    }
+
+    inline auto histogram::count
+        () const -> count_type
+    {
+        return total_;
+    }
+
+    inline auto histogram::min
+        () const -> value_type
+    {
+        return 0 == total_ ? 0 : min_;
+    }
+
+    inline auto histogram::max
+        () const -> value_type
+    {
+        return max_;
+    }
+
+    inline auto histogram::mean
+        () const -> double
+    {
+        return 0 == total_ ? 0.0 : sum_ / static_cast<double>(total_);
+    }
+
+    /**
+        @param p percentile from [0, 100].
+        @return upper bound of the bucket that contains the value at given
+                percentile, never more than max.
+     */
+    inline auto histogram::percentile
+        (double const p) const -> value_type
+    {
+        if (0 == total_)
+        {
+            return 0;
+        }
+
+        auto const clamped = std::clamp(p, 0.0, 100.0);
+        auto const rank    = std::max<count_type>(1, static_cast<count_type>(clamped / 100.0 * static_cast<double>(total_) + 0.5));
+        auto seen          = count_type {0};
+
+        for (auto i = 0ul; i < counts_.size(); ++i)
+        {
+            seen += counts_[i];
+            if (seen >= rank)
+            {
+                return std::min(bucket_value(i), max_);
+            }
+        }
+
+        return max_;
+    }
+
+    inline auto histogram::bucket_index
+        (value_type const value) -> std::size_t
+    {
+        // Values below 2 * SubBucketCount have buckets of width 1.
+        if (value < 2 * SubBucketCount)
+        {
+            return static_cast<std::size_t>(value);
+        }
+
+        auto const shift    = highest_bit(value) - SubBucketBits;
+        auto const mantissa = value >> shift;
+        return static_cast<std::size_t>((shift + 1) * SubBucketCount + (mantissa - SubBucketCount));
+    }
+
+    inline auto histogram::bucket_value
+        (std::size_t const index) -> value_type
+    {
+        if (index < 2 * SubBucketCount)
+        {
+            return static_cast<value_type>(index);
+        }
+
+        auto const shift    = static_cast<unsigned>(index / SubBucketCount - 1);
+        auto const mantissa = SubBucketCount + index % SubBucketCount;
+        auto const width    = value_type {1} << shift;
+        return (mantissa << shift) + (width - 1);
+    }
+
+    inline auto histogram::highest_bit
+        (value_type const value) -> unsigned
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        auto bit = 0u;
+        auto v   = value;
+        while (v >>= 1)
+        {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef MIX_UTILS_PARALLEL_HPP
+#define MIX_UTILS_PARALLEL_HPP
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace mix::utils
+{
+    /**
+        Reusable barrier for a fixed number of threads.
+        Waiting threads spin and yield so it stays usable
+        when there are more threads than cores.
+     */
+    class spin_barrier
+    {
+    public:
+        explicit spin_barrier (std::size_t const count);
+
+        auto wait () -> void;
+
+    private:
+        std::size_t const        count_;
+        std::atomic<std::size_t> waiting_;
+        std::atomic<std::size_t> generation_;
+    };
+
+    inline spin_barrier::spin_barrier
+        (std::size_t const count) :
+        count_      (count),
+        waiting_    (0),
+        generation_ (0)
+    {
+    }
+
+    inline auto spin_barrier::wait
+        () -> void
+    {
+        auto const generation = generation_.load(std::memory_order_acquire);
+
+        if (waiting_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_)
+        {
+            waiting_.store(0, std::memory_order_relaxed);
+            generation_.fetch_add(1, std::memory_order_release);
+        }
+        else
+        {
+            while (generation == generation_.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+        @return number of hardware threads, at least 1.
+     */
+    inline auto default_thread_count
+        () -> std::size_t
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /**
+        Runs function(threadIndex) on @p threadCount threads.
+        The calling thread runs index 0. Returns after all of them finish.
+        @throws std::invalid_argument if @p threadCount is 0.
+     */
+    template<class Func>
+    auto run_on_threads (std::size_t const threadCount, Func&& function) -> void
+    {
+        if (threadCount < 1)
+        {
+            throw std::invalid_argument("Thread count must be positive.");
+        }
+
+        auto threads = std::vector<std::thread>();
+        threads.reserve(threadCount - 1);
+
+        for (auto t = 1ul; t < threadCount; ++t)
+        {
+            threads.emplace_back([&function, t]() { function(t); });
+        }
+
+        function(0ul);
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
+
+#endif
@@ -2,6 +2,26 @@
 #define MIX_UTILS_STOPWATCH_HPP
 
 #include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <optional>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #define MIX_UTILS_HAS_PERF_EVENT
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define MIX_UTILS_HAS_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define MIX_UTILS_HAS_TSC
+#endif
 
 namespace mix::utils
 {
@@ -31,6 +51,333 @@ namespace mix::utils
         return std::chrono::duration_cast<milliseconds>(clock::now() - timeZero_);
     }
 
+    /**
+        Cheap timer for measuring single operations. Reads the time stamp
+        counter on x86 (tens of cycles, no system call) and falls back
+        to steady_clock nanoseconds elsewhere. Ticks are converted
+        to nanoseconds using a ratio that is measured once.
+     */
+    class cycle_timer
+    {
+    public:
+        using ticks_t = std::uint64_t;
+
+    public:
+        static auto now          () -> ticks_t;
+        static auto ticks_per_ns () -> double;
+        static auto to_ns        (ticks_t const ticks) -> double;
+
+    private:
+        static auto calibrate () -> double;
+    };
+
+    inline auto cycle_timer::now
+        () -> ticks_t
+    {
+#ifdef MIX_UTILS_HAS_TSC
+        return static_cast<ticks_t>(__rdtsc());
+#else
+        return static_cast<ticks_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    inline auto cycle_timer::ticks_per_ns
+        () -> double
+    {
+        static auto const ratio = calibrate();
+        return ratio;
+    }
+
+    inline auto cycle_timer::to_ns
+        (ticks_t const ticks) -> double
+    {
+        return static_cast<double>(ticks) / ticks_per_ns();
+    }
+
+    inline auto cycle_timer::calibrate
+        () -> double
+    {
+#ifdef MIX_UTILS_HAS_TSC
+        // Spin for a while and compare both clocks.
+        using clock = std::chrono::steady_clock;
+        auto const clockStart = clock::now();
+        auto const tickStart  = now();
+        auto clockEnd         = clockStart;
+        while (clockEnd - clockStart < std::chrono::milliseconds(20))
+        {
+            clockEnd = clock::now();
+        }
+        auto const ticks = static_cast<double>(now() - tickStart);
+        auto const ns    = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clockEnd - clockStart).count());
+        return ticks / ns;
+#else
+        return 1.0;
+#endif
+    }
+
+    /**
+        Hardware and software events counted by perf_counters.
+     */
+    enum class perf_event
+    {
+        cycles, instructions, l1d_misses, llc_misses, branch_misses, page_faults, Count
+    };
+
+    inline constexpr auto PerfEventCount = static_cast<std::size_t>(perf_event::Count);
+
+    inline auto perf_event_name (perf_event const event) -> char const*
+    {
+        switch (event)
+        {
+            case perf_event::cycles:        return "cycles";
+            case perf_event::instructions:  return "instructions";
+            case perf_event::l1d_misses:    return "l1d_misses";
+            case perf_event::llc_misses:    return "llc_misses";
+            case perf_event::branch_misses: return "branch_misses";
+            case perf_event::page_faults:   return "page_faults";
+            default:                        return "unknown";
+        }
+    }
+
+    /**
+        Values of the events between perf_counters::start and stop. An event
+        is empty if it could not be counted. Values are scaled when the kernel
+        had to multiplex the counters.
+     */
+    using perf_sample = std::array<std::optional<std::uint64_t>, PerfEventCount>;
+
+    /**
+        Group of Linux perf_event_open counters of the calling thread,
+        user space only. Events that can not be opened (no PMU in a VM,
+        perf_event_paranoid, other systems than Linux) are skipped
+        and if none can be opened available returns false.
+        Counters are opened once and can be started repeatedly.
+     */
+    class perf_counters
+    {
+    public:
+        perf_counters  ();
+        ~perf_counters ();
+
+        perf_counters (perf_counters const&) = delete;
+        auto operator= (perf_counters const&) -> perf_counters& = delete;
+
+        auto available () const                    -> bool;
+        auto counts    (perf_event const e) const  -> bool;
+        auto start     ()                          -> void;
+        auto stop      ()                          -> perf_sample;
+
+    private:
+        std::array<int, PerfEventCount> fds_;
+        int                             leader_;
+    };
+
+    /**
+        Counts events for the lifetime of the object and writes them into
+        given sample when it is destroyed.
+     */
+    class scoped_perf_counters
+    {
+    public:
+        scoped_perf_counters (perf_counters& counters, perf_sample& out) :
+            counters_ (counters),
+            out_      (out)
+        {
+            counters_.start();
+        }
+
+        ~scoped_perf_counters ()
+        {
+            out_ = counters_.stop();
+        }
+
+        scoped_perf_counters (scoped_perf_counters const&) = delete;
+        auto operator= (scoped_perf_counters const&) -> scoped_perf_counters& = delete;
+
+    private:
+        perf_counters& counters_;
+        perf_sample&   out_;
+    };
+
+#ifdef MIX_UTILS_HAS_PERF_EVENT
+    namespace perf_impl
+    {
+        inline auto event_attr (perf_event const event) -> perf_event_attr
+        {
+            auto attr = perf_event_attr {};
+            attr.size           = sizeof(perf_event_attr);
+            attr.disabled       = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format    = PERF_FORMAT_GROUP
+                                | PERF_FORMAT_TOTAL_TIME_ENABLED
+                                | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            auto const cache = [](auto const id, auto const result)
+            {
+                return static_cast<std::uint64_t>(id)
+                     | (static_cast<std::uint64_t>(PERF_COUNT_HW_CACHE_OP_READ) << 8)
+                     | (static_cast<std::uint64_t>(result) << 16);
+            };
+
+            switch (event)
+            {
+                case perf_event::cycles:
+                    attr.type   = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                    break;
+                case perf_event::instructions:
+                    attr.type   = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                    break;
+                case perf_event::l1d_misses:
+                    attr.type   = PERF_TYPE_HW_CACHE;
+                    attr.config = cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS);
+                    break;
+                case perf_event::llc_misses:
+                    attr.type   = PERF_TYPE_HW_CACHE;
+                    attr.config = cache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_RESULT_MISS);
+                    break;
+                case perf_event::branch_misses:
+                    attr.type   = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                    break;
+                default:
+                    attr.type   = PERF_TYPE_SOFTWARE;
+                    attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+                    break;
+            }
+
+            return attr;
+        }
+
+        inline auto open_event (perf_event_attr& attr, int const groupFd) -> int
+        {
+            return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+        }
+    }
+
+    inline perf_counters::perf_counters
+        () :
+        fds_    (),
+        leader_ (-1)
+    {
+        // First event that opens leads the group, the rest joins it.
+        for (auto i = 0ul; i < PerfEventCount; ++i)
+        {
+            auto attr = perf_impl::event_attr(static_cast<perf_event>(i));
+            fds_[i]   = perf_impl::open_event(attr, leader_);
+            if (-1 == leader_ && -1 != fds_[i])
+            {
+                leader_ = fds_[i];
+            }
+        }
+    }
+
+    inline perf_counters::~perf_counters
+        ()
+    {
+        for (auto const fd : fds_)
+        {
+            if (-1 != fd)
+            {
+                ::close(fd);
+            }
+        }
+    }
+
+    inline auto perf_counters::available
+        () const -> bool
+    {
+        return -1 != leader_;
+    }
+
+    inline auto perf_counters::counts
+        (perf_event const e) const -> bool
+    {
+        return -1 != fds_[static_cast<std::size_t>(e)];
+    }
+
+    inline auto perf_counters::start
+        () -> void
+    {
+        if (this->available())
+        {
+            ::ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ::ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    inline auto perf_counters::stop
+        () -> perf_sample
+    {
+        auto sample = perf_sample {};
+        if (!this->available())
+        {
+            return sample;
+        }
+
+        ::ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // Layout of PERF_FORMAT_GROUP: nr, time_enabled, time_running, values[nr].
+        auto buffer = std::array<std::uint64_t, 3 + PerfEventCount> {};
+        auto const bytes = ::read(leader_, buffer.data(), sizeof(buffer));
+        if (bytes < static_cast<ssize_t>(3 * sizeof(std::uint64_t)) || 0 == buffer[2])
+        {
+            return sample;
+        }
+
+        auto const scale = static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]);
+        auto value       = 3ul;
+        for (auto i = 0ul; i < PerfEventCount && value < 3 + buffer[0]; ++i)
+        {
+            if (-1 != fds_[i])
+            {
+                sample[i] = static_cast<std::uint64_t>(static_cast<double>(buffer[value]) * scale);
+                ++value;
+            }
+        }
+
+        return sample;
+    }
+#else
+    inline perf_counters::perf_counters
+        () :
+        fds_    (),
+        leader_ (-1)
+    {
+    }
+
+    inline perf_counters::~perf_counters
+        ()
+    {
+    }
+
+    inline auto perf_counters::available
+        () const -> bool
+    {
+        return false;
+    }
+
+    inline auto perf_counters::counts
+        (perf_event const) const -> bool
+    {
+        return false;
+    }
+
+    inline auto perf_counters::start
+        () -> void
+    {
+    }
+
+    inline auto perf_counters::stop
+        () -> perf_sample
+    {
+        return perf_sample {};
+    }
+#endif
+
     template<class Func>
     auto run_time (Func&& function) -> double
     {